@@ -47,6 +47,16 @@ void GA_set_alloc_funcs(GAAllocFunc allocFunc, GAFreeFunc freeFunc)
     GA_FREE_FUNC = freeFunc;
 }
 
+GAAllocFunc GA_get_alloc_func()
+{
+    return GA_ALLOC_FUNC;
+}
+
+GAFreeFunc GA_get_free_func()
+{
+    return GA_FREE_FUNC;
+}
+
 char* GA_alloc(size_t numElem, int eltSize)
 {
     return GA_ALLOC_FUNC(numElem, eltSize);
@@ -56,3 +66,152 @@ void GA_free(char* memLoc)
 {
     return GA_FREE_FUNC(memLoc);
 }
+
+/** Alignment of arena allocations, in bytes.
+ */
+#define GA_ARENA_ALIGNMENT 16
+
+/** Size of the header of an arena block, rounded up to the alignment.
+ */
+#define GA_ARENA_HEADER_SIZE \
+    ((sizeof(GAArenaBlock) + GA_ARENA_ALIGNMENT - 1) \
+        / GA_ARENA_ALIGNMENT * GA_ARENA_ALIGNMENT)
+
+/** Active arena.
+ */
+GAArena* GA_ARENA = 0;
+
+GAArena* GA_arena_create(size_t blockSize)
+{
+    GAArena* arena = (GAArena*)malloc(sizeof(GAArena));
+    if (arena == 0)
+        return 0;
+    arena->first = 0;
+    arena->current = 0;
+    arena->blockSize = blockSize;
+    arena->prevAllocFunc = 0;
+    arena->prevFreeFunc = 0;
+    arena->prevArena = 0;
+    return arena;
+}
+
+void GA_arena_destroy(GAArena* arena)
+{
+    GAArenaBlock* block = arena->first;
+    while (block != 0)
+    {
+        GAArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    free(arena);
+}
+
+GAArenaMark GA_arena_mark(GAArena* arena)
+{
+    GAArenaMark mark;
+    mark.block = arena->current;
+    mark.used = (arena->current != 0) ? arena->current->used : 0;
+    return mark;
+}
+
+void GA_arena_reset(GAArena* arena, GAArenaMark mark)
+{
+    GAArenaBlock* block = (mark.block != 0) ? mark.block : arena->first;
+    if (block == 0)
+        return;
+    block->used = (mark.block != 0) ? mark.used : 0;
+    arena->current = block;
+    for (block = block->next; block != 0; block = block->next)
+        block->used = 0;
+}
+
+/** Allocate memory from the active arena.
+ *
+ * The memory is taken from the current block, or from the next block 
+ * which is large enough. If there is none, a new block is inserted after 
+ * the current one. The memory is not initialized.
+ *
+ * \param numElem Number of elements to allocate.
+ * \param eltSize Element size.
+ *
+ * \return Pointer to the memory, or 0 if an error occurs.
+ */
+static char* GA_arena_alloc(size_t numElem, int eltSize)
+{
+    GAArena* arena = GA_ARENA;
+    size_t size = (numElem * eltSize + GA_ARENA_ALIGNMENT - 1) 
+        / GA_ARENA_ALIGNMENT * GA_ARENA_ALIGNMENT;
+    GAArenaBlock* block = arena->current;
+    if (block != 0)
+    {
+        /* Blocks after the current one are empty, but they may be too 
+           small for the allocation. */
+        while ((block != 0)
+            && (block->used + size > block->size))
+            block = block->next;
+    }
+    if (block == 0)
+    {
+        size_t blockSize = (size > arena->blockSize) ? size 
+            : arena->blockSize;
+        block = (GAArenaBlock*)malloc(GA_ARENA_HEADER_SIZE + blockSize);
+        if (block == 0)
+            return 0;
+        block->size = blockSize;
+        block->used = 0;
+        if (arena->current != 0)
+        {
+            block->next = arena->current->next;
+            arena->current->next = block;
+        } else
+        {
+            block->next = arena->first;
+            arena->first = block;
+        }
+    }
+    arena->current = block;
+    char* result = (char*)block + GA_ARENA_HEADER_SIZE + block->used;
+    block->used += size;
+    return result;
+}
+
+/** Free memory allocated from an arena.
+ *
+ * Memory allocated from an arena is only released by GA_arena_reset().
+ *
+ * \param memLoc Memory location.
+ */
+static void GA_arena_free(char* memLoc)
+{
+}
+
+void GA_arena_activate(GAArena* arena)
+{
+    arena->prevAllocFunc = GA_ALLOC_FUNC;
+    arena->prevFreeFunc = GA_FREE_FUNC;
+    arena->prevArena = GA_ARENA;
+    GA_ARENA = arena;
+    GA_set_alloc_funcs(GA_arena_alloc, GA_arena_free);
+}
+
+void GA_arena_deactivate(GAArena* arena)
+{
+    GA_set_alloc_funcs(arena->prevAllocFunc, arena->prevFreeFunc);
+    GA_ARENA = arena->prevArena;
+    arena->prevArena = 0;
+}
+
+GAArena* GA_arena_get_active()
+{
+    return GA_ARENA;
+}
+
+size_t GA_arena_get_size(GAArena* arena)
+{
+    size_t size = 0;
+    GAArenaBlock* block;
+    for (block = arena->first; block != 0; block = block->next)
+        size += block->size;
+    return size;
+}
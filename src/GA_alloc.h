@@ -64,6 +64,22 @@ typedef void (*GAFreeFunc)(char*);
  */
 void GA_set_alloc_funcs(GAAllocFunc allocFunc, GAFreeFunc freeFunc);
 
+/** Get allocation function.
+ *
+ * Get the memory allocation function which is currently used.
+ *
+ * \return Allocation function.
+ */
+GAAllocFunc GA_get_alloc_func();
+
+/** Get freeing function.
+ *
+ * Get the memory freeing function which is currently used.
+ *
+ * \return Freeing function.
+ */
+GAFreeFunc GA_get_free_func();
+
 /** Allocate memory.
  *
  * Allocate memory using the currently set allocation function.
@@ -83,6 +99,164 @@ char* GA_alloc(size_t numElem, int eltSize);
  */
 void GA_free(char* memLoc);
 
+/** Minimum block size of an arena, in bytes.
+ *
+ * Smaller blocks would hold too few allocations to be worthwhile.
+ */
+#define GA_ARENA_MIN_BLOCK_SIZE 65536
+
+/** Arena block (implementation).
+ *
+ * A block of memory from which the allocations of an arena are served.
+ */
+struct GAArenaBlock_Impl
+{
+    /** Next block, or 0.
+     */
+    struct GAArenaBlock_Impl* next;
+    /** Size of the block, in bytes.
+     */
+    size_t size;
+    /** Number of bytes in use.
+     */
+    size_t used;
+};
+
+/** Arena block.
+ */
+typedef struct GAArenaBlock_Impl GAArenaBlock;
+
+/** Memory arena (implementation).
+ *
+ * An arena serves allocations from a list of large blocks by advancing a 
+ * pointer, so allocating is cheap and freeing single allocations does 
+ * nothing. Instead, all allocations made after a mark are released at 
+ * once by resetting the arena to the mark (see GA_arena_mark() and 
+ * GA_arena_reset()). The blocks are kept for the following allocations, 
+ * so an arena which is reset after each step of an iteration reaches the 
+ * size of the largest step and then stays at that size. The blocks are 
+ * allocated with <tt>malloc()</tt> and returned to the system when the 
+ * arena is destroyed. An arena is used through the allocation functions 
+ * while it is active (see GA_arena_activate()). Arenas are not safe to 
+ * use from several threads.
+ */
+struct GAArena_Impl
+{
+    /** First block.
+     */
+    GAArenaBlock* first;
+    /** Block from which memory is currently allocated.
+     */
+    GAArenaBlock* current;
+    /** Minimum size of a new block, in bytes.
+     */
+    size_t blockSize;
+    /** Allocation function before the arena was activated.
+     */
+    GAAllocFunc prevAllocFunc;
+    /** Freeing function before the arena was activated.
+     */
+    GAFreeFunc prevFreeFunc;
+    /** Arena which was active before this one, or 0.
+     */
+    struct GAArena_Impl* prevArena;
+};
+
+/** Memory arena.
+ */
+typedef struct GAArena_Impl GAArena;
+
+/** Arena mark.
+ *
+ * Position in an arena to which the arena can be reset.
+ */
+typedef struct
+{
+    /** Current block, or 0 for the beginning of the arena.
+     */
+    GAArenaBlock* block;
+    /** Number of bytes in use in the current block.
+     */
+    size_t used;
+} GAArenaMark;
+
+/** Create arena.
+ *
+ * Create a memory arena. The first block is allocated with the first 
+ * allocation from the arena. The arena should be destroyed by using 
+ * GA_arena_destroy() when it is not needed anymore.
+ *
+ * \param blockSize Minimum size of the blocks, in bytes.
+ *
+ * \return Pointer to an arena, or 0 if an error occurs.
+ */
+GAArena* GA_arena_create(size_t blockSize);
+
+/** Destroy arena.
+ *
+ * Release all blocks of an arena. This invalidates all memory allocated 
+ * from the arena. The arena must not be active.
+ *
+ * \param arena Arena.
+ */
+void GA_arena_destroy(GAArena* arena);
+
+/** Mark arena.
+ *
+ * Get the current position of an arena, to which it can be reset by 
+ * GA_arena_reset().
+ *
+ * \param arena Arena.
+ *
+ * \return Mark.
+ */
+GAArenaMark GA_arena_mark(GAArena* arena);
+
+/** Reset arena.
+ *
+ * Release all memory which has been allocated from an arena since the 
+ * mark was taken. The blocks are kept for later allocations.
+ *
+ * \param arena Arena.
+ * \param mark Mark.
+ */
+void GA_arena_reset(GAArena* arena, GAArenaMark mark);
+
+/** Activate arena.
+ *
+ * Set the allocation functions so that GA_alloc() allocates from the 
+ * arena and GA_free() does nothing, until GA_arena_deactivate() is 
+ * called. Arenas can be activated within each other.
+ *
+ * \param arena Arena.
+ */
+void GA_arena_activate(GAArena* arena);
+
+/** Deactivate arena.
+ *
+ * Restore the allocation functions which were set before the arena was 
+ * activated (see GA_arena_activate()).
+ *
+ * \param arena Arena.
+ */
+void GA_arena_deactivate(GAArena* arena);
+
+/** Get active arena.
+ *
+ * \return The arena which is currently active, or 0 if there is none.
+ */
+GAArena* GA_arena_get_active();
+
+/** Get arena size.
+ *
+ * Get the total size of the blocks of an arena.
+ *
+ * \param arena Arena.
+ *
+ * \return Size of the arena, in bytes.
+ */
+size_t GA_arena_get_size(GAArena* arena);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,216 @@
+/* ----------------------------------------------------------------------------
+ * R package for graph alignment
+ * ----------------------------------------------------------------------------
+ *
+ * Author: Joern P. Meier <mail@ionflux.org>
+ * 
+ * The package can be used freely for non-commercial purposes. If you use this 
+ * package, the appropriate paper to cite is J. Berg and M. Laessig, 
+ * "Cross-species analysis of biological networks by Bayesian alignment", 
+ * PNAS 103 (29), 10967-10972 (2006)
+ * 
+ * This software is made available in the hope that it will be useful, but 
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY 
+ * or FITNESS FOR A PARTICULAR PURPOSE.
+ * 
+ * This software contains code for solving linear assignment problems which was 
+ * written by Roy Jonker, MagicLogic Optimization Inc.. Please note that this 
+ * code is copyrighted, (c) 2003 MagicLogic Systems Inc., Canada and may be 
+ * used for non-commercial purposes only. See 
+ * http://www.magiclogic.com/assignment.html for the latest version of the LAP 
+ * code and details on licensing.
+ *
+ * ----------------------------------------------------------------------------
+ * Auction algorithm for linear assignment problems.
+ * ----------------------------------------------------------------------------
+ */
+
+/** \file GA_auction.c
+ * \brief Auction algorithm for linear assignment problems (implementation).
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "GA_alloc.h"
+#include "GA_message.h"
+#include "GA_auction.h"
+
+GAVectorInt* GA_linear_assignment_solve_auction(GAMatrixReal* costMatrix, 
+    double tolerance, int numThreads)
+{
+    if (costMatrix->rows != costMatrix->cols)
+    {
+        GA_msg()("[GA_linear_assignment_solve_auction] "
+            "Cost matrix is not a square matrix", GA_MSG_ERROR);
+        return 0;
+    }
+    if (!(tolerance > 0.))
+    {
+        GA_msg()("[GA_linear_assignment_solve_auction] "
+            "Tolerance must be positive.", GA_MSG_ERROR);
+        return 0;
+    }
+    int n = costMatrix->rows;
+    double** c = costMatrix->elts;
+    int i;
+    int j;
+    int k;
+    double costMin = 0.;
+    double costMax = 0.;
+    for (i = 0; i < n; i++)
+        for (j = 0; j < n; j++)
+        {
+            if (!isfinite(c[i][j]))
+            {
+                GA_msg()("[GA_linear_assignment_solve_auction] "
+                    "Cost matrix contains elements which are not finite.", 
+                    GA_MSG_ERROR);
+                return 0;
+            }
+            if (((i == 0) && (j == 0))
+                || (c[i][j] < costMin))
+                costMin = c[i][j];
+            if (((i == 0) && (j == 0))
+                || (c[i][j] > costMax))
+                costMax = c[i][j];
+        }
+    GAVectorInt* result = GA_vector_create_int(n);
+    if (result == 0)
+        return 0;
+    int* owner = result->elts;
+    double range = costMax - costMin;
+    if (range == 0.)
+    {
+        /* All assignments have the same cost. */
+        for (j = 0; j < n; j++)
+            owner[j] = j;
+        return result;
+    }
+    int* freeRows = (int*)GA_alloc(n, sizeof(int));
+    int* nextFreeRows = (int*)GA_alloc(n, sizeof(int));
+    int* bidCol = (int*)GA_alloc(n, sizeof(int));
+    double* bid = (double*)GA_alloc(n, sizeof(double));
+    int* bestBidder = (int*)GA_alloc(n, sizeof(int));
+    double* bestBid = (double*)GA_alloc(n, sizeof(double));
+    double* price = (double*)GA_alloc(n, sizeof(double));
+    if ((freeRows == 0)
+        || (nextFreeRows == 0)
+        || (bidCol == 0)
+        || (bid == 0)
+        || (bestBidder == 0)
+        || (bestBid == 0)
+        || (price == 0))
+        return 0;
+    /* The cost of an epsilon-optimal assignment exceeds the optimal cost 
+       by at most n * epsilon. */
+    double epsFinal = tolerance / (n + 1);
+    if (epsFinal < GA_AUCTION_MIN_RELATIVE_EPSILON * range)
+        epsFinal = GA_AUCTION_MIN_RELATIVE_EPSILON * range;
+    double eps = range / GA_AUCTION_EPSILON_FACTOR;
+    if (eps < epsFinal)
+        eps = epsFinal;
+    for (j = 0; j < n; j++)
+    {
+        price[j] = 0.;
+        bestBidder[j] = -1;
+    }
+    while (1)
+    {
+        /* Each scaling phase starts from the prices of the previous phase 
+           with all rows unassigned. */
+        int numFree = n;
+        for (i = 0; i < n; i++)
+            freeRows[i] = i;
+        for (j = 0; j < n; j++)
+            owner[j] = -1;
+        while (numFree > 0)
+        {
+            /* Each unassigned row bids for the column with the lowest 
+               reduced cost, raising its price by the difference to the 
+               second lowest reduced cost plus epsilon. The bids only 
+               depend on the prices of the previous round. */
+#pragma omp parallel for num_threads(numThreads) \
+    if ((double)numFree * n >= GA_AUCTION_PARALLEL_MIN_WORK)
+            for (k = 0; k < numFree; k++)
+            {
+                double* row = c[freeRows[k]];
+                int t;
+                int jMin = 0;
+                double min = row[0] + price[0];
+                double subMin = HUGE_VAL;
+                for (t = 1; t < n; t++)
+                {
+                    double h = row[t] + price[t];
+                    if (h < subMin)
+                    {
+                        if (h < min)
+                        {
+                            subMin = min;
+                            min = h;
+                            jMin = t;
+                        } else
+                            subMin = h;
+                    }
+                }
+                bidCol[k] = jMin;
+                if (subMin == HUGE_VAL)
+                    bid[k] = price[jMin] + eps;
+                else
+                    bid[k] = price[jMin] + (subMin - min) + eps;
+            }
+            /* Each column which received bids goes to the highest bidder, 
+               or to the first one if there are several. */
+            for (k = 0; k < numFree; k++)
+            {
+                j = bidCol[k];
+                if ((bestBidder[j] < 0)
+                    || (bid[k] > bestBid[j]))
+                {
+                    bestBidder[j] = freeRows[k];
+                    bestBid[j] = bid[k];
+                }
+            }
+            int numNextFree = 0;
+            for (k = 0; k < numFree; k++)
+            {
+                i = freeRows[k];
+                j = bidCol[k];
+                if (bestBidder[j] == i)
+                {
+                    if (owner[j] >= 0)
+                    {
+                        nextFreeRows[numNextFree] = owner[j];
+                        numNextFree++;
+                    }
+                    owner[j] = i;
+                    price[j] = bestBid[j];
+                } else
+                {
+                    nextFreeRows[numNextFree] = i;
+                    numNextFree++;
+                }
+            }
+            for (k = 0; k < numFree; k++)
+                bestBidder[bidCol[k]] = -1;
+            int* tmp = freeRows;
+            freeRows = nextFreeRows;
+            nextFreeRows = tmp;
+            numFree = numNextFree;
+        }
+        if (eps <= epsFinal)
+            break;
+        eps /= GA_AUCTION_EPSILON_FACTOR;
+        if (eps < epsFinal)
+            eps = epsFinal;
+    }
+    GA_free((char*)freeRows);
+    GA_free((char*)nextFreeRows);
+    GA_free((char*)bidCol);
+    GA_free((char*)bid);
+    GA_free((char*)bestBidder);
+    GA_free((char*)bestBid);
+    GA_free((char*)price);
+    return result;
+}
@@ -0,0 +1,116 @@
+#ifndef GA_AUCTION
+#define GA_AUCTION
+/* ----------------------------------------------------------------------------
+ * R package for graph alignment
+ * ----------------------------------------------------------------------------
+ *
+ * Author: Joern P. Meier <mail@ionflux.org>
+ * 
+ * The package can be used freely for non-commercial purposes. If you use this 
+ * package, the appropriate paper to cite is J. Berg and M. Laessig, 
+ * "Cross-species analysis of biological networks by Bayesian alignment", 
+ * PNAS 103 (29), 10967-10972 (2006)
+ * 
+ * This software is made available in the hope that it will be useful, but 
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY 
+ * or FITNESS FOR A PARTICULAR PURPOSE.
+ * 
+ * This software contains code for solving linear assignment problems which was 
+ * written by Roy Jonker, MagicLogic Optimization Inc.. Please note that this 
+ * code is copyrighted, (c) 2003 MagicLogic Systems Inc., Canada and may be 
+ * used for non-commercial purposes only. See 
+ * http://www.magiclogic.com/assignment.html for the latest version of the LAP 
+ * code and details on licensing.
+ *
+ * ----------------------------------------------------------------------------
+ * Auction algorithm for linear assignment problems.
+ * ----------------------------------------------------------------------------
+ */
+
+/** \file GA_auction.h
+ * \brief Auction algorithm for linear assignment problems.
+ *
+ * This module provides an alternative to the Jonker-Volgenant solver (see 
+ * lap.h) for dense linear assignment problems with real costs, based on 
+ * the auction algorithm with epsilon scaling by Bertsekas. The bids of 
+ * all unassigned rows in a round are computed in parallel (Jacobi 
+ * bidding). The solution is epsilon-optimal, i.e. its cost exceeds the 
+ * optimal cost by less than a tolerance set by the caller.
+ */
+
+#include "GA_vector.h"
+#include "GA_matrix.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** Factor by which epsilon is reduced in each scaling phase.
+ */
+#define GA_AUCTION_EPSILON_FACTOR 5.
+
+/** Smallest epsilon relative to the range of the costs, which keeps the 
+ * price increments above the rounding error of the prices.
+ */
+#define GA_AUCTION_MIN_RELATIVE_EPSILON 1e-12
+
+/** Default tolerance.
+ */
+#define GA_AUCTION_DEFAULT_TOLERANCE 1e-6
+
+/** Minimum number of cost matrix elements scanned in a bidding round for 
+ * the bids to be computed in parallel.
+ */
+#define GA_AUCTION_PARALLEL_MIN_WORK 16384
+
+/** Assignment engine (implementation).
+ *
+ * The assignment engine specifies which solver is used for dense linear 
+ * assignment problems.
+ */
+enum GAAssignmentEngine_Impl
+{
+    /** Assignment engine: Jonker-Volgenant shortest augmenting paths.
+     */
+    GA_ASSIGNMENT_JV = 0,
+    /** Assignment engine: auction algorithm with epsilon scaling.
+     */
+    GA_ASSIGNMENT_AUCTION = 1
+};
+
+/** Assignment engine.
+ */
+typedef enum GAAssignmentEngine_Impl GAAssignmentEngine;
+
+/** Solve linear assignment problem (auction).
+ *
+ * Solve the linear assignment problem specified by a square cost matrix of 
+ * real numbers with the auction algorithm. Rows bid for columns, starting 
+ * with a large epsilon which is reduced by GA_AUCTION_EPSILON_FACTOR in each 
+ * phase, until it is smaller than <tt>tolerance / size</tt>. The cost of the 
+ * solution then exceeds the optimal cost by less than \c tolerance, so for 
+ * integer costs, a tolerance of at most 1 yields an optimal solution. 
+ * Epsilon is not reduced below GA_AUCTION_MIN_RELATIVE_EPSILON times the 
+ * range of the costs, which limits the tolerance that can be reached. The 
+ * bids are computed in parallel if more than one thread is requested and the 
+ * package has been compiled with OpenMP support. The result does not depend 
+ * on the number of threads. The solution returned is a vector of rows 
+ * assigned to columns, as by GA_linear_assignment_solve_real(). The vector 
+ * which is returned will be referenced and should be destroyed by using 
+ * GA_vector_destroy_int() when it is not needed anymore.
+ *
+ * \param costMatrix cost matrix
+ * \param tolerance maximum excess over the optimal cost
+ * \param numThreads number of threads
+ *
+ * \return Solution of the linear assignment problem, or 0 if an error 
+ * occurs
+ */
+GAVectorInt* GA_linear_assignment_solve_auction(GAMatrixReal* costMatrix, 
+    double tolerance, int numThreads);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,774 @@
+/* ----------------------------------------------------------------------------
+ * R package for graph alignment
+ * ----------------------------------------------------------------------------
+ *
+ * Author: Joern P. Meier <mail@ionflux.org>
+ * 
+ * The package can be used freely for non-commercial purposes. If you use this 
+ * package, the appropriate paper to cite is J. Berg and M. Laessig, 
+ * "Cross-species analysis of biological networks by Bayesian alignment", 
+ * PNAS 103 (29), 10967-10972 (2006)
+ * 
+ * This software is made available in the hope that it will be useful, but 
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY 
+ * or FITNESS FOR A PARTICULAR PURPOSE.
+ * 
+ * This software contains code for solving linear assignment problems which was 
+ * written by Roy Jonker, MagicLogic Optimization Inc.. Please note that this 
+ * code is copyrighted, (c) 2003 MagicLogic Systems Inc., Canada and may be 
+ * used for non-commercial purposes only. See 
+ * http://www.magiclogic.com/assignment.html for the latest version of the LAP 
+ * code and details on licensing.
+ *
+ * ----------------------------------------------------------------------------
+ * Score matrix kernels.
+ * ----------------------------------------------------------------------------
+ */
+
+/** \file GA_kernel.c
+ * \brief Score matrix kernels (implementation).
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <stdint.h>
+#include <limits.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#define USE_FC_LEN_T
+#include "R.h"
+#include "R_ext/BLAS.h"
+#include "GA_alloc.h"
+#include "GA_message.h"
+#include "GA_kernel.h"
+
+#ifndef FCONE
+#define FCONE
+#endif
+
+/** Number of rows of network B which are processed together by the bitset 
+ * kernel, so that each row of network A is loaded once per block.
+ */
+#define GA_BITSET_BLOCK_SIZE 16
+
+/** Get number of bits set in a word (generic).
+ */
+static int GA_popcount_generic(uint64_t x)
+{
+#ifdef __GNUC__
+    return __builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return (int)((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/** Get number of bits set in the bitwise AND of two bitsets (generic).
+ */
+static int GA_popcount_and_generic(const uint64_t* x, const uint64_t* y, 
+    int numWords)
+{
+    int result = 0;
+    int w;
+    for (w = 0; w < numWords; w++)
+        result += GA_popcount_generic(x[w] & y[w]);
+    return result;
+}
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+/** Get number of bits set in the bitwise AND of two bitsets (popcnt).
+ *
+ * This version is compiled for processors which support the popcnt 
+ * instruction and is selected at run-time.
+ */
+__attribute__((target("popcnt")))
+static int GA_popcount_and_hw(const uint64_t* x, const uint64_t* y, 
+    int numWords)
+{
+    int result = 0;
+    int w;
+    for (w = 0; w < numWords; w++)
+        result += __builtin_popcountll(x[w] & y[w]);
+    return result;
+}
+#endif
+
+/** Population count function for bitsets.
+ */
+typedef int (*GAPopcountAndFunc)(const uint64_t*, const uint64_t*, int);
+
+/** Get population count function.
+ *
+ * Get the fastest population count function supported by the processor.
+ */
+static GAPopcountAndFunc GA_get_popcount_and_func()
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("popcnt"))
+        return GA_popcount_and_hw;
+#endif
+    return GA_popcount_and_generic;
+}
+
+/** Pad link score matrix with null bin.
+ *
+ * Create a copy of the link score matrix with an additional column of 
+ * zeros for a null bin of network B, which is the number of columns of 
+ * the link score matrix or, if this does not fit into the elements of 
+ * \c bBin, the largest value of the element type, which is never a bin 
+ * number (see GA_matrix_create_bin()). The scalar kernels use the null 
+ * bin for the terms which are excluded from the link score sums, so their 
+ * inner loops do not branch.
+ *
+ * \param linkScore link score matrix
+ * \param bBin bin matrix for network B
+ * \param nullBin where to store the null bin
+ *
+ * \return the padded link score matrix, or 0 if an error occurs
+ */
+static GAMatrixReal* GA_link_score_pad(GAMatrixReal* linkScore, 
+    GAMatrixBin* bBin, int* nullBin)
+{
+    int maxBin = (bBin->eltSize == 1) ? UINT8_MAX 
+        : ((bBin->eltSize == 2) ? UINT16_MAX : INT_MAX);
+    *nullBin = (linkScore->cols < maxBin) ? linkScore->cols : maxBin;
+    GAMatrixReal* result = GA_matrix_create_real(linkScore->rows, 
+        *nullBin + 1);
+    if (result == 0)
+        return 0;
+    int x;
+    int y;
+    for (x = 0; x < linkScore->rows; x++)
+    {
+        for (y = 0; y < *nullBin; y++)
+            result->elts[x][y] = linkScore->elts[x][y];
+        result->elts[x][*nullBin] = 0.0;
+    }
+    return result;
+}
+
+/* 8-bit bins. */
+#define GA_KERNEL_BIN uint8_t
+#define GA_LINK_SUM_SCALAR_FUNC GA_link_sum_scalar_uint8
+#define GA_LINK_SUM_SCALAR_FLOAT_FUNC GA_link_sum_scalar_float_uint8
+#include "GA_kernel_impl.h"
+
+/* 16-bit bins. */
+#define GA_KERNEL_BIN uint16_t
+#define GA_LINK_SUM_SCALAR_FUNC GA_link_sum_scalar_uint16
+#define GA_LINK_SUM_SCALAR_FLOAT_FUNC GA_link_sum_scalar_float_uint16
+#include "GA_kernel_impl.h"
+
+/* 32-bit bins. */
+#define GA_KERNEL_BIN int
+#define GA_LINK_SUM_SCALAR_FUNC GA_link_sum_scalar_int
+#define GA_LINK_SUM_SCALAR_FLOAT_FUNC GA_link_sum_scalar_float_int
+#include "GA_kernel_impl.h"
+
+/** Get excluded link score terms.
+ *
+ * Get the sum of the terms k = j and k = pInv[i] of the unrestricted link 
+ * score sum for element (i, j), which are excluded from the link score sum 
+ * of M. Kernels which sum over all aligned nodes k subtract this value.
+ */
+static double GA_link_sum_excluded(int i, int j, GAMatrixBin* aBin, 
+    GAMatrixBin* bBin, GAVectorInt* p, GAVectorInt* pInv, 
+    GAMatrixReal* linkScore)
+{
+    double result = 0.0;
+    if (p->elts[j] < bBin->rows)
+        result += linkScore->elts[GA_MATRIX_BIN_ELT(aBin, j, j)]
+            [GA_MATRIX_BIN_ELT(bBin, i, p->elts[j])];
+    int k = pInv->elts[i];
+    if ((k < aBin->rows)
+        && (k != j))
+        result += linkScore->elts[GA_MATRIX_BIN_ELT(aBin, j, k)]
+            [GA_MATRIX_BIN_ELT(bBin, i, i)];
+    return result;
+}
+
+GAMatrixReal* GA_link_sum_scalar(GAMatrixReal* result, GAMatrixBin* aBin, 
+    GAMatrixBin* bBin, GAVectorInt* p, GAVectorInt* pInv, 
+    GAMatrixReal* linkScore, int numThreads)
+{
+    /* Both bin matrices use the link lookup vector, so they have the same 
+       element size. */
+    if (aBin->eltSize != bBin->eltSize)
+    {
+        GA_msg()("[GA_link_sum_scalar] "
+            "Bin matrices have different element sizes.", GA_MSG_ERROR);
+        return 0;
+    }
+    int nullBin;
+    GAMatrixReal* table = GA_link_score_pad(linkScore, bBin, &nullBin);
+    if (table == 0)
+        return 0;
+    int ok;
+    if (aBin->eltSize == 1)
+        ok = GA_link_sum_scalar_uint8(result, aBin, bBin, p, table, 
+            nullBin, numThreads);
+    else
+    if (aBin->eltSize == 2)
+        ok = GA_link_sum_scalar_uint16(result, aBin, bBin, p, table, 
+            nullBin, numThreads);
+    else
+        ok = GA_link_sum_scalar_int(result, aBin, bBin, p, table, 
+            nullBin, numThreads);
+    GA_matrix_destroy_real(table);
+    return ok ? result : 0;
+}
+
+GAMatrixFloat* GA_link_sum_scalar_float(GAMatrixFloat* result, 
+    GAMatrixBin* aBin, GAMatrixBin* bBin, GAVectorInt* p, 
+    GAVectorInt* pInv, GAMatrixReal* linkScore, int numThreads)
+{
+    if (aBin->eltSize != bBin->eltSize)
+    {
+        GA_msg()("[GA_link_sum_scalar_float] "
+            "Bin matrices have different element sizes.", GA_MSG_ERROR);
+        return 0;
+    }
+    int nullBin;
+    GAMatrixReal* table = GA_link_score_pad(linkScore, bBin, &nullBin);
+    if (table == 0)
+        return 0;
+    GAMatrixFloat* tableFloat = GA_matrix_to_float_real(table);
+    GA_matrix_destroy_real(table);
+    if (tableFloat == 0)
+        return 0;
+    int ok;
+    if (aBin->eltSize == 1)
+        ok = GA_link_sum_scalar_float_uint8(result, aBin, bBin, p, 
+            tableFloat, nullBin, numThreads);
+    else
+    if (aBin->eltSize == 2)
+        ok = GA_link_sum_scalar_float_uint16(result, aBin, bBin, p, 
+            tableFloat, nullBin, numThreads);
+    else
+        ok = GA_link_sum_scalar_float_int(result, aBin, bBin, p, 
+            tableFloat, nullBin, numThreads);
+    GA_matrix_destroy_float(tableFloat);
+    return ok ? result : 0;
+}
+
+int GA_link_score_factorize(GAMatrixReal* linkScore, int numBins, 
+    GAMatrixReal* u, GAMatrixReal* v)
+{
+    GAMatrixReal* residual = GA_matrix_create_square_real(numBins);
+    if (residual == 0)
+        return -1;
+    int x;
+    int y;
+    double maxAbs = 0.0;
+    for (x = 0; x < numBins; x++)
+        for (y = 0; y < numBins; y++)
+        {
+            residual->elts[x][y] = linkScore->elts[x][y];
+            if (fabs(linkScore->elts[x][y]) > maxAbs)
+                maxAbs = fabs(linkScore->elts[x][y]);
+        }
+    double tolerance = GA_FACTORIZE_TOLERANCE * maxAbs;
+    /* Gaussian elimination with complete pivoting. Each step removes an 
+       outer product u_r v_r^T from the residual, so that the sum of all 
+       outer products equals the link score matrix. */
+    int rank = 0;
+    while (rank < numBins)
+    {
+        int pivotRow = 0;
+        int pivotCol = 0;
+        double pivotAbs = 0.0;
+        for (x = 0; x < numBins; x++)
+            for (y = 0; y < numBins; y++)
+                if (fabs(residual->elts[x][y]) > pivotAbs)
+                {
+                    pivotAbs = fabs(residual->elts[x][y]);
+                    pivotRow = x;
+                    pivotCol = y;
+                }
+        if ((pivotAbs <= tolerance)
+            || (pivotAbs == 0.0))
+            break;
+        double pivot = residual->elts[pivotRow][pivotCol];
+        for (x = 0; x < numBins; x++)
+            u->elts[rank][x] = residual->elts[x][pivotCol];
+        for (y = 0; y < numBins; y++)
+            v->elts[rank][y] = residual->elts[pivotRow][y] / pivot;
+        for (x = 0; x < numBins; x++)
+            for (y = 0; y < numBins; y++)
+                residual->elts[x][y] -= u->elts[rank][x] * v->elts[rank][y];
+        rank++;
+    }
+    GA_matrix_destroy_real(residual);
+    return rank;
+}
+
+GAMatrixReal* GA_link_sum_blas(GAMatrixReal* result, GAMatrixBin* aBin, 
+    GAMatrixBin* bBin, GAVectorInt* p, GAVectorInt* pInv, 
+    GAMatrixReal* linkScore, int numBins, int numThreads)
+{
+    int numA = aBin->rows;
+    int numB = bBin->rows;
+    if ((numA == 0)
+        || (numB == 0))
+        return result;
+    int* binCount = (int*)GA_alloc(numBins, sizeof(int));
+    GAMatrixReal* u = GA_matrix_create_square_real(numBins);
+    GAMatrixReal* v = GA_matrix_create_square_real(numBins);
+    if ((binCount == 0)
+        || (u == 0)
+        || (v == 0))
+    {
+        GA_msg()("[GA_link_sum_blas] "
+            "Could not allocate buffers.", GA_MSG_ERROR);
+        return 0;
+    }
+    memset(binCount, 0, numBins * sizeof(int));
+    int j;
+    int k;
+    for (j = 0; j < numA; j++)
+        for (k = 0; k < numA; k++)
+            binCount[GA_MATRIX_BIN_ELT(aBin, j, k)]++;
+    int numUsedBins = 0;
+    int x;
+    for (x = 0; x < numBins; x++)
+        if (binCount[x] > 0)
+            numUsedBins++;
+    /* Each term of the link score sum is a matrix product of the values 
+       aValues[aBin[j][k]] and bValues[bBin[i][p[k]]]. If the link score 
+       matrix has a low rank (for example, if it has been created by 
+       CreateScoreMatrix()), its factors are used as the value tables, which 
+       requires one product per rank. Otherwise, there is one product per 
+       used bin of network A, with an indicator function for the bin as 
+       aValues and the corresponding row of the link score matrix as 
+       bValues. */
+    int rank = GA_link_score_factorize(linkScore, numBins, u, v);
+    if (rank < 0)
+        return 0;
+    int lowRank = (rank < numUsedBins);
+    int numTerms = lowRank ? rank : numBins;
+    double* aValues = (double*)GA_alloc(numBins, sizeof(double));
+    double* bValues = (double*)GA_alloc(numBins, sizeof(double));
+    /* All buffers are stored in row-major order, which is column-major 
+       order for the transposed matrices. The product W I^T (numB x numA, 
+       row-major) is therefore computed as I W^T (numA x numB, 
+       column-major). Since the result matrix is stored contiguously, the 
+       product is accumulated directly in the result, using the row stride 
+       as the leading dimension. */
+    double* indicator = (double*)GA_alloc((size_t)numA * numA, 
+        sizeof(double));
+    double* weights = (double*)GA_alloc((size_t)numB * numA, sizeof(double));
+    if ((aValues == 0)
+        || (bValues == 0)
+        || (indicator == 0)
+        || (weights == 0))
+    {
+        GA_msg()("[GA_link_sum_blas] "
+            "Could not allocate buffers.", GA_MSG_ERROR);
+        return 0;
+    }
+    double beta = 0.0;
+    int t;
+    for (t = 0; t < numTerms; t++)
+    {
+        int y;
+        if (lowRank)
+        {
+            for (y = 0; y < numBins; y++)
+            {
+                aValues[y] = u->elts[t][y];
+                bValues[y] = v->elts[t][y];
+            }
+        } else
+        {
+            if (binCount[t] == 0)
+                continue;
+            for (y = 0; y < numBins; y++)
+            {
+                aValues[y] = (y == t) ? 1.0 : 0.0;
+                bValues[y] = linkScore->elts[t][y];
+            }
+        }
+#pragma omp parallel for num_threads(numThreads)
+        for (j = 0; j < numA; j++)
+        {
+            int l;
+            double* target = indicator + (size_t)j * numA;
+            for (l = 0; l < numA; l++)
+                target[l] = aValues[GA_MATRIX_BIN_ELT(aBin, j, l)];
+        }
+        int i;
+#pragma omp parallel for num_threads(numThreads)
+        for (i = 0; i < numB; i++)
+        {
+            int l;
+            double* target = weights + (size_t)i * numA;
+            for (l = 0; l < numA; l++)
+                if (p->elts[l] < numB)
+                    target[l] = bValues[GA_MATRIX_BIN_ELT(bBin, i, 
+                        p->elts[l])];
+                else
+                    target[l] = 0.0;
+        }
+        double alpha = 1.0;
+        F77_CALL(dgemm)("T", "N", &numA, &numB, &numA, &alpha, indicator, 
+            &numA, weights, &numA, &beta, result->data, &result->stride 
+            FCONE FCONE);
+        beta = 1.0;
+    }
+    int i;
+    if (beta == 0.0)
+    {
+        /* All link scores are zero. */
+        for (i = 0; i < numB; i++)
+            memset(result->elts[i], 0, numA * sizeof(double));
+    }
+#pragma omp parallel for num_threads(numThreads)
+    for (i = 0; i < numB; i++)
+    {
+        int l;
+        double* target = result->elts[i];
+        for (l = 0; l < numA; l++)
+            target[l] -= GA_link_sum_excluded(i, l, aBin, bBin, p, pInv, 
+                linkScore);
+    }
+    GA_free((char*)aValues);
+    GA_free((char*)bValues);
+    GA_free((char*)indicator);
+    GA_free((char*)weights);
+    GA_free((char*)binCount);
+    GA_matrix_destroy_real(u);
+    GA_matrix_destroy_real(v);
+    return result;
+}
+
+GAMatrixReal* GA_link_sum_bitset(GAMatrixReal* result, GAMatrixBin* aBin, 
+    GAMatrixBin* bBin, GAVectorInt* p, GAVectorInt* pInv, 
+    GAMatrixReal* linkScore, int numThreads)
+{
+    int numA = aBin->rows;
+    int numB = bBin->rows;
+    if ((numA == 0)
+        || (numB == 0))
+        return result;
+    int numWords = (numA + 63) / 64;
+    uint64_t* aBits = (uint64_t*)GA_alloc((size_t)numA * numWords, 
+        sizeof(uint64_t));
+    uint64_t* bBits = (uint64_t*)GA_alloc((size_t)numB * numWords, 
+        sizeof(uint64_t));
+    uint64_t* validBits = (uint64_t*)GA_alloc(numWords, sizeof(uint64_t));
+    int* aCount = (int*)GA_alloc(numA, sizeof(int));
+    int* bCount = (int*)GA_alloc(numB, sizeof(int));
+    if ((aBits == 0)
+        || (bBits == 0)
+        || (validBits == 0)
+        || (aCount == 0)
+        || (bCount == 0))
+    {
+        GA_msg()("[GA_link_sum_bitset] "
+            "Could not allocate bitsets.", GA_MSG_ERROR);
+        return 0;
+    }
+    /* The allocation function does not necessarily clear the memory. */
+    memset(aBits, 0, (size_t)numA * numWords * sizeof(uint64_t));
+    memset(bBits, 0, (size_t)numB * numWords * sizeof(uint64_t));
+    memset(validBits, 0, numWords * sizeof(uint64_t));
+    /* Set up the bitsets. Only nodes of network A which are aligned to a 
+       node of network B are taken into account. */
+    int k;
+    int numValid = 0;
+    for (k = 0; k < numA; k++)
+        if (p->elts[k] < numB)
+        {
+            validBits[k / 64] |= ((uint64_t)1) << (k % 64);
+            numValid++;
+        }
+    int j;
+#pragma omp parallel for num_threads(numThreads)
+    for (j = 0; j < numA; j++)
+    {
+        int l;
+        uint64_t* target = aBits + (size_t)j * numWords;
+        for (l = 0; l < numA; l++)
+            if (GA_MATRIX_BIN_ELT(aBin, j, l) == 1)
+                target[l / 64] |= ((uint64_t)1) << (l % 64);
+        int count = 0;
+        for (l = 0; l < numWords; l++)
+            count += GA_popcount_generic(target[l] & validBits[l]);
+        aCount[j] = count;
+    }
+    int i;
+#pragma omp parallel for num_threads(numThreads)
+    for (i = 0; i < numB; i++)
+    {
+        int l;
+        uint64_t* target = bBits + (size_t)i * numWords;
+        int count = 0;
+        for (l = 0; l < numA; l++)
+            if ((p->elts[l] < numB)
+                && (GA_MATRIX_BIN_ELT(bBin, i, p->elts[l]) == 1))
+            {
+                target[l / 64] |= ((uint64_t)1) << (l % 64);
+                count++;
+            }
+        bCount[i] = count;
+    }
+    double s00 = linkScore->elts[0][0];
+    double s01 = linkScore->elts[0][1];
+    double s10 = linkScore->elts[1][0];
+    double s11 = linkScore->elts[1][1];
+    GAPopcountAndFunc popcountAnd = GA_get_popcount_and_func();
+    int numBlocks = (numB + GA_BITSET_BLOCK_SIZE - 1) / GA_BITSET_BLOCK_SIZE;
+    int block;
+#pragma omp parallel for num_threads(numThreads) schedule(dynamic, 1)
+    for (block = 0; block < numBlocks; block++)
+    {
+        int iStart = block * GA_BITSET_BLOCK_SIZE;
+        int iEnd = iStart + GA_BITSET_BLOCK_SIZE;
+        if (iEnd > numB)
+            iEnd = numB;
+        int l;
+        for (l = 0; l < numA; l++)
+        {
+            const uint64_t* aRow = aBits + (size_t)l * numWords;
+            int m;
+            for (m = iStart; m < iEnd; m++)
+            {
+                int n11 = popcountAnd(aRow, bBits + (size_t)m * numWords, 
+                    numWords);
+                int n10 = aCount[l] - n11;
+                int n01 = bCount[m] - n11;
+                int n00 = numValid - n11 - n10 - n01;
+                result->elts[m][l] = n00 * s00 + n01 * s01 + n10 * s10 
+                    + n11 * s11 - GA_link_sum_excluded(m, l, aBin, bBin, p, 
+                        pInv, linkScore);
+            }
+        }
+    }
+    GA_free((char*)aBits);
+    GA_free((char*)bBits);
+    GA_free((char*)validBits);
+    GA_free((char*)aCount);
+    GA_free((char*)bCount);
+    return result;
+}
+
+/** Get excluded link score terms (sparse).
+ *
+ * Get the excluded link score terms (see GA_link_sum_excluded()) for 
+ * sparse bin matrices.
+ *
+ * \param i row index of M
+ * \param j column index of M
+ * \param aBin sparse bin matrix for network A
+ * \param bBin sparse bin matrix for network B
+ * \param p permutation vector
+ * \param pInv inverse permutation vector
+ * \param linkScore link score matrix
+ *
+ * \return sum of the excluded terms
+ */
+static double GA_link_sum_excluded_sparse(int i, int j, 
+    GASparseMatrixInt* aBin, GASparseMatrixInt* bBin, GAVectorInt* p, 
+    GAVectorInt* pInv, GAMatrixReal* linkScore)
+{
+    double result = 0.0;
+    if (p->elts[j] < bBin->rows)
+        result += linkScore->elts[GA_sparse_get_int(aBin, j, j)]
+            [GA_sparse_get_int(bBin, i, p->elts[j])];
+    int k = pInv->elts[i];
+    if ((k < aBin->rows)
+        && (k != j))
+        result += linkScore->elts[GA_sparse_get_int(aBin, j, k)]
+            [GA_sparse_get_int(bBin, i, i)];
+    return result;
+}
+
+GAMatrixReal* GA_link_sum_sparse_csr(GAMatrixReal* result, 
+    GASparseMatrixInt* aBin, GASparseMatrixInt* bBin, GAVectorInt* p, 
+    GAVectorInt* pInv, GAMatrixReal* linkScore, int numThreads)
+{
+    int numA = aBin->rows;
+    int numB = bBin->rows;
+    if ((numA == 0)
+        || (numB == 0))
+        return result;
+    int aDefault = aBin->defaultElt;
+    int bDefault = bBin->defaultElt;
+    /* Set up the lists of non-default elements for the rows of network A 
+       and the rows of the permuted network B. Only nodes k of network A 
+       which are aligned to a node of network B are stored, so all other 
+       elements of the lists are known to be in the default bin. */
+    int numValid = 0;
+    int k;
+    for (k = 0; k < numA; k++)
+        if (p->elts[k] < numB)
+            numValid++;
+    int numAElts = 0;
+    int numBElts = 0;
+    int n;
+    for (n = 0; n < aBin->numElts; n++)
+        if (p->elts[aBin->colIndex[n]] < numB)
+            numAElts++;
+    for (n = 0; n < bBin->numElts; n++)
+        if (pInv->elts[bBin->colIndex[n]] < numA)
+            numBElts++;
+    GASparseMatrixInt* aList = GA_sparse_create_int(numA, numA, numAElts, 
+        aDefault);
+    if (aList == 0)
+        return 0;
+    GASparseMatrixInt* bList = GA_sparse_create_int(numB, numA, numBElts, 
+        bDefault);
+    if (bList == 0)
+        return 0;
+    int* bucketStart = (int*)GA_alloc(numA + 1, sizeof(int));
+    int* bucketRow = (int*)GA_alloc(numBElts > 0 ? numBElts : 1, 
+        sizeof(int));
+    int* bucketElt = (int*)GA_alloc(numBElts > 0 ? numBElts : 1, 
+        sizeof(int));
+    if ((bucketStart == 0)
+        || (bucketRow == 0)
+        || (bucketElt == 0))
+    {
+        GA_msg()("[GA_link_sum_sparse_csr] "
+            "Could not allocate permutation buffers.", GA_MSG_ERROR);
+        return 0;
+    }
+    int j;
+    n = 0;
+    for (j = 0; j < numA; j++)
+    {
+        aList->rowStart[j] = n;
+        for (k = aBin->rowStart[j]; k < aBin->rowStart[j + 1]; k++)
+            if (p->elts[aBin->colIndex[k]] < numB)
+            {
+                aList->colIndex[n] = aBin->colIndex[k];
+                aList->elts[n] = aBin->elts[k];
+                n++;
+            }
+    }
+    aList->rowStart[numA] = n;
+    /* The columns l of network B are replaced by the nodes k = pInv[l] of 
+       network A. The elements are sorted by k by distributing them into 
+       buckets first and then collecting the buckets in ascending order. */
+    for (k = 0; k <= numA; k++)
+        bucketStart[k] = 0;
+    for (j = 0; j <= numB; j++)
+        bList->rowStart[j] = 0;
+    for (n = 0; n < bBin->numElts; n++)
+    {
+        k = pInv->elts[bBin->colIndex[n]];
+        if (k < numA)
+            bucketStart[k + 1]++;
+    }
+    for (k = 0; k < numA; k++)
+        bucketStart[k + 1] += bucketStart[k];
+    for (j = 0; j < numB; j++)
+        for (n = bBin->rowStart[j]; n < bBin->rowStart[j + 1]; n++)
+        {
+            k = pInv->elts[bBin->colIndex[n]];
+            if (k < numA)
+            {
+                bucketRow[bucketStart[k]] = j;
+                bucketElt[bucketStart[k]] = bBin->elts[n];
+                bucketStart[k]++;
+                bList->rowStart[j + 1]++;
+            }
+        }
+    for (j = 0; j < numB; j++)
+        bList->rowStart[j + 1] += bList->rowStart[j];
+    /* The bucket start indices have been shifted to the bucket ends. */
+    int* rowPos = (int*)GA_alloc(numB, sizeof(int));
+    if (rowPos == 0)
+        return 0;
+    for (j = 0; j < numB; j++)
+        rowPos[j] = bList->rowStart[j];
+    n = 0;
+    for (k = 0; k < numA; k++)
+        for (; n < bucketStart[k]; n++)
+        {
+            int row = bucketRow[n];
+            bList->colIndex[rowPos[row]] = k;
+            bList->elts[rowPos[row]] = bucketElt[n];
+            rowPos[row]++;
+        }
+    GA_free((char*)bucketStart);
+    GA_free((char*)bucketRow);
+    GA_free((char*)bucketElt);
+    GA_free((char*)rowPos);
+    /* Each element starts from the baseline of all aligned nodes in the 
+       default bins, which is corrected for the nodes in the union of the 
+       two lists. */
+    double** scores = linkScore->elts;
+    double baseScore = scores[aDefault][bDefault];
+    double baseline = numValid * baseScore;
+    int i;
+#pragma omp parallel for num_threads(numThreads) schedule(dynamic, 1)
+    for (i = 0; i < numB; i++)
+    {
+        int bStart = bList->rowStart[i];
+        int bEnd = bList->rowStart[i + 1];
+        int l;
+        for (l = 0; l < numA; l++)
+        {
+            int aPos = aList->rowStart[l];
+            int aEnd = aList->rowStart[l + 1];
+            int bPos = bStart;
+            double correction = 0.0;
+            while ((aPos < aEnd)
+                || (bPos < bEnd))
+            {
+                int aCol = (aPos < aEnd) ? aList->colIndex[aPos] : numA;
+                int bCol = (bPos < bEnd) ? bList->colIndex[bPos] : numA;
+                if (aCol == bCol)
+                {
+                    correction += scores[aList->elts[aPos]][bList->elts[bPos]] 
+                        - baseScore;
+                    aPos++;
+                    bPos++;
+                } else
+                if (aCol < bCol)
+                {
+                    correction += scores[aList->elts[aPos]][bDefault] 
+                        - baseScore;
+                    aPos++;
+                } else
+                {
+                    correction += scores[aDefault][bList->elts[bPos]] 
+                        - baseScore;
+                    bPos++;
+                }
+            }
+            result->elts[i][l] = baseline + correction 
+                - GA_link_sum_excluded_sparse(i, l, aBin, bBin, p, pInv, 
+                    linkScore);
+        }
+    }
+    GA_sparse_destroy_int(aList);
+    GA_sparse_destroy_int(bList);
+    return result;
+}
+
+GAMatrixReal* GA_link_sum_sparse(GAMatrixReal* result, GAMatrixBin* aBin, 
+    GAMatrixBin* bBin, GAVectorInt* p, GAVectorInt* pInv, 
+    GAMatrixReal* linkScore, int numBins, int numThreads)
+{
+    GASparseMatrixInt* aSparse = GA_sparse_from_matrix_bin(aBin, 
+        GA_matrix_get_dominant_bin(aBin, numBins));
+    if (aSparse == 0)
+        return 0;
+    GASparseMatrixInt* bSparse = GA_sparse_from_matrix_bin(bBin, 
+        GA_matrix_get_dominant_bin(bBin, numBins));
+    if (bSparse == 0)
+        return 0;
+    GAMatrixReal* linkResult = GA_link_sum_sparse_csr(result, aSparse, 
+        bSparse, p, pInv, linkScore, numThreads);
+    GA_sparse_destroy_int(aSparse);
+    GA_sparse_destroy_int(bSparse);
+    return linkResult;
+}
@@ -0,0 +1,263 @@
+#ifndef GA_KERNEL
+#define GA_KERNEL
+/* ----------------------------------------------------------------------------
+ * R package for graph alignment
+ * ----------------------------------------------------------------------------
+ *
+ * Author: Joern P. Meier <mail@ionflux.org>
+ * 
+ * The package can be used freely for non-commercial purposes. If you use this 
+ * package, the appropriate paper to cite is J. Berg and M. Laessig, 
+ * "Cross-species analysis of biological networks by Bayesian alignment", 
+ * PNAS 103 (29), 10967-10972 (2006)
+ * 
+ * This software is made available in the hope that it will be useful, but 
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY 
+ * or FITNESS FOR A PARTICULAR PURPOSE.
+ * 
+ * This software contains code for solving linear assignment problems which was 
+ * written by Roy Jonker, MagicLogic Optimization Inc.. Please note that this 
+ * code is copyrighted, (c) 2003 MagicLogic Systems Inc., Canada and may be 
+ * used for non-commercial purposes only. See 
+ * http://www.magiclogic.com/assignment.html for the latest version of the LAP 
+ * code and details on licensing.
+ *
+ * ----------------------------------------------------------------------------
+ * Score matrix kernels.
+ * ----------------------------------------------------------------------------
+ */
+
+/** \file GA_kernel.h
+ * \brief Score matrix kernels.
+ *
+ * This module provides the kernels which compute the link score part of the 
+ * score matrix M. Several implementations (engines) are available which 
+ * produce the same result up to rounding, but differ in the way the sum 
+ * over the nodes of network A is evaluated.
+ */
+
+#include "GA_vector.h"
+#include "GA_matrix.h"
+#include "GA_sparse.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** Relative tolerance for the factorization of link score matrices.
+ */
+#define GA_FACTORIZE_TOLERANCE 1e-12
+
+/** Number of terms which are summed up directly by the single precision 
+ * kernels before the sum is added to the compensated total.
+ */
+#define GA_KERNEL_FLOAT_BLOCK_SIZE 16
+
+/** Compute engine (implementation).
+ *
+ * The compute engine specifies which kernel is used to compute the link 
+ * score part of the score matrix M.
+ */
+enum GAComputeEngine_Impl
+{
+    /** Compute engine: scalar loop over all node triples.
+     */
+    GA_ENGINE_SCALAR = 0,
+    /** Compute engine: matrix products using the BLAS.
+     */
+    GA_ENGINE_BLAS = 1,
+    /** Compute engine: bit-packed adjacency matrices (two link bins only).
+     */
+    GA_ENGINE_BITSET = 2,
+    /** Compute engine: lists of elements outside of the dominant bin.
+     */
+    GA_ENGINE_SPARSE = 3
+};
+
+/** Compute engine.
+ */
+typedef enum GAComputeEngine_Impl GAComputeEngine;
+
+/** Compute link score sums (scalar).
+ *
+ * Compute the link score sum
+ *
+ * <tt>L(i, j) = sum_k linkScore[aBin[j][k]][bBin[i][p[k]]]</tt>
+ *
+ * for all nodes i of network B and j of network A, where the sum runs over 
+ * all nodes k of network A which are aligned to a node of network B, 
+ * excluding k = j and p[k] = i. The result is stored in the upper left 
+ * block of \c result, which must have at least as many rows as network B 
+ * and at least as many columns as network A. Other elements of \c result 
+ * are not changed.
+ *
+ * For each node i of network B, the row of \c bBin is permuted once by 
+ * \c p into a per-thread buffer, in which the excluded terms select a 
+ * null bin with a link score of zero, so the sums over k read both bin 
+ * rows with unit stride and do not branch. \c pInv is not used.
+ *
+ * \param result matrix for the result
+ * \param aBin bin matrix for network A
+ * \param bBin bin matrix for network B
+ * \param p permutation vector
+ * \param pInv inverse permutation vector
+ * \param linkScore link score matrix
+ * \param numThreads number of threads
+ *
+ * \return the result matrix, or 0 if an error occurs
+ */
+GAMatrixReal* GA_link_sum_scalar(GAMatrixReal* result, GAMatrixBin* aBin, 
+    GAMatrixBin* bBin, GAVectorInt* p, GAVectorInt* pInv, 
+    GAMatrixReal* linkScore, int numThreads);
+
+/** Compute link score sums (scalar, single precision).
+ *
+ * Compute the link score sums (see GA_link_sum_scalar()) in single 
+ * precision and store them in a single precision matrix. The terms are 
+ * summed up in blocks of #GA_KERNEL_FLOAT_BLOCK_SIZE terms, and the block 
+ * sums are added with Kahan summation, so the error of each sum does not 
+ * grow with the number of nodes.
+ *
+ * \param result matrix for the result
+ * \param aBin bin matrix for network A
+ * \param bBin bin matrix for network B
+ * \param p permutation vector
+ * \param pInv inverse permutation vector
+ * \param linkScore link score matrix
+ * \param numThreads number of threads
+ *
+ * \return the result matrix, or 0 if an error occurs
+ */
+GAMatrixFloat* GA_link_sum_scalar_float(GAMatrixFloat* result, 
+    GAMatrixBin* aBin, GAMatrixBin* bBin, GAVectorInt* p, 
+    GAVectorInt* pInv, GAMatrixReal* linkScore, int numThreads);
+
+/** Factorize link score matrix.
+ *
+ * Factorize the upper left \c numBins x \c numBins block of the link score 
+ * matrix into a sum of outer products
+ *
+ * <tt>linkScore[x][y] = sum_r u[r][x] * v[r][y]</tt>
+ *
+ * using Gaussian elimination with complete pivoting. The number of terms 
+ * is the numerical rank of the matrix (relative to 
+ * GA_FACTORIZE_TOLERANCE). A score matrix created by CreateScoreMatrix() 
+ * has rank 1. The factors are stored in the first rows of \c u and \c v, 
+ * which must be matrices of size at least \c numBins x \c numBins.
+ *
+ * \param linkScore link score matrix
+ * \param numBins number of link bins
+ * \param u matrix for the factors of network A
+ * \param v matrix for the factors of network B
+ *
+ * \return rank of the link score matrix, or -1 if an error occurs
+ */
+int GA_link_score_factorize(GAMatrixReal* linkScore, int numBins, 
+    GAMatrixReal* u, GAMatrixReal* v);
+
+/** Compute link score sums (BLAS).
+ *
+ * Compute the link score sums (see GA_link_sum_scalar()) using matrix 
+ * products. For each bin x of network A, the indicator matrix 
+ * <tt>I_x[j][k] = (aBin[j][k] == x)</tt> and the score matrix 
+ * <tt>W_x[i][k] = linkScore[x][bBin[i][p[k]]]</tt> of the permuted network 
+ * B are set up, and <tt>W_x I_x^T</tt> is accumulated using \c dgemm from 
+ * the BLAS used by R. The excluded terms are subtracted afterwards.
+ *
+ * If the rank of the link score matrix is smaller than the number of bins 
+ * which occur in network A, the factors obtained from 
+ * GA_link_score_factorize() are used instead of the indicator matrices, 
+ * which requires only one product per rank. This is the case for score 
+ * matrices created by CreateScoreMatrix(), which have rank 1.
+ *
+ * \param result matrix for the result
+ * \param aBin bin matrix for network A
+ * \param bBin bin matrix for network B
+ * \param p permutation vector
+ * \param pInv inverse permutation vector
+ * \param linkScore link score matrix
+ * \param numBins number of link bins
+ * \param numThreads number of threads
+ *
+ * \return the result matrix, or 0 if an error occurs
+ */
+GAMatrixReal* GA_link_sum_blas(GAMatrixReal* result, GAMatrixBin* aBin, 
+    GAMatrixBin* bBin, GAVectorInt* p, GAVectorInt* pInv, 
+    GAMatrixReal* linkScore, int numBins, int numThreads);
+
+/** Compute link score sums (bitset).
+ *
+ * Compute the link score sums (see GA_link_sum_scalar()) for networks with 
+ * exactly two link bins, as is the case for unweighted networks. Row j of 
+ * network A and row i of the permuted network B are stored as packed 64-bit 
+ * bitsets of the nodes which fall into bin 1. The link score sum then only 
+ * depends on the four co-occurrence counts of the bins, which are obtained 
+ * from the population count of the bitwise AND of the two rows and the 
+ * precomputed row counts. The excluded terms are subtracted afterwards.
+ *
+ * \param result matrix for the result
+ * \param aBin bin matrix for network A
+ * \param bBin bin matrix for network B
+ * \param p permutation vector
+ * \param pInv inverse permutation vector
+ * \param linkScore link score matrix
+ * \param numThreads number of threads
+ *
+ * \return the result matrix, or 0 if an error occurs
+ */
+GAMatrixReal* GA_link_sum_bitset(GAMatrixReal* result, GAMatrixBin* aBin, 
+    GAMatrixBin* bBin, GAVectorInt* p, GAVectorInt* pInv, 
+    GAMatrixReal* linkScore, int numThreads);
+
+/** Compute link score sums (sparse).
+ *
+ * Compute the link score sums (see GA_link_sum_scalar()) for sparse 
+ * networks. The dominant bins (usually the bins of "no link") of network A 
+ * and network B are determined, and the link score sum of each element 
+ * starts from the baseline of all aligned nodes falling into the dominant 
+ * bins. Corrections are then added for the nodes k where row j of network 
+ * A or row i of the permuted network B is outside of the dominant bin, 
+ * using per-row lists of these nodes. This takes O(n^2 d) time instead of 
+ * O(n^3), where d is the average number of elements per row outside of the 
+ * dominant bin. The excluded terms are subtracted afterwards.
+ *
+ * \param result matrix for the result
+ * \param aBin bin matrix for network A
+ * \param bBin bin matrix for network B
+ * \param p permutation vector
+ * \param pInv inverse permutation vector
+ * \param linkScore link score matrix
+ * \param numBins number of link bins
+ * \param numThreads number of threads
+ *
+ * \return the result matrix, or 0 if an error occurs
+ */
+GAMatrixReal* GA_link_sum_sparse(GAMatrixReal* result, GAMatrixBin* aBin, 
+    GAMatrixBin* bBin, GAVectorInt* p, GAVectorInt* pInv, 
+    GAMatrixReal* linkScore, int numBins, int numThreads);
+
+/** Compute link score sums (sparse bin matrices).
+ *
+ * Compute the link score sums (see GA_link_sum_sparse()) for networks 
+ * which are given as sparse bin matrices. The default elements of the bin 
+ * matrices are used as the dominant bins.
+ *
+ * \param result matrix for the result
+ * \param aBin sparse bin matrix for network A
+ * \param bBin sparse bin matrix for network B
+ * \param p permutation vector
+ * \param pInv inverse permutation vector
+ * \param linkScore link score matrix
+ * \param numThreads number of threads
+ *
+ * \return the result matrix, or 0 if an error occurs
+ */
+GAMatrixReal* GA_link_sum_sparse_csr(GAMatrixReal* result, 
+    GASparseMatrixInt* aBin, GASparseMatrixInt* bBin, GAVectorInt* p, 
+    GAVectorInt* pInv, GAMatrixReal* linkScore, int numThreads);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
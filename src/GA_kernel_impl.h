@@ -0,0 +1,187 @@
+/* ----------------------------------------------------------------------------
+ * R package for graph alignment
+ * ----------------------------------------------------------------------------
+ *
+ * Author: Joern P. Meier <mail@ionflux.org>
+ * 
+ * The package can be used freely for non-commercial purposes. If you use this 
+ * package, the appropriate paper to cite is J. Berg and M. Laessig, 
+ * "Cross-species analysis of biological networks by Bayesian alignment", 
+ * PNAS 103 (29), 10967-10972 (2006)
+ * 
+ * This software is made available in the hope that it will be useful, but 
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY 
+ * or FITNESS FOR A PARTICULAR PURPOSE.
+ * 
+ * This software contains code for solving linear assignment problems which was 
+ * written by Roy Jonker, MagicLogic Optimization Inc.. Please note that this 
+ * code is copyrighted, (c) 2003 MagicLogic Systems Inc., Canada and may be 
+ * used for non-commercial purposes only. See 
+ * http://www.magiclogic.com/assignment.html for the latest version of the LAP 
+ * code and details on licensing.
+ *
+ * ----------------------------------------------------------------------------
+ * Score matrix kernels (implementation template).
+ * ----------------------------------------------------------------------------
+ */
+
+/** \file GA_kernel_impl.h
+ * \brief Score matrix kernels (implementation template).
+ *
+ * This file contains the body of the kernels which read the elements of 
+ * bin matrices in their inner loops. It is included by GA_kernel.c once 
+ * for each element size of GAMatrixBin. The including file must define 
+ * the following macros, which are undefined at the end of this file:
+ *
+ * - \c GA_KERNEL_BIN type of the elements of the bin matrices
+ * - \c GA_LINK_SUM_SCALAR_FUNC name of the scalar link score kernel
+ * - \c GA_LINK_SUM_SCALAR_FLOAT_FUNC name of the single precision scalar 
+ *   link score kernel
+ */
+
+/** Compute link score sums (scalar, one element size).
+ *
+ * See GA_link_sum_scalar(). \c table is the link score matrix with a 
+ * column of zeros for the null bin \c nullBin (see GA_link_score_pad()).
+ *
+ * \return 1 on success, or 0 if an error occurs
+ */
+static int GA_LINK_SUM_SCALAR_FUNC(GAMatrixReal* result, 
+    GAMatrixBin* aBin, GAMatrixBin* bBin, GAVectorInt* p, 
+    GAMatrixReal* table, int nullBin, int numThreads)
+{
+    int numA = aBin->rows;
+    int numB = bBin->rows;
+    const double* tableData = table->data;
+    size_t tableStride = table->stride;
+    /* Each thread has a buffer for one permuted row of network B. */
+    GA_KERNEL_BIN* bPermRows = (GA_KERNEL_BIN*)GA_alloc( 
+        (size_t)numThreads * (numA > 0 ? numA : 1), sizeof(GA_KERNEL_BIN));
+    if (bPermRows == 0)
+        return 0;
+    int i;
+#pragma omp parallel num_threads(numThreads)
+    {
+#ifdef _OPENMP
+        GA_KERNEL_BIN* bPerm = bPermRows 
+            + (size_t)omp_get_thread_num() * numA;
+#else
+        GA_KERNEL_BIN* bPerm = bPermRows;
+#endif
+#pragma omp for schedule(dynamic, 1)
+        for (i = 0; i < numB; i++)
+        {
+            const GA_KERNEL_BIN* bRow = 
+                (const GA_KERNEL_BIN*)GA_MATRIX_BIN_ROW(bBin, i);
+            int k;
+            /* The permutation is applied once for each row of network B, 
+               which is read from the cache. Nodes which are not aligned 
+               to a node of network B and the node aligned to i select the 
+               null bin, so their terms are zero. */
+            for (k = 0; k < numA; k++)
+            {
+                int pk = p->elts[k];
+                bPerm[k] = ((pk < numB)
+                    && (pk != i)) ? bRow[pk] : (GA_KERNEL_BIN)nullBin;
+            }
+            int j;
+            for (j = 0; j < numA; j++)
+            {
+                const GA_KERNEL_BIN* aRow = 
+                    (const GA_KERNEL_BIN*)GA_MATRIX_BIN_ROW(aBin, j);
+                /* The term k = j is excluded for this element only. */
+                GA_KERNEL_BIN bj = bPerm[j];
+                bPerm[j] = (GA_KERNEL_BIN)nullBin;
+                double linkScoreSum = 0.0;
+                for (k = 0; k < numA; k++)
+                    linkScoreSum += tableData[aRow[k] * tableStride 
+                        + bPerm[k]];
+                bPerm[j] = bj;
+                result->elts[i][j] = linkScoreSum;
+            }
+        }
+    }
+    GA_free((char*)bPermRows);
+    return 1;
+}
+
+/** Compute link score sums (scalar, single precision, one element size).
+ *
+ * See GA_link_sum_scalar_float() and GA_LINK_SUM_SCALAR_FUNC().
+ *
+ * \return 1 on success, or 0 if an error occurs
+ */
+static int GA_LINK_SUM_SCALAR_FLOAT_FUNC(GAMatrixFloat* result, 
+    GAMatrixBin* aBin, GAMatrixBin* bBin, GAVectorInt* p, 
+    GAMatrixFloat* table, int nullBin, int numThreads)
+{
+    int numA = aBin->rows;
+    int numB = bBin->rows;
+    const float* tableData = table->data;
+    size_t tableStride = table->stride;
+    GA_KERNEL_BIN* bPermRows = (GA_KERNEL_BIN*)GA_alloc( 
+        (size_t)numThreads * (numA > 0 ? numA : 1), sizeof(GA_KERNEL_BIN));
+    if (bPermRows == 0)
+        return 0;
+    int i;
+#pragma omp parallel num_threads(numThreads)
+    {
+#ifdef _OPENMP
+        GA_KERNEL_BIN* bPerm = bPermRows 
+            + (size_t)omp_get_thread_num() * numA;
+#else
+        GA_KERNEL_BIN* bPerm = bPermRows;
+#endif
+#pragma omp for schedule(dynamic, 1)
+        for (i = 0; i < numB; i++)
+        {
+            const GA_KERNEL_BIN* bRow = 
+                (const GA_KERNEL_BIN*)GA_MATRIX_BIN_ROW(bBin, i);
+            int k;
+            for (k = 0; k < numA; k++)
+            {
+                int pk = p->elts[k];
+                bPerm[k] = ((pk < numB)
+                    && (pk != i)) ? bRow[pk] : (GA_KERNEL_BIN)nullBin;
+            }
+            int j;
+            for (j = 0; j < numA; j++)
+            {
+                const GA_KERNEL_BIN* aRow = 
+                    (const GA_KERNEL_BIN*)GA_MATRIX_BIN_ROW(aBin, j);
+                GA_KERNEL_BIN bj = bPerm[j];
+                bPerm[j] = (GA_KERNEL_BIN)nullBin;
+                int k0;
+                /* The terms are summed up in short blocks, and the block 
+                   sums are added with Kahan summation, where the rounding 
+                   error of each addition is kept in c and subtracted from 
+                   the next block sum. The blocks are independent of each 
+                   other, so the compensation does not lengthen the chain 
+                   of dependent additions for every term. */
+                float linkScoreSum = 0.0f;
+                float c = 0.0f;
+                for (k0 = 0; k0 < numA; k0 += GA_KERNEL_FLOAT_BLOCK_SIZE)
+                {
+                    int kEnd = (k0 + GA_KERNEL_FLOAT_BLOCK_SIZE < numA) 
+                        ? k0 + GA_KERNEL_FLOAT_BLOCK_SIZE : numA;
+                    float blockSum = 0.0f;
+                    for (k = k0; k < kEnd; k++)
+                        blockSum += tableData[aRow[k] * tableStride 
+                            + bPerm[k]];
+                    float y = blockSum - c;
+                    float t = linkScoreSum + y;
+                    c = (t - linkScoreSum) - y;
+                    linkScoreSum = t;
+                }
+                bPerm[j] = bj;
+                result->elts[i][j] = linkScoreSum;
+            }
+        }
+    }
+    GA_free((char*)bPermRows);
+    return 1;
+}
+
+#undef GA_KERNEL_BIN
+#undef GA_LINK_SUM_SCALAR_FUNC
+#undef GA_LINK_SUM_SCALAR_FLOAT_FUNC
@@ -31,10 +31,16 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
+#include <string.h>
 #include "GA_alloc.h"
 #include "GA_message.h"
 #include "GA_matrix.h"
 
+/** Tile size for transposing matrix operations.
+ */
+#define GA_MATRIX_TILE_SIZE 32
+
 GAMatrixInt* GA_matrix_create_int(int rows, int cols)
 {
     GAMatrixInt* matrix = (GAMatrixInt*)GA_alloc(1, sizeof(GAMatrixInt));
@@ -47,33 +53,33 @@ GAMatrixInt* GA_matrix_create_int(int rows, int cols)
     matrix->rows = rows;
     matrix->cols = cols;
     matrix->refs = 1;
-    matrix->elts = (int**)GA_alloc(rows, sizeof(int*));
+    /* Each row is padded to a multiple of the alignment, and the block has 
+       room for moving the start of the first row to an aligned address. */
+    int eltsPerLine = GA_MATRIX_ALIGNMENT / sizeof(int);
+    matrix->stride = ((cols + eltsPerLine - 1) / eltsPerLine) * eltsPerLine;
+    matrix->block = GA_alloc((size_t)rows * matrix->stride * sizeof(int) 
+        + GA_MATRIX_ALIGNMENT, 1);
+    if (matrix->block == 0)
+    {
+        GA_msg()("[GA_matrix_create_int] "
+            "Could not allocate matrix elements.", GA_MSG_ERROR);
+        GA_free((char*)matrix);
+        return 0;
+    }
+    matrix->data = (int*)(((uintptr_t)matrix->block 
+        + GA_MATRIX_ALIGNMENT - 1) & ~((uintptr_t)GA_MATRIX_ALIGNMENT - 1));
+    matrix->elts = (int**)GA_alloc(rows > 0 ? rows : 1, sizeof(int*));
     if (matrix->elts == 0)
     {
         GA_msg()("[GA_matrix_create_int] "
             "Could not allocate matrix rows.", GA_MSG_ERROR);
+        GA_free(matrix->block);
         GA_free((char*)matrix);
         return 0;
     }
     int i;
     for (i = 0; i < matrix->rows; i++)
-    {
-        matrix->elts[i] = (int*)GA_alloc(cols, sizeof(int));
-        if (matrix->elts[i] == 0)
-        {
-            char* message = GA_alloc(256, sizeof(char));
-            snprintf(message, 256, "[GA_matrix_create_int] "
-                "Could not allocate matrix row %i.", i);
-            GA_msg()(message, GA_MSG_ERROR);
-            GA_free(message);
-            int j;
-            for (j = 0; j < i; j++)
-                GA_free((char*)matrix->elts[j]);
-            GA_free((char*)matrix->elts);
-            GA_free((char*)matrix);
-            return 0;
-        }
-    }
+        matrix->elts[i] = matrix->data + (size_t)i * matrix->stride;
     return matrix;
 }
 
@@ -93,18 +99,11 @@ void GA_matrix_destroy_int(GAMatrixInt* matrix)
     matrix->refs--;
     if (matrix->refs == 0)
     {
-        if (matrix->elts != 0)
-        {
-            int i;
-            for (i = 0; i < matrix->rows; i++)
-                if (matrix->elts[i] != 0)
-                {
-                    GA_free((char*)matrix->elts[i]);
-                    matrix->elts[i] = 0;
-                }
-            GA_free((char*)matrix->elts);
-            matrix->elts = 0;
-        }
+        GA_free((char*)matrix->elts);
+        GA_free(matrix->block);
+        matrix->elts = 0;
+        matrix->data = 0;
+        matrix->block = 0;
         GA_free((char*)matrix);
     }
 }
@@ -133,10 +132,9 @@ GAMatrixInt* GA_matrix_init_from_array_int(GAMatrixInt* matrix, int* source,
         return 0;
     }
     int i;
-    int j;
     for (i = 0; i < matrix->rows; i++)
-        for (j = 0; j < matrix->cols; j++)
-            matrix->elts[i][j] = source[i * matrix->cols + j];
+        memcpy(matrix->elts[i], source + (size_t)i * matrix->cols, 
+            matrix->cols * sizeof(int));
     return matrix;
 }
 
@@ -150,11 +148,9 @@ GAMatrixInt* GA_matrix_create_from_array_int(int* source, int rows, int cols)
 
 GAMatrixInt* GA_matrix_init_zero_int(GAMatrixInt* matrix)
 {
-    int i;
-    int j;
-    for (i = 0; i < matrix->rows; i++)
-        for (j = 0; j < matrix->cols; j++)
-            matrix->elts[i][j] = 0;
+    /* The padding is cleared as well, since all bits zero is zero. */
+    memset(matrix->data, 0, (size_t)matrix->rows * matrix->stride 
+        * sizeof(int));
     return matrix;
 }
 
@@ -208,33 +204,33 @@ GAMatrixReal* GA_matrix_create_real(int rows, int cols)
     matrix->rows = rows;
     matrix->cols = cols;
     matrix->refs = 1;
-    matrix->elts = (double**)GA_alloc(rows, sizeof(double*));
+    /* Each row is padded to a multiple of the alignment, and the block has 
+       room for moving the start of the first row to an aligned address. */
+    int eltsPerLine = GA_MATRIX_ALIGNMENT / sizeof(double);
+    matrix->stride = ((cols + eltsPerLine - 1) / eltsPerLine) * eltsPerLine;
+    matrix->block = GA_alloc((size_t)rows * matrix->stride * sizeof(double) 
+        + GA_MATRIX_ALIGNMENT, 1);
+    if (matrix->block == 0)
+    {
+        GA_msg()("[GA_matrix_create_real] "
+            "Could not allocate matrix elements.", GA_MSG_ERROR);
+        GA_free((char*)matrix);
+        return 0;
+    }
+    matrix->data = (double*)(((uintptr_t)matrix->block 
+        + GA_MATRIX_ALIGNMENT - 1) & ~((uintptr_t)GA_MATRIX_ALIGNMENT - 1));
+    matrix->elts = (double**)GA_alloc(rows > 0 ? rows : 1, sizeof(double*));
     if (matrix->elts == 0)
     {
         GA_msg()("[GA_matrix_create_real] "
             "Could not allocate matrix rows.", GA_MSG_ERROR);
+        GA_free(matrix->block);
         GA_free((char*)matrix);
         return 0;
     }
     int i;
     for (i = 0; i < matrix->rows; i++)
-    {
-        matrix->elts[i] = (double*)GA_alloc(cols, sizeof(double));
-        if (matrix->elts[i] == 0)
-        {
-            char* message = GA_alloc(256, sizeof(char));
-            snprintf(message, 256, "[GA_matrix_create_real] "
-                "Could not allocate matrix row %i.", i);
-            GA_msg()(message, GA_MSG_ERROR);
-            GA_free(message);
-            int j;
-            for (j = 0; j < i; j++)
-                GA_free((char*)matrix->elts[j]);
-            GA_free((char*)matrix->elts);
-            GA_free((char*)matrix);
-            return 0;
-        }
-    }
+        matrix->elts[i] = matrix->data + (size_t)i * matrix->stride;
     return matrix;
 }
 
@@ -254,18 +250,11 @@ void GA_matrix_destroy_real(GAMatrixReal* matrix)
     matrix->refs--;
     if (matrix->refs == 0)
     {
-        if (matrix->elts != 0)
-        {
-            int i;
-            for (i = 0; i < matrix->rows; i++)
-                if (matrix->elts[i] != 0)
-                {
-                    GA_free((char*)matrix->elts[i]);
-                    matrix->elts[i] = 0;
-                }
-            GA_free((char*)matrix->elts);
-            matrix->elts = 0;
-        }
+        GA_free((char*)matrix->elts);
+        GA_free(matrix->block);
+        matrix->elts = 0;
+        matrix->data = 0;
+        matrix->block = 0;
         GA_free((char*)matrix);
     }
 }
@@ -294,10 +283,9 @@ GAMatrixReal* GA_matrix_init_from_array_real(GAMatrixReal* matrix,
         return 0;
     }
     int i;
-    int j;
     for (i = 0; i < matrix->rows; i++)
-        for (j = 0; j < matrix->cols; j++)
-            matrix->elts[i][j] = source[i * matrix->cols + j];
+        memcpy(matrix->elts[i], source + (size_t)i * matrix->cols, 
+            matrix->cols * sizeof(double));
     return matrix;
 }
 
@@ -312,11 +300,9 @@ GAMatrixReal* GA_matrix_create_from_array_real(double* source, int rows,
 
 GAMatrixReal* GA_matrix_init_zero_real(GAMatrixReal* matrix)
 {
-    int i;
-    int j;
-    for (i = 0; i < matrix->rows; i++)
-        for (j = 0; j < matrix->cols; j++)
-            matrix->elts[i][j] = 0.0;
+    /* The padding is cleared as well, since all bits zero is zero. */
+    memset(matrix->data, 0, (size_t)matrix->rows * matrix->stride 
+        * sizeof(double));
     return matrix;
 }
 
@@ -339,12 +325,18 @@ GAMatrixInt* GA_matrix_to_bin_real(GAMatrixReal* matrix, GAVectorReal* lookup,
     GAMatrixInt* result = GA_matrix_create_int(matrix->rows, matrix->cols);
     if (result == 0)
         return 0;
+    GABinLookup binLookup;
+    GA_bin_lookup_init(&binLookup, lookup, clamp);
     int i;
     int j;
     for (i = 0; i < matrix->rows; i++)
         for (j = 0; j < matrix->cols; j++)
-            result->elts[i][j] = GA_get_bin_number(
-                matrix->elts[i][j], lookup, clamp);
+        {
+            result->elts[i][j] = GA_bin_lookup_get(&binLookup, 
+                matrix->elts[i][j]);
+            if (result->elts[i][j] == -1)
+                GA_bin_number_error(matrix->elts[i][j], lookup);
+        }
     /* ----- DEBUG ----- //
     GA_msg()("[GA_matrix_to_bin_real] Input matrix: ", GA_MSG_DEBUG);
     GA_matrix_print_real(matrix);
@@ -383,3 +375,300 @@ GAMatrixReal* GA_matrix_print_real(GAMatrixReal* matrix)
     GA_msg()("]", GA_MSG_INFO);
     return matrix;
 }
+
+GAMatrixViewReal* GA_matrix_view_create_real(const double* data, int rows, 
+    int cols, int rowStride, int colStride)
+{
+    GAMatrixViewReal* view = (GAMatrixViewReal*)GA_alloc(1, 
+        sizeof(GAMatrixViewReal));
+    if (view == 0)
+    {
+        GA_msg()("[GA_matrix_view_create_real] "
+            "Could not allocate matrix view.", GA_MSG_ERROR);
+        return 0;
+    }
+    view->data = data;
+    view->rows = rows;
+    view->cols = cols;
+    view->rowStride = rowStride;
+    view->colStride = colStride;
+    view->refs = 1;
+    return view;
+}
+
+GAMatrixViewReal* GA_matrix_view_of_real(GAMatrixReal* matrix)
+{
+    return GA_matrix_view_create_real(matrix->data, matrix->rows, 
+        matrix->cols, matrix->stride, 1);
+}
+
+GAMatrixViewReal* GA_matrix_view_ref_real(GAMatrixViewReal* view)
+{
+    view->refs++;
+    return view;
+}
+
+void GA_matrix_view_destroy_real(GAMatrixViewReal* view)
+{
+    view->refs--;
+    if (view->refs == 0)
+        GA_free((char*)view);
+}
+
+/** Loop over the elements of a matrix view in tiles.
+ *
+ * Loop over all elements (i, j) of a matrix view in square tiles of 
+ * GA_MATRIX_TILE_SIZE elements, with the row index in the inner loop.
+ */
+#define GA_MATRIX_VIEW_FOR_TILES(view, i, j) \
+    int i##0; \
+    int j##0; \
+    for (i##0 = 0; i##0 < (view)->rows; i##0 += GA_MATRIX_TILE_SIZE) \
+        for (j##0 = 0; j##0 < (view)->cols; j##0 += GA_MATRIX_TILE_SIZE) \
+            for (j = j##0; (j < (view)->cols) \
+                && (j < j##0 + GA_MATRIX_TILE_SIZE); j++) \
+                for (i = i##0; (i < (view)->rows) \
+                    && (i < i##0 + GA_MATRIX_TILE_SIZE); i++)
+
+GAMatrixReal* GA_matrix_init_from_view_real(GAMatrixReal* matrix, 
+    GAMatrixViewReal* view)
+{
+    int i;
+    int j;
+    GA_MATRIX_VIEW_FOR_TILES(view, i, j)
+        matrix->elts[i][j] = view->data[(size_t)i * view->rowStride 
+            + (size_t)j * view->colStride];
+    return matrix;
+}
+
+GAMatrixInt* GA_matrix_init_from_view_int(GAMatrixInt* matrix, 
+    GAMatrixViewReal* view)
+{
+    int i;
+    int j;
+    GA_MATRIX_VIEW_FOR_TILES(view, i, j)
+        matrix->elts[i][j] = (int)view->data[(size_t)i * view->rowStride 
+            + (size_t)j * view->colStride];
+    return matrix;
+}
+
+GAMatrixBin* GA_matrix_create_bin(int rows, int cols, int numBins)
+{
+    GAMatrixBin* matrix = (GAMatrixBin*)GA_alloc(1, sizeof(GAMatrixBin));
+    if (matrix == 0)
+    {
+        GA_msg()("[GA_matrix_create_bin] "
+            "Could not allocate matrix.", GA_MSG_ERROR);
+        return 0;
+    }
+    matrix->rows = rows;
+    matrix->cols = cols;
+    matrix->refs = 1;
+    /* The largest value of the element type is never a bin number. */
+    if (numBins < 256)
+        matrix->eltSize = 1;
+    else
+    if (numBins < 65536)
+        matrix->eltSize = 2;
+    else
+        matrix->eltSize = sizeof(int);
+    /* Each row is padded to a multiple of the alignment, and the block has 
+       room for moving the start of the first row to an aligned address. */
+    matrix->stride = (((size_t)cols * matrix->eltSize + GA_MATRIX_ALIGNMENT 
+        - 1) / GA_MATRIX_ALIGNMENT) * GA_MATRIX_ALIGNMENT;
+    matrix->block = GA_alloc((size_t)rows * matrix->stride 
+        + GA_MATRIX_ALIGNMENT, 1);
+    if (matrix->block == 0)
+    {
+        GA_msg()("[GA_matrix_create_bin] "
+            "Could not allocate matrix elements.", GA_MSG_ERROR);
+        GA_free((char*)matrix);
+        return 0;
+    }
+    matrix->data = (char*)(((uintptr_t)matrix->block 
+        + GA_MATRIX_ALIGNMENT - 1) & ~((uintptr_t)GA_MATRIX_ALIGNMENT - 1));
+    return matrix;
+}
+
+GAMatrixBin* GA_matrix_ref_bin(GAMatrixBin* matrix)
+{
+    matrix->refs++;
+    return matrix;
+}
+
+void GA_matrix_destroy_bin(GAMatrixBin* matrix)
+{
+    matrix->refs--;
+    if (matrix->refs == 0)
+    {
+        GA_free(matrix->block);
+        matrix->data = 0;
+        matrix->block = 0;
+        GA_free((char*)matrix);
+    }
+}
+
+GAMatrixBin* GA_matrix_view_to_bin_real(GAMatrixViewReal* view, 
+    GAVectorReal* lookup, GAClampMode clamp, int numThreads)
+{
+    GAMatrixBin* result = GA_matrix_create_bin(view->rows, view->cols, 
+        lookup->size - 1);
+    if (result == 0)
+        return 0;
+    if (numThreads < 1)
+        numThreads = 1;
+    GABinLookup binLookup;
+    GA_bin_lookup_init(&binLookup, lookup, clamp);
+    /* The rows of tiles are distributed among the threads. No memory is 
+       allocated and no messages are sent within the parallel region, so 
+       errors are reported for the first failing element afterwards. */
+    int failed = 0;
+    int i0;
+#pragma omp parallel for num_threads(numThreads) schedule(dynamic, 1) \
+    reduction(||:failed)
+    for (i0 = 0; i0 < view->rows; i0 += GA_MATRIX_TILE_SIZE)
+    {
+        int iEnd = i0 + GA_MATRIX_TILE_SIZE;
+        if (iEnd > view->rows)
+            iEnd = view->rows;
+        int j0;
+        for (j0 = 0; j0 < view->cols; j0 += GA_MATRIX_TILE_SIZE)
+        {
+            int jEnd = j0 + GA_MATRIX_TILE_SIZE;
+            if (jEnd > view->cols)
+                jEnd = view->cols;
+            int i;
+            int j;
+            for (j = j0; j < jEnd; j++)
+                for (i = i0; i < iEnd; i++)
+                {
+                    int bin = GA_bin_lookup_get(&binLookup, view->data[
+                        (size_t)i * view->rowStride 
+                        + (size_t)j * view->colStride]);
+                    if (bin == -1)
+                    {
+                        failed = 1;
+                        bin = 0;
+                    }
+                    GA_MATRIX_BIN_SET(result, i, j, bin);
+                }
+        }
+    }
+    if (failed)
+    {
+        /* Find the first failing element again, since the bin matrix 
+           cannot store the error. */
+        int i;
+        int j;
+        for (i = 0; i < view->rows; i++)
+            for (j = 0; j < view->cols; j++)
+            {
+                double x = view->data[(size_t)i * view->rowStride 
+                    + (size_t)j * view->colStride];
+                if (GA_bin_lookup_get(&binLookup, x) == -1)
+                {
+                    GA_bin_number_error(x, lookup);
+                    GA_matrix_destroy_bin(result);
+                    return 0;
+                }
+            }
+    }
+    return result;
+}
+
+GAMatrixFloat* GA_matrix_create_float(int rows, int cols)
+{
+    GAMatrixFloat* matrix = (GAMatrixFloat*)GA_alloc(1, 
+        sizeof(GAMatrixFloat));
+    if (matrix == 0)
+    {
+        GA_msg()("[GA_matrix_create_float] "
+            "Could not allocate matrix.", GA_MSG_ERROR);
+        return 0;
+    }
+    matrix->rows = rows;
+    matrix->cols = cols;
+    matrix->refs = 1;
+    int eltsPerLine = GA_MATRIX_ALIGNMENT / sizeof(float);
+    matrix->stride = ((cols + eltsPerLine - 1) / eltsPerLine) * eltsPerLine;
+    matrix->block = GA_alloc((size_t)rows * matrix->stride * sizeof(float) 
+        + GA_MATRIX_ALIGNMENT, 1);
+    if (matrix->block == 0)
+    {
+        GA_msg()("[GA_matrix_create_float] "
+            "Could not allocate matrix elements.", GA_MSG_ERROR);
+        GA_free((char*)matrix);
+        return 0;
+    }
+    matrix->data = (float*)(((uintptr_t)matrix->block 
+        + GA_MATRIX_ALIGNMENT - 1) & ~((uintptr_t)GA_MATRIX_ALIGNMENT - 1));
+    matrix->elts = (float**)GA_alloc(rows > 0 ? rows : 1, sizeof(float*));
+    if (matrix->elts == 0)
+    {
+        GA_msg()("[GA_matrix_create_float] "
+            "Could not allocate matrix rows.", GA_MSG_ERROR);
+        GA_free(matrix->block);
+        GA_free((char*)matrix);
+        return 0;
+    }
+    int i;
+    for (i = 0; i < matrix->rows; i++)
+        matrix->elts[i] = matrix->data + (size_t)i * matrix->stride;
+    return matrix;
+}
+
+GAMatrixFloat* GA_matrix_ref_float(GAMatrixFloat* matrix)
+{
+    matrix->refs++;
+    return matrix;
+}
+
+void GA_matrix_destroy_float(GAMatrixFloat* matrix)
+{
+    matrix->refs--;
+    if (matrix->refs == 0)
+    {
+        GA_free((char*)matrix->elts);
+        GA_free(matrix->block);
+        matrix->elts = 0;
+        matrix->data = 0;
+        matrix->block = 0;
+        GA_free((char*)matrix);
+    }
+}
+
+GAMatrixFloat* GA_matrix_init_zero_float(GAMatrixFloat* matrix)
+{
+    /* The padding is cleared as well, since all bits zero is zero. */
+    memset(matrix->data, 0, (size_t)matrix->rows * matrix->stride 
+        * sizeof(float));
+    return matrix;
+}
+
+GAMatrixFloat* GA_matrix_to_float_real(GAMatrixReal* matrix)
+{
+    GAMatrixFloat* result = GA_matrix_create_float(matrix->rows, 
+        matrix->cols);
+    if (result == 0)
+        return 0;
+    int i;
+    int j;
+    for (i = 0; i < matrix->rows; i++)
+        for (j = 0; j < matrix->cols; j++)
+            result->elts[i][j] = (float)matrix->elts[i][j];
+    return result;
+}
+
+GAMatrixReal* GA_matrix_to_real_float(GAMatrixFloat* matrix)
+{
+    GAMatrixReal* result = GA_matrix_create_real(matrix->rows, 
+        matrix->cols);
+    if (result == 0)
+        return 0;
+    int i;
+    int j;
+    for (i = 0; i < matrix->rows; i++)
+        for (j = 0; j < matrix->cols; j++)
+            result->elts[i][j] = matrix->elts[i][j];
+    return result;
+}
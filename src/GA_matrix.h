@@ -37,8 +37,17 @@
  * variables are required.
  */
 
+#include <stdint.h>
 #include "GA_vector.h"
 
+/** Matrix alignment.
+ *
+ * Alignment of the element storage of matrices in bytes. Each row starts at 
+ * a multiple of this alignment, which is the cache line size and the width 
+ * of the largest SIMD registers.
+ */
+#define GA_MATRIX_ALIGNMENT 64
+
 #ifdef __cplusplus
 extern "C"
 {
@@ -63,12 +72,29 @@ extern "C"
  * the matrix is stored in the \c rows and \c cols members of the type. It is 
  * also possible to do a checked access using GA_matrix_get_elt_int(). If this 
  * function is used, an error message will be sent if an index is out of range.
+ *
+ * The elements are stored in a single contiguous block in row-major order, 
+ * with each row starting at a multiple of #GA_MATRIX_ALIGNMENT bytes. The 
+ * element with index (i, j) is also
+ *
+ * <tt>m->data[i * m->stride + j]</tt>
+ *
+ * and \c elts is a view of the row start addresses within the block.
  */
 struct GAMatrixInt_Impl
 {
-    /** Elements of the matrix.
+    /** Elements of the matrix (row view).
      */
     int** elts;
+    /** Elements of the matrix (contiguous, aligned).
+     */
+    int* data;
+    /** Distance between the starts of two rows, in elements.
+     */
+    int stride;
+    /** Memory block holding the elements.
+     */
+    char* block;
     /** Number of rows.
      */
     int rows;
@@ -226,12 +252,29 @@ GAMatrixInt* GA_matrix_print_int(GAMatrixInt* matrix);
  * the matrix is stored in the \c rows and \c cols members of the type. It is 
  * also possible to do a checked access using GA_matrix_get_elt_real(). If this 
  * function is used, an error message will be sent if an index is out of range.
+ *
+ * The elements are stored in a single contiguous block in row-major order, 
+ * with each row starting at a multiple of #GA_MATRIX_ALIGNMENT bytes. The 
+ * element with index (i, j) is also
+ *
+ * <tt>m->data[i * m->stride + j]</tt>
+ *
+ * and \c elts is a view of the row start addresses within the block.
  */
 struct GAMatrixReal_Impl
 {
-    /** Elements of the matrix.
+    /** Elements of the matrix (row view).
      */
     double** elts;
+    /** Elements of the matrix (contiguous, aligned).
+     */
+    double* data;
+    /** Distance between the starts of two rows, in elements.
+     */
+    int stride;
+    /** Memory block holding the elements.
+     */
+    char* block;
     /** Number of rows.
      */
     int rows;
@@ -374,7 +417,7 @@ GAMatrixReal* GA_matrix_init_unit_real(GAMatrixReal* matrix);
  *
  * \return Matrix of bin numbers
  *
- * \sa GA_get_bin_number()
+ * \sa GA_bin_lookup_get()
  */
 GAMatrixInt* GA_matrix_to_bin_real(GAMatrixReal* matrix, GAVectorReal* lookup, 
     GAClampMode clamp);
@@ -389,6 +432,390 @@ GAMatrixInt* GA_matrix_to_bin_real(GAMatrixReal* matrix, GAVectorReal* lookup,
  */
 GAMatrixReal* GA_matrix_print_real(GAMatrixReal* matrix);
 
+/** A strided view of a matrix of real numbers (implementation).
+ *
+ * This type provides read access to the elements of a two-dimensional matrix 
+ * of real numbers which are stored in memory owned by someone else, for 
+ * example an R object. The element with index (i, j) is
+ *
+ * <tt>v->data[i * v->rowStride + j * v->colStride]</tt>
+ *
+ * so both row-major (\c colStride = 1) and column-major (\c rowStride = 1) 
+ * storage can be viewed without copying the elements. The memory must stay 
+ * valid as long as the view is used. To create a new view, use 
+ * GA_matrix_view_create_real() or GA_matrix_view_of_real(). To reference a 
+ * view, use GA_matrix_view_ref_real(). To release a reference to a view, use 
+ * GA_matrix_view_destroy_real().
+ */
+struct GAMatrixViewReal_Impl
+{
+    /** Elements of the matrix.
+     */
+    const double* data;
+    /** Number of rows.
+     */
+    int rows;
+    /** Number of columns.
+     */
+    int cols;
+    /** Distance between two consecutive rows, in elements.
+     */
+    int rowStride;
+    /** Distance between two consecutive columns, in elements.
+     */
+    int colStride;
+    /** Reference count.
+     */
+    int refs;
+};
+
+/** A strided view of a matrix of real numbers.
+ */
+typedef struct GAMatrixViewReal_Impl GAMatrixViewReal;
+
+/** Create matrix view (real).
+ *
+ * Create a view of a matrix of real numbers stored at the specified memory 
+ * location. The new view will be referenced and should be destroyed by 
+ * using GA_matrix_view_destroy_real() when it is not needed anymore. This 
+ * does not free the viewed memory.
+ *
+ * \param data Elements of the matrix.
+ * \param rows Number of rows.
+ * \param cols Number of columns.
+ * \param rowStride Distance between two consecutive rows, in elements.
+ * \param colStride Distance between two consecutive columns, in elements.
+ *
+ * \return Pointer to a matrix view, or 0 if an error occurs.
+ *
+ * \sa GA_matrix_view_destroy_real
+ */
+GAMatrixViewReal* GA_matrix_view_create_real(const double* data, int rows, 
+    int cols, int rowStride, int colStride);
+
+/** Create view of matrix (real).
+ *
+ * Create a view of the elements of a matrix of real numbers. The matrix 
+ * must not be destroyed as long as the view is used.
+ *
+ * \param matrix Matrix.
+ *
+ * \return Pointer to a matrix view, or 0 if an error occurs.
+ */
+GAMatrixViewReal* GA_matrix_view_of_real(GAMatrixReal* matrix);
+
+/** Add reference.
+ *
+ * Add a reference for a matrix view. The user of this function is 
+ * responsible for removing the reference using GA_matrix_view_destroy_real().
+ *
+ * \param view Matrix view.
+ *
+ * \return The matrix view.
+ *
+ * \sa GA_matrix_view_destroy_real
+ */
+GAMatrixViewReal* GA_matrix_view_ref_real(GAMatrixViewReal* view);
+
+/** Destroy matrix view.
+ *
+ * Remove a reference from a matrix view. If the reference count drops to 
+ * zero, the view will be destroyed. The viewed memory is not freed.
+ *
+ * \param view Matrix view.
+ */
+void GA_matrix_view_destroy_real(GAMatrixViewReal* view);
+
+/** Initialize matrix from view (real).
+ *
+ * Copy the elements of the matrix referenced by a view to a matrix of real 
+ * numbers with the same dimensions. The elements are processed in square 
+ * tiles (see GA_matrix_view_to_bin_real()). No memory is allocated, so 
+ * this function can be used in parallel threads.
+ *
+ * \param matrix Matrix.
+ * \param view Matrix view.
+ *
+ * \return The matrix.
+ */
+GAMatrixReal* GA_matrix_init_from_view_real(GAMatrixReal* matrix, 
+    GAMatrixViewReal* view);
+
+/** Initialize matrix from view (int).
+ *
+ * Copy the elements of the matrix referenced by a view to a matrix of 
+ * integers with the same dimensions, truncating them towards zero (see 
+ * GA_matrix_init_from_view_real()).
+ *
+ * \param matrix Matrix.
+ * \param view Matrix view.
+ *
+ * \return The matrix.
+ */
+GAMatrixInt* GA_matrix_init_from_view_int(GAMatrixInt* matrix, 
+    GAMatrixViewReal* view);
+
+/** A matrix of bin numbers (implementation).
+ *
+ * This type holds the elements of a two-dimensional matrix of bin numbers 
+ * in the smallest of 8-bit, 16-bit or 32-bit storage which can hold all 
+ * bins of the lookup vector the matrix was created for. Compared to a 
+ * matrix of integers (see GAMatrixInt), this reduces the memory used by 
+ * the binned networks, and the memory bandwidth needed by the kernels 
+ * which read them, by up to a factor of four. To create a new matrix, use 
+ * GA_matrix_create_bin() or GA_matrix_view_to_bin_real(). To reference a 
+ * matrix, use GA_matrix_ref_bin(). To release a reference to a matrix, use 
+ * GA_matrix_destroy_bin().
+ *
+ * The elements are stored in a single contiguous block in row-major order, 
+ * with each row starting at a multiple of #GA_MATRIX_ALIGNMENT bytes. An 
+ * element can be read with #GA_MATRIX_BIN_ELT and written with 
+ * #GA_MATRIX_BIN_SET. Kernels which read many elements should cast the 
+ * rows obtained from #GA_MATRIX_BIN_ROW to the element type selected by 
+ * \c eltSize instead.
+ */
+struct GAMatrixBin_Impl
+{
+    /** Elements of the matrix (contiguous, aligned).
+     */
+    char* data;
+    /** Distance between the starts of two rows, in bytes.
+     */
+    int stride;
+    /** Size of an element, in bytes (1, 2 or 4).
+     */
+    int eltSize;
+    /** Memory block holding the elements.
+     */
+    char* block;
+    /** Number of rows.
+     */
+    int rows;
+    /** Number of columns.
+     */
+    int cols;
+    /** Reference count.
+     */
+    int refs;
+};
+
+/** A matrix of bin numbers.
+ */
+typedef struct GAMatrixBin_Impl GAMatrixBin;
+
+/** Get row of bin matrix.
+ *
+ * Get the address of the first element of a row of a bin matrix.
+ */
+#define GA_MATRIX_BIN_ROW(matrix, row) \
+    ((matrix)->data + (size_t)(row) * (matrix)->stride)
+
+/** Get element of bin matrix.
+ *
+ * Get the element with index (row, col) of a bin matrix as an int.
+ */
+#define GA_MATRIX_BIN_ELT(matrix, row, col) \
+    (((matrix)->eltSize == 1) \
+        ? (int)((uint8_t*)GA_MATRIX_BIN_ROW(matrix, row))[col] \
+        : (((matrix)->eltSize == 2) \
+            ? (int)((uint16_t*)GA_MATRIX_BIN_ROW(matrix, row))[col] \
+            : ((int*)GA_MATRIX_BIN_ROW(matrix, row))[col]))
+
+/** Set element of bin matrix.
+ *
+ * Set the element with index (row, col) of a bin matrix. The value must be 
+ * a bin number which fits into the elements of the matrix.
+ */
+#define GA_MATRIX_BIN_SET(matrix, row, col, value) \
+    do { \
+        if ((matrix)->eltSize == 1) \
+            ((uint8_t*)GA_MATRIX_BIN_ROW(matrix, row))[col] = \
+                (uint8_t)(value); \
+        else \
+        if ((matrix)->eltSize == 2) \
+            ((uint16_t*)GA_MATRIX_BIN_ROW(matrix, row))[col] = \
+                (uint16_t)(value); \
+        else \
+            ((int*)GA_MATRIX_BIN_ROW(matrix, row))[col] = (value); \
+    } while (0)
+
+/** Create matrix (bin).
+ *
+ * Create a matrix of bin numbers which can hold the bin numbers 0 to 
+ * <tt>numBins - 1</tt>. The element size is chosen so that the largest 
+ * value of the element type is not a bin number, which leaves it free for 
+ * kernels to mark terms which do not contribute (see 
+ * GA_link_sum_scalar()). The new matrix will be referenced and should be 
+ * destroyed by using GA_matrix_destroy_bin() when it is not needed 
+ * anymore.
+ *
+ * \param rows Number of rows.
+ * \param cols Number of columns.
+ * \param numBins Number of bins.
+ *
+ * \return Pointer to a matrix, or 0 if an error occurs.
+ *
+ * \sa GA_matrix_destroy_bin
+ */
+GAMatrixBin* GA_matrix_create_bin(int rows, int cols, int numBins);
+
+/** Reference matrix (bin).
+ *
+ * Add a reference for a matrix. The user of this function is responsible 
+ * for removing the reference using GA_matrix_destroy_bin().
+ *
+ * \param matrix Matrix.
+ *
+ * \return The matrix.
+ *
+ * \sa GA_matrix_destroy_bin
+ */
+GAMatrixBin* GA_matrix_ref_bin(GAMatrixBin* matrix);
+
+/** Destroy matrix (bin).
+ *
+ * Remove a reference from a matrix. If the reference count drops to zero, 
+ * the matrix will be destroyed.
+ *
+ * \param matrix Matrix.
+ */
+void GA_matrix_destroy_bin(GAMatrixBin* matrix);
+
+/** Convert to bin matrix (view).
+ *
+ * Convert the matrix of real numbers referenced by a view to a matrix of 
+ * bin numbers according to the specified lookup vector (see 
+ * GA_matrix_to_bin_real()). The element size of the result is chosen for 
+ * the number of bins of the lookup vector. The elements are processed in 
+ * square tiles, so that both column-major and row-major views are read 
+ * with good locality. The rows of tiles are distributed among the 
+ * specified number of threads. The new matrix will be referenced and 
+ * should be destroyed by using GA_matrix_destroy_bin() when it is not 
+ * needed anymore.
+ *
+ * \param view Matrix view.
+ * \param lookup Lookup vector.
+ * \param clamp clamp values to the lookup range
+ * \param numThreads Number of threads.
+ *
+ * \return Matrix of bin numbers, or 0 if an error occurs.
+ *
+ * \sa GA_bin_lookup_get()
+ */
+GAMatrixBin* GA_matrix_view_to_bin_real(GAMatrixViewReal* view, 
+    GAVectorReal* lookup, GAClampMode clamp, int numThreads);
+
+/** A matrix of single precision numbers (implementation).
+ *
+ * This type holds the elements of a two-dimensional matrix of real numbers 
+ * in single precision. It is used for score matrices which are only 
+ * compared with each other, where it halves the memory and the memory 
+ * bandwidth compared to a matrix of real numbers (see GAMatrixReal). The 
+ * elements are stored and accessed in the same way as for GAMatrixReal. 
+ * To create a new matrix, use GA_matrix_create_float() or 
+ * GA_matrix_to_float_real(). To reference a matrix, use 
+ * GA_matrix_ref_float(). To release a reference to a matrix, use 
+ * GA_matrix_destroy_float().
+ */
+struct GAMatrixFloat_Impl
+{
+    /** Elements of the matrix (row view).
+     */
+    float** elts;
+    /** Elements of the matrix (contiguous, aligned).
+     */
+    float* data;
+    /** Distance between the starts of two rows, in elements.
+     */
+    int stride;
+    /** Memory block holding the elements.
+     */
+    char* block;
+    /** Number of rows.
+     */
+    int rows;
+    /** Number of columns.
+     */
+    int cols;
+    /** Reference count.
+     */
+    int refs;
+};
+
+/** A matrix of single precision numbers.
+ */
+typedef struct GAMatrixFloat_Impl GAMatrixFloat;
+
+/** Create matrix (float).
+ *
+ * Create a matrix of single precision numbers. The new matrix will be 
+ * referenced and should be destroyed by using GA_matrix_destroy_float() 
+ * when it is not needed anymore.
+ *
+ * \param rows Number of rows.
+ * \param cols Number of columns.
+ *
+ * \return Pointer to a matrix, or 0 if an error occurs.
+ *
+ * \sa GA_matrix_destroy_float
+ */
+GAMatrixFloat* GA_matrix_create_float(int rows, int cols);
+
+/** Reference matrix (float).
+ *
+ * Add a reference for a matrix. The user of this function is responsible 
+ * for removing the reference using GA_matrix_destroy_float().
+ *
+ * \param matrix Matrix.
+ *
+ * \return The matrix.
+ *
+ * \sa GA_matrix_destroy_float
+ */
+GAMatrixFloat* GA_matrix_ref_float(GAMatrixFloat* matrix);
+
+/** Destroy matrix (float).
+ *
+ * Remove a reference from a matrix. If the reference count drops to zero, 
+ * the matrix will be destroyed.
+ *
+ * \param matrix Matrix.
+ */
+void GA_matrix_destroy_float(GAMatrixFloat* matrix);
+
+/** Initialize matrix with zero elements (float).
+ *
+ * \param matrix Matrix.
+ *
+ * \return The matrix.
+ */
+GAMatrixFloat* GA_matrix_init_zero_float(GAMatrixFloat* matrix);
+
+/** Convert to single precision matrix (real).
+ *
+ * Create a matrix of single precision numbers from a matrix of real 
+ * numbers, rounding each element to the nearest single precision number. 
+ * The new matrix will be referenced and should be destroyed by using 
+ * GA_matrix_destroy_float() when it is not needed anymore.
+ *
+ * \param matrix Matrix.
+ *
+ * \return Pointer to a matrix, or 0 if an error occurs.
+ */
+GAMatrixFloat* GA_matrix_to_float_real(GAMatrixReal* matrix);
+
+/** Convert to real matrix (float).
+ *
+ * Create a matrix of real numbers from a matrix of single precision 
+ * numbers. The new matrix will be referenced and should be destroyed by 
+ * using GA_matrix_destroy_real() when it is not needed anymore.
+ *
+ * \param matrix Matrix.
+ *
+ * \return Pointer to a matrix, or 0 if an error occurs.
+ */
+GAMatrixReal* GA_matrix_to_real_float(GAMatrixFloat* matrix);
+
 #ifdef __cplusplus
 }
 #endif
@@ -33,6 +33,29 @@
 #include "GA_message.h"
 #include "GA_matrix_R.h"
 
+/** Tile size for transposing conversions.
+ *
+ * R stores matrices in column-major order, while the matrix types use 
+ * row-major order. Conversions are done in square tiles, so that the reads 
+ * and the writes both stay within a few cache lines.
+ */
+#define GA_MATRIX_R_TILE_SIZE 32
+
+/** Loop over the elements of a matrix in tiles.
+ *
+ * Loop over all elements (i, j) of a matrix with the specified number of 
+ * rows and columns, in square tiles of GA_MATRIX_R_TILE_SIZE elements.
+ */
+#define GA_MATRIX_R_FOR_TILES(rows, cols, i, j) \
+    int i##0; \
+    int j##0; \
+    for (i##0 = 0; i##0 < (rows); i##0 += GA_MATRIX_R_TILE_SIZE) \
+        for (j##0 = 0; j##0 < (cols); j##0 += GA_MATRIX_R_TILE_SIZE) \
+            for (j = j##0; (j < (cols)) \
+                && (j < j##0 + GA_MATRIX_R_TILE_SIZE); j++) \
+                for (i = i##0; (i < (rows)) \
+                    && (i < i##0 + GA_MATRIX_R_TILE_SIZE); i++)
+
 GAMatrixInt* GA_matrix_from_R_int(SEXP robj)
 {
     PROTECT(robj);
@@ -64,12 +87,45 @@ GAMatrixInt* GA_matrix_from_R_int(SEXP robj)
         UNPROTECT(1);
         return 0;
     }
+    GAMatrixInt* result = GA_matrix_init_from_R_int(matrix, robj);
+    UNPROTECT(1);
+    return result;
+}
+
+GAMatrixInt* GA_matrix_init_from_R_int(GAMatrixInt* matrix, SEXP robj)
+{
+    PROTECT(robj);
+    SEXPTYPE matrixType = TYPEOF(robj);
+    SEXP dim = GET_DIM(robj);
+    if (((matrixType != INTSXP)
+            && (matrixType != REALSXP))
+        || (LENGTH(dim) != 2))
+    {
+        GA_msg()("[GA_matrix_init_from_R_int] Input is not a "
+            "two-dimensional matrix of real or integer values.", 
+            GA_MSG_ERROR);
+        UNPROTECT(1);
+        return 0;
+    }
+    int* dims = INTEGER(coerceVector(dim, INTSXP));
+    if ((dims[0] != matrix->rows)
+        || (dims[1] != matrix->cols))
+    {
+        char* message = GA_alloc(256, sizeof(char));
+        snprintf(message, 256, 
+            "[GA_matrix_init_from_R_int] Input has wrong dimensions "
+            "(%i, %i) (expected (%i, %i)).", dims[0], dims[1], 
+            matrix->rows, matrix->cols);
+        GA_msg()(message, GA_MSG_ERROR);
+        GA_free(message);
+        UNPROTECT(1);
+        return 0;
+    }
     int* inputRaw = INTEGER(coerceVector(robj, INTSXP));
     int i;
     int j;
-    for (i = 0; i < dims[0]; i++)
-        for (j = 0; j < dims[1]; j++)
-            matrix->elts[i][j] = inputRaw[j * dims[0] + i];
+    GA_MATRIX_R_FOR_TILES(dims[0], dims[1], i, j)
+        matrix->elts[i][j] = inputRaw[(size_t)j * dims[0] + i];
     UNPROTECT(1);
     return matrix;
 }
@@ -78,12 +134,25 @@ SEXP GA_matrix_to_R_int(GAMatrixInt* matrix)
 {
     SEXP result;
     PROTECT(result = allocMatrix(INTSXP, matrix->rows, matrix->cols));
-    int* resultRaw = INTEGER(coerceVector(result, INTSXP));
+    int* resultRaw = INTEGER(result);
     int i;
     int j;
-    for (i = 0; i < matrix->rows; i++)
-        for (j = 0; j < matrix->cols; j++)
-            resultRaw[j * matrix->rows + i] = matrix->elts[i][j];
+    GA_MATRIX_R_FOR_TILES(matrix->rows, matrix->cols, i, j)
+        resultRaw[(size_t)j * matrix->rows + i] = matrix->elts[i][j];
+    UNPROTECT(1);
+    return result;
+}
+
+SEXP GA_matrix_to_R_bin(GAMatrixBin* matrix)
+{
+    SEXP result;
+    PROTECT(result = allocMatrix(INTSXP, matrix->rows, matrix->cols));
+    int* resultRaw = INTEGER(result);
+    int i;
+    int j;
+    GA_MATRIX_R_FOR_TILES(matrix->rows, matrix->cols, i, j)
+        resultRaw[(size_t)j * matrix->rows + i] = GA_MATRIX_BIN_ELT(matrix, 
+            i, j);
     UNPROTECT(1);
     return result;
 }
@@ -119,12 +188,45 @@ GAMatrixReal* GA_matrix_from_R_real(SEXP robj)
         UNPROTECT(1);
         return 0;
     }
+    GAMatrixReal* result = GA_matrix_init_from_R_real(matrix, robj);
+    UNPROTECT(1);
+    return result;
+}
+
+GAMatrixReal* GA_matrix_init_from_R_real(GAMatrixReal* matrix, SEXP robj)
+{
+    PROTECT(robj);
+    SEXPTYPE matrixType = TYPEOF(robj);
+    SEXP dim = GET_DIM(robj);
+    if (((matrixType != INTSXP)
+            && (matrixType != REALSXP))
+        || (LENGTH(dim) != 2))
+    {
+        GA_msg()("[GA_matrix_init_from_R_real] Input is not a "
+            "two-dimensional matrix of real or integer values.", 
+            GA_MSG_ERROR);
+        UNPROTECT(1);
+        return 0;
+    }
+    int* dims = INTEGER(coerceVector(dim, INTSXP));
+    if ((dims[0] != matrix->rows)
+        || (dims[1] != matrix->cols))
+    {
+        char* message = GA_alloc(256, sizeof(char));
+        snprintf(message, 256, 
+            "[GA_matrix_init_from_R_real] Input has wrong dimensions "
+            "(%i, %i) (expected (%i, %i)).", dims[0], dims[1], 
+            matrix->rows, matrix->cols);
+        GA_msg()(message, GA_MSG_ERROR);
+        GA_free(message);
+        UNPROTECT(1);
+        return 0;
+    }
     double* inputRaw = REAL(coerceVector(robj, REALSXP));
     int i;
     int j;
-    for (i = 0; i < dims[0]; i++)
-        for (j = 0; j < dims[1]; j++)
-            matrix->elts[i][j] = inputRaw[j * dims[0] + i];
+    GA_MATRIX_R_FOR_TILES(dims[0], dims[1], i, j)
+        matrix->elts[i][j] = inputRaw[(size_t)j * dims[0] + i];
     UNPROTECT(1);
     return matrix;
 }
@@ -133,12 +235,50 @@ SEXP GA_matrix_to_R_real(GAMatrixReal* matrix)
 {
     SEXP result;
     PROTECT(result = allocMatrix(REALSXP, matrix->rows, matrix->cols));
-    double* resultRaw = REAL(coerceVector(result, REALSXP));
+    double* resultRaw = REAL(result);
+    int i;
+    int j;
+    GA_MATRIX_R_FOR_TILES(matrix->rows, matrix->cols, i, j)
+        resultRaw[(size_t)j * matrix->rows + i] = matrix->elts[i][j];
+    UNPROTECT(1);
+    return result;
+}
+
+SEXP GA_matrix_to_R_float(GAMatrixFloat* matrix)
+{
+    SEXP result;
+    PROTECT(result = allocMatrix(REALSXP, matrix->rows, matrix->cols));
+    double* resultRaw = REAL(result);
     int i;
     int j;
-    for (i = 0; i < matrix->rows; i++)
-        for (j = 0; j < matrix->cols; j++)
-            resultRaw[j * matrix->rows + i] = matrix->elts[i][j];
+    GA_MATRIX_R_FOR_TILES(matrix->rows, matrix->cols, i, j)
+        resultRaw[(size_t)j * matrix->rows + i] = matrix->elts[i][j];
     UNPROTECT(1);
     return result;
 }
+
+GAMatrixViewReal* GA_matrix_view_from_R_real(SEXP robj)
+{
+    if (TYPEOF(robj) != REALSXP)
+    {
+        char* message = GA_alloc(256, sizeof(char));
+        snprintf(message, 256, 
+            "[GA_matrix_view_from_R_real] Input is not a matrix of real "
+            "values (actual type: %i).", TYPEOF(robj));
+        GA_msg()(message, GA_MSG_ERROR);
+        GA_free(message);
+        return 0;
+    }
+    SEXP dim = GET_DIM(robj);
+    if (LENGTH(dim) != 2)
+    {
+        GA_msg()("[GA_matrix_view_from_R_real] Input is not a "
+            "two-dimensional matrix.", GA_MSG_ERROR);
+        return 0;
+    }
+    /* The dimensions of R objects are always stored as integers. */
+    int* dims = INTEGER(dim);
+    /* R matrices are stored in column-major order. */
+    return GA_matrix_view_create_real(REAL(robj), dims[0], dims[1], 1, 
+        dims[0]);
+}
@@ -59,6 +59,19 @@ extern "C"
  */
 GAMatrixInt* GA_matrix_from_R_int(SEXP robj);
 
+/** Initialize matrix from R object (int).
+ *
+ * Initialize an existing matrix of integers with the elements of an R 
+ * object, which must have the same dimensions as the matrix. This can be 
+ * used to fill a buffer which is reused across calls.
+ *
+ * \param matrix Matrix.
+ * \param robj R object.
+ *
+ * \return The matrix, or 0 if an error occurs.
+ */
+GAMatrixInt* GA_matrix_init_from_R_int(GAMatrixInt* matrix, SEXP robj);
+
 /** Create R object from matrix (int).
  *
  * Create an R object from a matrix of integers.
@@ -69,6 +82,16 @@ GAMatrixInt* GA_matrix_from_R_int(SEXP robj);
  */
 SEXP GA_matrix_to_R_int(GAMatrixInt* matrix);
 
+/** Create R object from matrix (bin).
+ *
+ * Create an R matrix of integers from a matrix of bin numbers.
+ *
+ * \param matrix Matrix.
+ *
+ * \return R object.
+ */
+SEXP GA_matrix_to_R_bin(GAMatrixBin* matrix);
+
 /** Create matrix from R object (real).
  *
  * Create a matrix of real numbers from an R object. The new matrix will be 
@@ -83,6 +106,19 @@ SEXP GA_matrix_to_R_int(GAMatrixInt* matrix);
  */
 GAMatrixReal* GA_matrix_from_R_real(SEXP robj);
 
+/** Initialize matrix from R object (real).
+ *
+ * Initialize an existing matrix of real numbers with the elements of an R 
+ * object, which must have the same dimensions as the matrix (see 
+ * GA_matrix_init_from_R_int()).
+ *
+ * \param matrix Matrix.
+ * \param robj R object.
+ *
+ * \return The matrix, or 0 if an error occurs.
+ */
+GAMatrixReal* GA_matrix_init_from_R_real(GAMatrixReal* matrix, SEXP robj);
+
 /** Create R object from matrix (real).
  *
  * Create an R object from a matrix of real numbers.
@@ -93,6 +129,34 @@ GAMatrixReal* GA_matrix_from_R_real(SEXP robj);
  */
 SEXP GA_matrix_to_R_real(GAMatrixReal* matrix);
 
+/** Create R object from matrix (float).
+ *
+ * Create an R matrix of real numbers from a matrix of single precision 
+ * numbers.
+ *
+ * \param matrix Matrix.
+ *
+ * \return R object.
+ */
+SEXP GA_matrix_to_R_float(GAMatrixFloat* matrix);
+
+/** Create matrix view from R object (real).
+ *
+ * Create a view of the elements of an R matrix of real numbers, without 
+ * copying them. The R object must be of type \c REALSXP, since converting 
+ * it would copy the elements, and must stay protected as long as the view 
+ * is used. The new view will be referenced and should be 
+ * destroyed by using GA_matrix_view_destroy_real() when it is not needed 
+ * anymore.
+ *
+ * \param robj R object.
+ *
+ * \return Pointer to a matrix view, or 0 if an error occurs.
+ *
+ * \sa GA_matrix_view_destroy_real
+ */
+GAMatrixViewReal* GA_matrix_view_from_R_real(SEXP robj);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,433 @@
+/* ----------------------------------------------------------------------------
+ * R package for graph alignment
+ * ----------------------------------------------------------------------------
+ *
+ * Author: Joern P. Meier <mail@ionflux.org>
+ * 
+ * The package can be used freely for non-commercial purposes. If you use this 
+ * package, the appropriate paper to cite is J. Berg and M. Laessig, 
+ * "Cross-species analysis of biological networks by Bayesian alignment", 
+ * PNAS 103 (29), 10967-10972 (2006)
+ * 
+ * This software is made available in the hope that it will be useful, but 
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY 
+ * or FITNESS FOR A PARTICULAR PURPOSE.
+ * 
+ * This software contains code for solving linear assignment problems which was 
+ * written by Roy Jonker, MagicLogic Optimization Inc.. Please note that this 
+ * code is copyrighted, (c) 2003 MagicLogic Systems Inc., Canada and may be 
+ * used for non-commercial purposes only. See 
+ * http://www.magiclogic.com/assignment.html for the latest version of the LAP 
+ * code and details on licensing.
+ *
+ * ----------------------------------------------------------------------------
+ * Sparse matrix types.
+ * ----------------------------------------------------------------------------
+ */
+
+/** \file GA_sparse.c
+ * \brief Sparse matrix types (implementation).
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include "GA_alloc.h"
+#include "GA_message.h"
+#include "GA_sparse.h"
+
+GASparseMatrixInt* GA_sparse_create_int(int rows, int cols, int numElts, 
+    int defaultElt)
+{
+    GASparseMatrixInt* matrix = (GASparseMatrixInt*)GA_alloc(1, 
+        sizeof(GASparseMatrixInt));
+    if (matrix == 0)
+    {
+        GA_msg()("[GA_sparse_create_int] "
+            "Could not allocate sparse matrix.", GA_MSG_ERROR);
+        return 0;
+    }
+    matrix->rows = rows;
+    matrix->cols = cols;
+    matrix->numElts = numElts;
+    matrix->defaultElt = defaultElt;
+    matrix->refs = 1;
+    matrix->rowStart = (int*)GA_alloc(rows + 1, sizeof(int));
+    /* Allocate at least one element, so that empty matrices are valid. */
+    matrix->colIndex = (int*)GA_alloc(numElts > 0 ? numElts : 1, 
+        sizeof(int));
+    matrix->elts = (int*)GA_alloc(numElts > 0 ? numElts : 1, sizeof(int));
+    if ((matrix->rowStart == 0)
+        || (matrix->colIndex == 0)
+        || (matrix->elts == 0))
+    {
+        GA_msg()("[GA_sparse_create_int] "
+            "Could not allocate sparse matrix elements.", GA_MSG_ERROR);
+        if (matrix->rowStart != 0)
+            GA_free((char*)matrix->rowStart);
+        if (matrix->colIndex != 0)
+            GA_free((char*)matrix->colIndex);
+        if (matrix->elts != 0)
+            GA_free((char*)matrix->elts);
+        GA_free((char*)matrix);
+        return 0;
+    }
+    int i;
+    for (i = 0; i <= rows; i++)
+        matrix->rowStart[i] = 0;
+    return matrix;
+}
+
+GASparseMatrixInt* GA_sparse_ref_int(GASparseMatrixInt* matrix)
+{
+    matrix->refs++;
+    return matrix;
+}
+
+void GA_sparse_destroy_int(GASparseMatrixInt* matrix)
+{
+    matrix->refs--;
+    if (matrix->refs == 0)
+    {
+        GA_free((char*)matrix->rowStart);
+        GA_free((char*)matrix->colIndex);
+        GA_free((char*)matrix->elts);
+        GA_free((char*)matrix);
+    }
+}
+
+GASparseMatrixInt* GA_sparse_from_matrix_bin(GAMatrixBin* matrix, 
+    int defaultElt)
+{
+    int numElts = 0;
+    int i;
+    int j;
+    for (i = 0; i < matrix->rows; i++)
+        for (j = 0; j < matrix->cols; j++)
+            if (GA_MATRIX_BIN_ELT(matrix, i, j) != defaultElt)
+                numElts++;
+    GASparseMatrixInt* result = GA_sparse_create_int(matrix->rows, 
+        matrix->cols, numElts, defaultElt);
+    if (result == 0)
+        return 0;
+    int k = 0;
+    for (i = 0; i < matrix->rows; i++)
+    {
+        result->rowStart[i] = k;
+        for (j = 0; j < matrix->cols; j++)
+        {
+            int x = GA_MATRIX_BIN_ELT(matrix, i, j);
+            if (x != defaultElt)
+            {
+                result->colIndex[k] = j;
+                result->elts[k] = x;
+                k++;
+            }
+        }
+    }
+    result->rowStart[matrix->rows] = k;
+    return result;
+}
+
+int GA_sparse_get_int(GASparseMatrixInt* matrix, int i, int j)
+{
+    int lower = matrix->rowStart[i];
+    int upper = matrix->rowStart[i + 1];
+    while (lower < upper)
+    {
+        int k = (lower + upper) / 2;
+        if (matrix->colIndex[k] < j)
+            lower = k + 1;
+        else
+            upper = k;
+    }
+    if ((lower < matrix->rowStart[i + 1])
+        && (matrix->colIndex[lower] == j))
+        return matrix->elts[lower];
+    return matrix->defaultElt;
+}
+
+GASparseMatrixReal* GA_sparse_create_real(int rows, int cols, int numElts, 
+    double defaultElt)
+{
+    GASparseMatrixReal* matrix = (GASparseMatrixReal*)GA_alloc(1, 
+        sizeof(GASparseMatrixReal));
+    if (matrix == 0)
+    {
+        GA_msg()("[GA_sparse_create_real] "
+            "Could not allocate sparse matrix.", GA_MSG_ERROR);
+        return 0;
+    }
+    matrix->rows = rows;
+    matrix->cols = cols;
+    matrix->numElts = numElts;
+    matrix->defaultElt = defaultElt;
+    matrix->refs = 1;
+    matrix->rowStart = (int*)GA_alloc(rows + 1, sizeof(int));
+    /* Allocate at least one element, so that empty matrices are valid. */
+    matrix->colIndex = (int*)GA_alloc(numElts > 0 ? numElts : 1, 
+        sizeof(int));
+    matrix->elts = (double*)GA_alloc(numElts > 0 ? numElts : 1, 
+        sizeof(double));
+    if ((matrix->rowStart == 0)
+        || (matrix->colIndex == 0)
+        || (matrix->elts == 0))
+    {
+        GA_msg()("[GA_sparse_create_real] "
+            "Could not allocate sparse matrix elements.", GA_MSG_ERROR);
+        if (matrix->rowStart != 0)
+            GA_free((char*)matrix->rowStart);
+        if (matrix->colIndex != 0)
+            GA_free((char*)matrix->colIndex);
+        if (matrix->elts != 0)
+            GA_free((char*)matrix->elts);
+        GA_free((char*)matrix);
+        return 0;
+    }
+    int i;
+    for (i = 0; i <= rows; i++)
+        matrix->rowStart[i] = 0;
+    return matrix;
+}
+
+GASparseMatrixReal* GA_sparse_ref_real(GASparseMatrixReal* matrix)
+{
+    matrix->refs++;
+    return matrix;
+}
+
+void GA_sparse_destroy_real(GASparseMatrixReal* matrix)
+{
+    matrix->refs--;
+    if (matrix->refs == 0)
+    {
+        GA_free((char*)matrix->rowStart);
+        GA_free((char*)matrix->colIndex);
+        GA_free((char*)matrix->elts);
+        GA_free((char*)matrix);
+    }
+}
+
+GASparseMatrixReal* GA_sparse_from_triplets_real(int rows, int cols, 
+    int numTriplets, int* rowIndex, int* colIndex, double* elts, 
+    double defaultElt)
+{
+    int k;
+    for (k = 0; k < numTriplets; k++)
+        if ((rowIndex[k] < 0)
+            || (rowIndex[k] >= rows)
+            || (colIndex[k] < 0)
+            || (colIndex[k] >= cols))
+        {
+            char* message = GA_alloc(256, sizeof(char));
+            snprintf(message, 256, "[GA_sparse_from_triplets_real] "
+                "Index (%i, %i) is outside of the matrix dimensions "
+                "(%i, %i).", rowIndex[k], colIndex[k], rows, cols);
+            GA_msg()(message, GA_MSG_ERROR);
+            GA_free(message);
+            return 0;
+        }
+    /* The triplets are sorted by column and then by row using two stable 
+       counting sorts, so that the elements of each row end up in ascending 
+       order of the column index, and triplets for the same element keep 
+       their input order. */
+    int* colStart = (int*)GA_alloc(cols + 1, sizeof(int));
+    int* byCol = (int*)GA_alloc(numTriplets > 0 ? numTriplets : 1, 
+        sizeof(int));
+    int* byRow = (int*)GA_alloc(numTriplets > 0 ? numTriplets : 1, 
+        sizeof(int));
+    int* rowPos = (int*)GA_alloc(rows + 1, sizeof(int));
+    if ((colStart == 0)
+        || (byCol == 0)
+        || (byRow == 0)
+        || (rowPos == 0))
+    {
+        GA_msg()("[GA_sparse_from_triplets_real] "
+            "Could not allocate sort buffers.", GA_MSG_ERROR);
+        return 0;
+    }
+    int i;
+    for (i = 0; i <= cols; i++)
+        colStart[i] = 0;
+    for (i = 0; i <= rows; i++)
+        rowPos[i] = 0;
+    for (k = 0; k < numTriplets; k++)
+    {
+        colStart[colIndex[k] + 1]++;
+        rowPos[rowIndex[k] + 1]++;
+    }
+    for (i = 0; i < cols; i++)
+        colStart[i + 1] += colStart[i];
+    for (i = 0; i < rows; i++)
+        rowPos[i + 1] += rowPos[i];
+    for (k = 0; k < numTriplets; k++)
+        byCol[colStart[colIndex[k]]++] = k;
+    for (k = 0; k < numTriplets; k++)
+    {
+        int t = byCol[k];
+        byRow[rowPos[rowIndex[t]]++] = t;
+    }
+    /* Count the distinct elements which differ from the default element. 
+       Of several triplets for the same element, the last one is used. */
+    int numElts = 0;
+    for (k = 0; k < numTriplets; k++)
+    {
+        int t = byRow[k];
+        if ((k + 1 < numTriplets)
+            && (rowIndex[byRow[k + 1]] == rowIndex[t])
+            && (colIndex[byRow[k + 1]] == colIndex[t]))
+            continue;
+        if (elts[t] != defaultElt)
+            numElts++;
+    }
+    GASparseMatrixReal* result = GA_sparse_create_real(rows, cols, numElts, 
+        defaultElt);
+    if (result == 0)
+        return 0;
+    for (i = 0; i <= rows; i++)
+        result->rowStart[i] = 0;
+    int n = 0;
+    for (k = 0; k < numTriplets; k++)
+    {
+        int t = byRow[k];
+        if ((k + 1 < numTriplets)
+            && (rowIndex[byRow[k + 1]] == rowIndex[t])
+            && (colIndex[byRow[k + 1]] == colIndex[t]))
+            continue;
+        if (elts[t] != defaultElt)
+        {
+            result->colIndex[n] = colIndex[t];
+            result->elts[n] = elts[t];
+            result->rowStart[rowIndex[t] + 1]++;
+            n++;
+        }
+    }
+    for (i = 0; i < rows; i++)
+        result->rowStart[i + 1] += result->rowStart[i];
+    GA_free((char*)colStart);
+    GA_free((char*)byCol);
+    GA_free((char*)byRow);
+    GA_free((char*)rowPos);
+    return result;
+}
+
+GASparseMatrixReal* GA_sparse_from_matrix_real(GAMatrixReal* matrix, 
+    double defaultElt)
+{
+    int numElts = 0;
+    int i;
+    int j;
+    for (i = 0; i < matrix->rows; i++)
+        for (j = 0; j < matrix->cols; j++)
+            if (matrix->elts[i][j] != defaultElt)
+                numElts++;
+    GASparseMatrixReal* result = GA_sparse_create_real(matrix->rows, 
+        matrix->cols, numElts, defaultElt);
+    if (result == 0)
+        return 0;
+    int k = 0;
+    for (i = 0; i < matrix->rows; i++)
+    {
+        result->rowStart[i] = k;
+        for (j = 0; j < matrix->cols; j++)
+            if (matrix->elts[i][j] != defaultElt)
+            {
+                result->colIndex[k] = j;
+                result->elts[k] = matrix->elts[i][j];
+                k++;
+            }
+    }
+    result->rowStart[matrix->rows] = k;
+    return result;
+}
+
+double GA_sparse_get_real(GASparseMatrixReal* matrix, int i, int j)
+{
+    int lower = matrix->rowStart[i];
+    int upper = matrix->rowStart[i + 1];
+    while (lower < upper)
+    {
+        int k = (lower + upper) / 2;
+        if (matrix->colIndex[k] < j)
+            lower = k + 1;
+        else
+            upper = k;
+    }
+    if ((lower < matrix->rowStart[i + 1])
+        && (matrix->colIndex[lower] == j))
+        return matrix->elts[lower];
+    return matrix->defaultElt;
+}
+
+GASparseMatrixInt* GA_sparse_to_bin_real(GASparseMatrixReal* matrix, 
+    GAVectorReal* lookup, GAClampMode clamp)
+{
+    int defaultBin = GA_get_bin_number(matrix->defaultElt, lookup, clamp);
+    if (defaultBin == -1)
+        return 0;
+    int* bins = (int*)GA_alloc(matrix->numElts > 0 ? matrix->numElts : 1, 
+        sizeof(int));
+    if (bins == 0)
+        return 0;
+    GABinLookup binLookup;
+    GA_bin_lookup_init(&binLookup, lookup, clamp);
+    int numElts = 0;
+    int k;
+    for (k = 0; k < matrix->numElts; k++)
+    {
+        bins[k] = GA_bin_lookup_get(&binLookup, matrix->elts[k]);
+        if (bins[k] == -1)
+        {
+            GA_bin_number_error(matrix->elts[k], lookup);
+            GA_free((char*)bins);
+            return 0;
+        }
+        if (bins[k] != defaultBin)
+            numElts++;
+    }
+    GASparseMatrixInt* result = GA_sparse_create_int(matrix->rows, 
+        matrix->cols, numElts, defaultBin);
+    if (result == 0)
+    {
+        GA_free((char*)bins);
+        return 0;
+    }
+    int n = 0;
+    int i;
+    for (i = 0; i < matrix->rows; i++)
+    {
+        result->rowStart[i] = n;
+        for (k = matrix->rowStart[i]; k < matrix->rowStart[i + 1]; k++)
+            if (bins[k] != defaultBin)
+            {
+                result->colIndex[n] = matrix->colIndex[k];
+                result->elts[n] = bins[k];
+                n++;
+            }
+    }
+    result->rowStart[matrix->rows] = n;
+    GA_free((char*)bins);
+    return result;
+}
+
+int GA_matrix_get_dominant_bin(GAMatrixBin* matrix, int numBins)
+{
+    int* count = (int*)GA_alloc(numBins, sizeof(int));
+    int i;
+    int j;
+    for (i = 0; i < numBins; i++)
+        count[i] = 0;
+    for (i = 0; i < matrix->rows; i++)
+        for (j = 0; j < matrix->cols; j++)
+        {
+            int x = GA_MATRIX_BIN_ELT(matrix, i, j);
+            if ((x >= 0)
+                && (x < numBins))
+                count[x]++;
+        }
+    int result = 0;
+    for (i = 1; i < numBins; i++)
+        if (count[i] > count[result])
+            result = i;
+    GA_free((char*)count);
+    return result;
+}
@@ -0,0 +1,332 @@
+#ifndef GA_SPARSE
+#define GA_SPARSE
+/* ----------------------------------------------------------------------------
+ * R package for graph alignment
+ * ----------------------------------------------------------------------------
+ *
+ * Author: Joern P. Meier <mail@ionflux.org>
+ * 
+ * The package can be used freely for non-commercial purposes. If you use this 
+ * package, the appropriate paper to cite is J. Berg and M. Laessig, 
+ * "Cross-species analysis of biological networks by Bayesian alignment", 
+ * PNAS 103 (29), 10967-10972 (2006)
+ * 
+ * This software is made available in the hope that it will be useful, but 
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY 
+ * or FITNESS FOR A PARTICULAR PURPOSE.
+ * 
+ * This software contains code for solving linear assignment problems which was 
+ * written by Roy Jonker, MagicLogic Optimization Inc.. Please note that this 
+ * code is copyrighted, (c) 2003 MagicLogic Systems Inc., Canada and may be 
+ * used for non-commercial purposes only. See 
+ * http://www.magiclogic.com/assignment.html for the latest version of the LAP 
+ * code and details on licensing.
+ *
+ * ----------------------------------------------------------------------------
+ * Sparse matrix types.
+ * ----------------------------------------------------------------------------
+ */
+
+/** \file GA_sparse.h
+ * \brief Sparse matrix types.
+ *
+ * This module provides types which represent sparse two-dimensional matrices 
+ * in compressed sparse row (CSR) format. Only the elements which differ from 
+ * a default element are stored. Memory management for the types is handled 
+ * transparently by the API functions which are provided by the module.
+ */
+
+#include "GA_vector.h"
+#include "GA_matrix.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** A sparse matrix of integers (implementation).
+ *
+ * This type holds the elements of a two-dimensional sparse matrix of 
+ * integers in compressed sparse row format. The stored elements of row 
+ * \c i are
+ *
+ * <tt>m->elts[k]</tt> with column index <tt>m->colIndex[k]</tt>
+ *
+ * for <tt>m->rowStart[i] <= k < m->rowStart[i + 1]</tt>, in ascending order 
+ * of the column index. All other elements are equal to \c defaultElt. To 
+ * create a new matrix, use one of the GA_sparse_create* functions. To 
+ * reference a matrix, use GA_sparse_ref_int(). To release a reference to a 
+ * matrix, use GA_sparse_destroy_int().
+ */
+struct GASparseMatrixInt_Impl
+{
+    /** Index of the first stored element of each row (rows + 1 entries).
+     */
+    int* rowStart;
+    /** Column indices of the stored elements.
+     */
+    int* colIndex;
+    /** Stored elements.
+     */
+    int* elts;
+    /** Number of rows.
+     */
+    int rows;
+    /** Number of columns.
+     */
+    int cols;
+    /** Number of stored elements.
+     */
+    int numElts;
+    /** Value of the elements which are not stored.
+     */
+    int defaultElt;
+    /** Reference count.
+     */
+    int refs;
+};
+
+/** A sparse matrix of integers.
+ */
+typedef struct GASparseMatrixInt_Impl GASparseMatrixInt;
+
+/** Create sparse matrix (int).
+ *
+ * Create a sparse matrix of integers with space for the specified number of 
+ * stored elements. The row start indices are initialized to zero. The new 
+ * matrix will be referenced and should be destroyed by using 
+ * GA_sparse_destroy_int() when it is not needed anymore.
+ *
+ * \param rows Number of rows.
+ * \param cols Number of columns.
+ * \param numElts Number of stored elements.
+ * \param defaultElt Value of the elements which are not stored.
+ *
+ * \return Pointer to a sparse matrix, or 0 if an error occurs.
+ *
+ * \sa GA_sparse_destroy_int
+ */
+GASparseMatrixInt* GA_sparse_create_int(int rows, int cols, int numElts, 
+    int defaultElt);
+
+/** Add reference.
+ *
+ * Add a reference for a sparse matrix. The user of this function is 
+ * responsible for removing the reference using GA_sparse_destroy_int().
+ *
+ * \param matrix Sparse matrix.
+ *
+ * \return The sparse matrix.
+ *
+ * \sa GA_sparse_destroy_int
+ */
+GASparseMatrixInt* GA_sparse_ref_int(GASparseMatrixInt* matrix);
+
+/** Destroy sparse matrix.
+ *
+ * Remove a reference from a sparse matrix. If the reference count drops to 
+ * zero, all resources allocated for the matrix will be freed and the matrix 
+ * itself will be destroyed.
+ *
+ * \param matrix Sparse matrix.
+ */
+void GA_sparse_destroy_int(GASparseMatrixInt* matrix);
+
+/** Create sparse matrix from matrix (bin).
+ *
+ * Create a sparse matrix of integers which stores all elements of the 
+ * specified matrix of bin numbers that differ from \c defaultElt. The new 
+ * matrix will be referenced and should be destroyed by using 
+ * GA_sparse_destroy_int() when it is not needed anymore.
+ *
+ * \param matrix matrix
+ * \param defaultElt value of the elements which are not stored
+ *
+ * \return new sparse matrix, or 0 if an error occurs
+ */
+GASparseMatrixInt* GA_sparse_from_matrix_bin(GAMatrixBin* matrix, 
+    int defaultElt);
+
+/** Get element (int).
+ *
+ * Get an element of a sparse matrix of integers. The stored elements of the 
+ * row are searched using binary search.
+ *
+ * \param matrix sparse matrix
+ * \param i row index
+ * \param j column index
+ *
+ * \return element
+ */
+int GA_sparse_get_int(GASparseMatrixInt* matrix, int i, int j);
+
+/** A sparse matrix of real numbers (implementation).
+ *
+ * This type holds the elements of a two-dimensional sparse matrix of real 
+ * numbers in compressed sparse row format (see GASparseMatrixInt_Impl). To 
+ * create a new matrix, use one of the GA_sparse_create* functions. To 
+ * reference a matrix, use GA_sparse_ref_real(). To release a reference to a 
+ * matrix, use GA_sparse_destroy_real().
+ */
+struct GASparseMatrixReal_Impl
+{
+    /** Index of the first stored element of each row (rows + 1 entries).
+     */
+    int* rowStart;
+    /** Column indices of the stored elements.
+     */
+    int* colIndex;
+    /** Stored elements.
+     */
+    double* elts;
+    /** Number of rows.
+     */
+    int rows;
+    /** Number of columns.
+     */
+    int cols;
+    /** Number of stored elements.
+     */
+    int numElts;
+    /** Value of the elements which are not stored.
+     */
+    double defaultElt;
+    /** Reference count.
+     */
+    int refs;
+};
+
+/** A sparse matrix of real numbers.
+ */
+typedef struct GASparseMatrixReal_Impl GASparseMatrixReal;
+
+/** Create sparse matrix (real).
+ *
+ * Create a sparse matrix of real numbers with space for the specified 
+ * number of stored elements. The row start indices are initialized to 
+ * zero. The new matrix will be referenced and should be destroyed by using 
+ * GA_sparse_destroy_real() when it is not needed anymore.
+ *
+ * \param rows Number of rows.
+ * \param cols Number of columns.
+ * \param numElts Number of stored elements.
+ * \param defaultElt Value of the elements which are not stored.
+ *
+ * \return Pointer to a sparse matrix, or 0 if an error occurs.
+ *
+ * \sa GA_sparse_destroy_real
+ */
+GASparseMatrixReal* GA_sparse_create_real(int rows, int cols, int numElts, 
+    double defaultElt);
+
+/** Add reference.
+ *
+ * Add a reference for a sparse matrix. The user of this function is 
+ * responsible for removing the reference using GA_sparse_destroy_real().
+ *
+ * \param matrix Sparse matrix.
+ *
+ * \return The sparse matrix.
+ *
+ * \sa GA_sparse_destroy_real
+ */
+GASparseMatrixReal* GA_sparse_ref_real(GASparseMatrixReal* matrix);
+
+/** Destroy sparse matrix.
+ *
+ * Remove a reference from a sparse matrix. If the reference count drops to 
+ * zero, all resources allocated for the matrix will be freed and the matrix 
+ * itself will be destroyed.
+ *
+ * \param matrix Sparse matrix.
+ */
+void GA_sparse_destroy_real(GASparseMatrixReal* matrix);
+
+/** Create sparse matrix from triplets (real).
+ *
+ * Create a sparse matrix of real numbers from a list of (row, column, 
+ * value) triplets. The triplets may be given in any order. If there is 
+ * more than one triplet for the same element, the last one is used, as if 
+ * the elements were assigned in order. Triplets with a value equal to 
+ * \c defaultElt are not stored. The new matrix will be referenced and 
+ * should be destroyed by using GA_sparse_destroy_real() when it is not 
+ * needed anymore.
+ *
+ * \param rows number of rows
+ * \param cols number of columns
+ * \param numTriplets number of triplets
+ * \param rowIndex row indices of the triplets
+ * \param colIndex column indices of the triplets
+ * \param elts values of the triplets
+ * \param defaultElt value of the elements which are not stored
+ *
+ * \return new sparse matrix, or 0 if an error occurs
+ */
+GASparseMatrixReal* GA_sparse_from_triplets_real(int rows, int cols, 
+    int numTriplets, int* rowIndex, int* colIndex, double* elts, 
+    double defaultElt);
+
+/** Create sparse matrix from matrix (real).
+ *
+ * Create a sparse matrix of real numbers which stores all elements of the 
+ * specified matrix that differ from \c defaultElt. The new matrix will be 
+ * referenced and should be destroyed by using GA_sparse_destroy_real() when 
+ * it is not needed anymore.
+ *
+ * \param matrix matrix
+ * \param defaultElt value of the elements which are not stored
+ *
+ * \return new sparse matrix, or 0 if an error occurs
+ */
+GASparseMatrixReal* GA_sparse_from_matrix_real(GAMatrixReal* matrix, 
+    double defaultElt);
+
+/** Get element (real).
+ *
+ * Get an element of a sparse matrix of real numbers. The stored elements of 
+ * the row are searched using binary search.
+ *
+ * \param matrix sparse matrix
+ * \param i row index
+ * \param j column index
+ *
+ * \return element
+ */
+double GA_sparse_get_real(GASparseMatrixReal* matrix, int i, int j);
+
+/** Convert to bin matrix (real).
+ *
+ * Convert a sparse matrix of real numbers to a sparse matrix of integer bin 
+ * numbers using the specified lookup vector. The default element of the 
+ * result is the bin of the default element of the input matrix, and stored 
+ * elements which fall into that bin are dropped. The new matrix will be 
+ * referenced and should be destroyed by using GA_sparse_destroy_int() when 
+ * it is not needed anymore.
+ *
+ * \param matrix sparse matrix
+ * \param lookup lookup vector
+ * \param clamp clamp mode
+ *
+ * \return sparse matrix of bin numbers, or 0 if an error occurs
+ *
+ * \sa GA_bin_lookup_get()
+ */
+GASparseMatrixInt* GA_sparse_to_bin_real(GASparseMatrixReal* matrix, 
+    GAVectorReal* lookup, GAClampMode clamp);
+
+/** Get most frequent element (bin).
+ *
+ * Get the most frequent element of a matrix of bin numbers in the range 
+ * 0 to \c numBins - 1.
+ *
+ * \param matrix matrix
+ * \param numBins number of bins
+ *
+ * \return most frequent element
+ */
+int GA_matrix_get_dominant_bin(GAMatrixBin* matrix, int numBins);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,154 @@
+/* ----------------------------------------------------------------------------
+ * R package for graph alignment
+ * ----------------------------------------------------------------------------
+ *
+ * Author: Joern P. Meier <mail@ionflux.org>
+ * 
+ * The package can be used freely for non-commercial purposes. If you use this 
+ * package, the appropriate paper to cite is J. Berg and M. Laessig, 
+ * "Cross-species analysis of biological networks by Bayesian alignment", 
+ * PNAS 103 (29), 10967-10972 (2006)
+ * 
+ * This software is made available in the hope that it will be useful, but 
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY 
+ * or FITNESS FOR A PARTICULAR PURPOSE.
+ * 
+ * This software contains code for solving linear assignment problems which was 
+ * written by Roy Jonker, MagicLogic Optimization Inc.. Please note that this 
+ * code is copyrighted, (c) 2003 MagicLogic Systems Inc., Canada and may be 
+ * used for non-commercial purposes only. See 
+ * http://www.magiclogic.com/assignment.html for the latest version of the LAP 
+ * code and details on licensing.
+ *
+ * ----------------------------------------------------------------------------
+ * R utility functions for sparse matrix types.
+ * ----------------------------------------------------------------------------
+ */
+
+/** \file GA_sparse_R.c
+ * \brief R utility functions for sparse matrix types (implementation).
+ */
+
+#include <string.h>
+#include "GA_alloc.h"
+#include "GA_message.h"
+#include "GA_matrix_R.h"
+#include "GA_sparse_R.h"
+
+/** Get list element.
+ *
+ * Get the element with the specified name from an R list.
+ *
+ * \param list R list
+ * \param name name of the element
+ *
+ * \return list element, or R_NilValue if there is no such element
+ */
+static SEXP GA_sparse_get_list_elt_R(SEXP list, const char* name)
+{
+    SEXP names = getAttrib(list, R_NamesSymbol);
+    if (names == R_NilValue)
+        return R_NilValue;
+    int i;
+    for (i = 0; i < LENGTH(list); i++)
+        if (strcmp(CHAR(STRING_ELT(names, i)), name) == 0)
+            return VECTOR_ELT(list, i);
+    return R_NilValue;
+}
+
+int GA_sparse_is_R(SEXP robj)
+{
+    if (TYPEOF(robj) != VECSXP)
+        return 0;
+    return GA_sparse_get_list_elt_R(robj, "dim") != R_NilValue;
+}
+
+GASparseMatrixReal* GA_sparse_from_R_real(SEXP robj)
+{
+    return GA_sparse_from_R_default_real(robj, 0.0);
+}
+
+GASparseMatrixReal* GA_sparse_from_R_default_real(SEXP robj, 
+    double defaultElt)
+{
+    PROTECT(robj);
+    if (!GA_sparse_is_R(robj))
+    {
+        /* Dense matrices are converted, so that networks can be mixed. */
+        GAMatrixReal* dense = GA_matrix_from_R_real(robj);
+        UNPROTECT(1);
+        if (dense == 0)
+            return 0;
+        GASparseMatrixReal* matrix = GA_sparse_from_matrix_real(dense, 
+            defaultElt);
+        GA_matrix_destroy_real(dense);
+        return matrix;
+    }
+    SEXP dim = GA_sparse_get_list_elt_R(robj, "dim");
+    SEXP rowIndex = GA_sparse_get_list_elt_R(robj, "i");
+    SEXP colIndex = GA_sparse_get_list_elt_R(robj, "j");
+    SEXP elts = GA_sparse_get_list_elt_R(robj, "x");
+    if ((LENGTH(dim) != 2)
+        || (TYPEOF(rowIndex) != INTSXP)
+        || (TYPEOF(colIndex) != INTSXP)
+        || ((TYPEOF(elts) != INTSXP)
+            && (TYPEOF(elts) != REALSXP))
+        || (LENGTH(rowIndex) != LENGTH(elts))
+        || (LENGTH(colIndex) != LENGTH(elts)))
+    {
+        GA_msg()("[GA_sparse_from_R_default_real] Sparse network has "
+            "missing or inconsistent elements.", GA_MSG_ERROR);
+        UNPROTECT(1);
+        return 0;
+    }
+    SEXP dims;
+    PROTECT(dims = coerceVector(dim, INTSXP));
+    SEXP values;
+    PROTECT(values = coerceVector(elts, REALSXP));
+    GASparseMatrixReal* matrix = GA_sparse_from_triplets_real(
+        INTEGER(dims)[0], INTEGER(dims)[1], LENGTH(values), 
+        INTEGER(rowIndex), INTEGER(colIndex), REAL(values), defaultElt);
+    UNPROTECT(3);
+    return matrix;
+}
+
+SEXP GA_sparse_to_R_real(GASparseMatrixReal* matrix)
+{
+    SEXP result;
+    PROTECT(result = allocVector(VECSXP, 4));
+    SEXP rowIndex;
+    PROTECT(rowIndex = allocVector(INTSXP, matrix->numElts));
+    SEXP colIndex;
+    PROTECT(colIndex = allocVector(INTSXP, matrix->numElts));
+    SEXP elts;
+    PROTECT(elts = allocVector(REALSXP, matrix->numElts));
+    SEXP dim;
+    PROTECT(dim = allocVector(INTSXP, 2));
+    int i;
+    int k;
+    for (i = 0; i < matrix->rows; i++)
+        for (k = matrix->rowStart[i]; k < matrix->rowStart[i + 1]; k++)
+        {
+            INTEGER(rowIndex)[k] = i;
+            INTEGER(colIndex)[k] = matrix->colIndex[k];
+            REAL(elts)[k] = matrix->elts[k];
+        }
+    INTEGER(dim)[0] = matrix->rows;
+    INTEGER(dim)[1] = matrix->cols;
+    SET_VECTOR_ELT(result, 0, rowIndex);
+    SET_VECTOR_ELT(result, 1, colIndex);
+    SET_VECTOR_ELT(result, 2, elts);
+    SET_VECTOR_ELT(result, 3, dim);
+    SEXP names;
+    PROTECT(names = allocVector(STRSXP, 4));
+    SET_STRING_ELT(names, 0, mkChar("i"));
+    SET_STRING_ELT(names, 1, mkChar("j"));
+    SET_STRING_ELT(names, 2, mkChar("x"));
+    SET_STRING_ELT(names, 3, mkChar("dim"));
+    setAttrib(result, R_NamesSymbol, names);
+    SEXP className;
+    PROTECT(className = mkString("GASparseNetwork"));
+    setAttrib(result, R_ClassSymbol, className);
+    UNPROTECT(7);
+    return result;
+}
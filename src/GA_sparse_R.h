@@ -0,0 +1,108 @@
+#ifndef GA_SPARSE_R
+#define GA_SPARSE_R
+/* ----------------------------------------------------------------------------
+ * R package for graph alignment
+ * ----------------------------------------------------------------------------
+ *
+ * Author: Joern P. Meier <mail@ionflux.org>
+ * 
+ * The package can be used freely for non-commercial purposes. If you use this 
+ * package, the appropriate paper to cite is J. Berg and M. Laessig, 
+ * "Cross-species analysis of biological networks by Bayesian alignment", 
+ * PNAS 103 (29), 10967-10972 (2006)
+ * 
+ * This software is made available in the hope that it will be useful, but 
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY 
+ * or FITNESS FOR A PARTICULAR PURPOSE.
+ * 
+ * This software contains code for solving linear assignment problems which was 
+ * written by Roy Jonker, MagicLogic Optimization Inc.. Please note that this 
+ * code is copyrighted, (c) 2003 MagicLogic Systems Inc., Canada and may be 
+ * used for non-commercial purposes only. See 
+ * http://www.magiclogic.com/assignment.html for the latest version of the LAP 
+ * code and details on licensing.
+ *
+ * ----------------------------------------------------------------------------
+ * R utility functions for sparse matrix types.
+ * ----------------------------------------------------------------------------
+ */
+
+/** \file GA_sparse_R.h
+ * \brief R utility functions for sparse matrix types.
+ *
+ * This module provides functions for handling conversions between the sparse 
+ * matrix types of the graph alignment package C implementation and the R 
+ * objects (<tt>SEXP</tt>) which represent sparse networks. A sparse network 
+ * is passed as a list with the integer vectors \c i and \c j (zero-based row 
+ * and column indices), the numeric vector \c x (values of the elements) and 
+ * the integer vector \c dim (dimensions of the matrix). All other elements 
+ * are zero.
+ */
+
+#include "R.h"
+#include "Rinternals.h"
+#include "Rdefines.h"
+#include "GA_sparse.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** Check for sparse network.
+ *
+ * Check whether an R object represents a sparse network.
+ *
+ * \param robj R object.
+ *
+ * \return 1 if the R object is a sparse network, 0 otherwise.
+ */
+int GA_sparse_is_R(SEXP robj);
+
+/** Create sparse matrix from R object (real).
+ *
+ * Create a sparse matrix of real numbers from an R object which represents 
+ * a sparse network. Dense matrices are accepted as well and are converted 
+ * to sparse matrices. The new matrix will be referenced and should be 
+ * destroyed by using GA_sparse_destroy_real() when it is not needed 
+ * anymore.
+ *
+ * \param robj R object.
+ *
+ * \return Pointer to a sparse matrix, or 0 if an error occurs.
+ *
+ * \sa GA_sparse_destroy_real
+ */
+GASparseMatrixReal* GA_sparse_from_R_real(SEXP robj);
+
+/** Create sparse matrix from R object with default element (real).
+ *
+ * Create a sparse matrix of real numbers from an R object (see 
+ * GA_sparse_from_R_real()), which stores all elements that differ from 
+ * \c defaultElt instead of all nonzero elements.
+ *
+ * \param robj R object.
+ * \param defaultElt Value of the elements which are not stored.
+ *
+ * \return Pointer to a sparse matrix, or 0 if an error occurs.
+ *
+ * \sa GA_sparse_destroy_real
+ */
+GASparseMatrixReal* GA_sparse_from_R_default_real(SEXP robj, 
+    double defaultElt);
+
+/** Create R object from sparse matrix (real).
+ *
+ * Create an R object which represents a sparse network from a sparse matrix 
+ * of real numbers with default element zero.
+ *
+ * \param matrix Sparse matrix.
+ *
+ * \return R object.
+ */
+SEXP GA_sparse_to_R_real(GASparseMatrixReal* matrix);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -31,6 +31,7 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <math.h>
 #include "GA_alloc.h"
 #include "GA_message.h"
 #include "GA_vector.h"
@@ -225,32 +226,18 @@ GAVectorReal* GA_vector_init_zero_real(GAVectorReal* vec)
     return vec;
 }
 
-int GA_get_bin_number(double x, GAVectorReal* lookup, GAClampMode clamp)
+int GA_get_bin_number_quiet(double x, GAVectorReal* lookup, 
+    GAClampMode clamp)
 {
     if (lookup->size == 0)
-    {
-        GA_msg()("[GA_get_bin_number] Lookup vector is empty.", 
-            GA_MSG_ERROR);
         return -1;
-    }
     if (lookup->size == 1)
     {
-        /* There is no real lookup range. */
+        /* There is no real lookup range. Either the argument is clamped or 
+           it is the lookup value itself. */
         if ((clamp == GA_CLAMP_DISABLED)
             && (x != lookup->elts[0]))
-        {
-            char* message = GA_alloc(256, sizeof(char));
-            snprintf(message, 256, "[GA_get_bin_number] "
-                "There is only a single lookup value and clamping is "
-                "disabled, but the input value is not equal to the lookup "
-                "value. Please make sure you have provided the correct "
-                "lookup range and clamp mode (x = %f, lookup = %f).\n", 
-                x, lookup->elts[0]);
-            GA_msg()(message, GA_MSG_ERROR);
-            GA_free(message);
             return -1;
-        }
-        /* Either the argument is clamped or it is the lookup value itself. */
         return 0;
     }
     if ((x < lookup->elts[0])
@@ -259,17 +246,7 @@ int GA_get_bin_number(double x, GAVectorReal* lookup, GAClampMode clamp)
         /* There is a real lookup range, and the argument is outside of 
            the boundaries. */
         if (clamp == GA_CLAMP_DISABLED)
-        {
-            char* message = GA_alloc(256, sizeof(char));
-            snprintf(message, 256, "[GA_get_bin_number] "
-                "Argument is outside of lookup range and clamping is disabled. "
-                "Please make sure you have provided the correct lookup range and "
-                "clamp mode (x = %f, lower = %f, upper = %f).\n", 
-                x, lookup->elts[0], lookup->elts[lookup->size - 1]);
-            GA_msg()(message, GA_MSG_ERROR);
-            GA_free(message);
             return -1;
-        }
         if (x < lookup->elts[0])
             return 0;
         if (x > lookup->elts[lookup->size - 1])
@@ -284,15 +261,138 @@ int GA_get_bin_number(double x, GAVectorReal* lookup, GAClampMode clamp)
     return result;
 }
 
+void GA_bin_number_error(double x, GAVectorReal* lookup)
+{
+    if (lookup->size == 0)
+    {
+        GA_msg()("[GA_get_bin_number] Lookup vector is empty.", 
+            GA_MSG_ERROR);
+        return;
+    }
+    char* message = GA_alloc(256, sizeof(char));
+    if (lookup->size == 1)
+        snprintf(message, 256, "[GA_get_bin_number] "
+            "There is only a single lookup value and clamping is "
+            "disabled, but the input value is not equal to the lookup "
+            "value. Please make sure you have provided the correct "
+            "lookup range and clamp mode (x = %f, lookup = %f).\n", 
+            x, lookup->elts[0]);
+    else
+        snprintf(message, 256, "[GA_get_bin_number] "
+            "Argument is outside of lookup range and clamping is disabled. "
+            "Please make sure you have provided the correct lookup range and "
+            "clamp mode (x = %f, lower = %f, upper = %f).\n", 
+            x, lookup->elts[0], lookup->elts[lookup->size - 1]);
+    GA_msg()(message, GA_MSG_ERROR);
+    GA_free(message);
+}
+
+GABinLookup* GA_bin_lookup_init(GABinLookup* binLookup, 
+    GAVectorReal* lookup, GAClampMode clamp)
+{
+    binLookup->lookup = lookup;
+    binLookup->clamp = clamp;
+    binLookup->kind = GA_BIN_LOOKUP_LINEAR;
+    binLookup->invStep = 0.0;
+    if (lookup->size < 3)
+        return binLookup;
+    /* The linear scan stops at the first boundary which is greater than the 
+       value, so it is equivalent to a search only if the lookup vector is 
+       sorted. */
+    int k;
+    for (k = 1; k < lookup->size; k++)
+        if (!(lookup->elts[k - 1] <= lookup->elts[k]))
+            return binLookup;
+    binLookup->kind = GA_BIN_LOOKUP_BINARY;
+    int last = lookup->size - 1;
+    double step = (lookup->elts[last] - lookup->elts[0]) / last;
+    if (!(step > 0.0)
+        || !isfinite(step))
+        return binLookup;
+    for (k = 1; k < last; k++)
+        if (fabs(lookup->elts[k] - (lookup->elts[0] + k * step)) 
+            > GA_BIN_LOOKUP_UNIFORM_TOLERANCE * step)
+            return binLookup;
+    binLookup->kind = GA_BIN_LOOKUP_UNIFORM;
+    binLookup->invStep = 1.0 / step;
+    return binLookup;
+}
+
+int GA_bin_lookup_get(GABinLookup* binLookup, double x)
+{
+    GAVectorReal* lookup = binLookup->lookup;
+    if (binLookup->kind == GA_BIN_LOOKUP_LINEAR)
+        return GA_get_bin_number_quiet(x, lookup, binLookup->clamp);
+    /* A sorted lookup vector has at least three elements, so there is a 
+       real lookup range. */
+    int last = lookup->size - 1;
+    if ((x < lookup->elts[0])
+        || (x > lookup->elts[last]))
+    {
+        if (binLookup->clamp == GA_CLAMP_DISABLED)
+            return -1;
+        if (x < lookup->elts[0])
+            return 0;
+        return last - 1;
+    }
+    if (binLookup->kind == GA_BIN_LOOKUP_UNIFORM)
+    {
+        /* Not a number, which the linear scan puts into the first bin. */
+        if (!(x >= lookup->elts[0]))
+            return 0;
+        /* The index is exact up to rounding and the tolerance of the 
+           boundaries, which is corrected by comparing with the 
+           neighbouring boundaries. */
+        int result = (int)((x - lookup->elts[0]) * binLookup->invStep);
+        if (result > last - 1)
+            result = last - 1;
+        while ((result > 0)
+            && (x < lookup->elts[result]))
+            result--;
+        while (((result + 1) < last)
+            && (x >= lookup->elts[result + 1]))
+            result++;
+        return result;
+    }
+    /* The bin number is the number of inner boundaries which are not 
+       greater than the argument. The search halves the range without 
+       branching on the comparison, which is compiled to a conditional 
+       move. */
+    const double* first = lookup->elts + 1;
+    const double* base = first;
+    int n = last - 1;
+    while (n > 1)
+    {
+        int half = n / 2;
+        base = (base[half] <= x) ? base + half : base;
+        n -= half;
+    }
+    return (int)(base - first) + (*base <= x);
+}
+
+int GA_get_bin_number(double x, GAVectorReal* lookup, GAClampMode clamp)
+{
+    int result = GA_get_bin_number_quiet(x, lookup, clamp);
+    if (result == -1)
+        GA_bin_number_error(x, lookup);
+    return result;
+}
+
 GAVectorInt* GA_vector_to_bin_real(GAVectorReal* vec, GAVectorReal* lookup, 
     GAClampMode clamp)
 {
     GAVectorInt* result = GA_vector_create_int(vec->size);
     if (result == 0)
         return 0;
+    GABinLookup binLookup;
+    GA_bin_lookup_init(&binLookup, lookup, clamp);
     int i;
     for (i = 0; i < vec->size; i++)
-        result->elts[i] = GA_get_bin_number(vec->elts[i], lookup, clamp);
+    {
+        result->elts[i] = GA_bin_lookup_get(&binLookup, vec->elts[i]);
+        if (result->elts[i] == -1)
+            GA_bin_number_error(vec->elts[i], lookup);
+    }
     /* ----- DEBUG ----- //
     GA_msg()("[GA_vector_to_bin_real] Input vector: ", GA_MSG_DEBUG);
     GA_vector_print_real(vec);
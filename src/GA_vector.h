@@ -343,6 +343,114 @@ typedef enum GAClampMode_Impl GAClampMode;
  */
 int GA_get_bin_number(double x, GAVectorReal* lookup, GAClampMode clamp);
 
+/** Get bin number (quiet).
+ *
+ * Get the bin number of a value in the same way as GA_get_bin_number(), 
+ * but without reporting errors. This function neither allocates memory nor 
+ * sends messages, so it can be called from several threads at once. An 
+ * error can be reported afterwards by using GA_bin_number_error().
+ *
+ * \param x number which should be binned
+ * \param lookup lookup vector
+ * \param clamp clamp the result to the lookup range
+ *
+ * \return bin number, or -1 if an error occurs
+ */
+int GA_get_bin_number_quiet(double x, GAVectorReal* lookup, 
+    GAClampMode clamp);
+
+/** Report bin number error.
+ *
+ * Report the error which GA_get_bin_number() reports for a value for which 
+ * GA_get_bin_number_quiet() returns -1.
+ *
+ * \param x number which could not be binned
+ * \param lookup lookup vector
+ */
+void GA_bin_number_error(double x, GAVectorReal* lookup);
+
+/** Maximum deviation of the boundaries of a uniform lookup vector.
+ *
+ * A sorted lookup vector is treated as uniform if each boundary deviates 
+ * from the uniform grid by at most this fraction of the bin width.
+ */
+#define GA_BIN_LOOKUP_UNIFORM_TOLERANCE 1e-6
+
+/** Bin lookup kind (implementation).
+ *
+ * The bin lookup kind specifies how the bin of a value is found.
+ */
+enum GABinLookupKind_Impl
+{
+    /** Bin lookup kind: linear scan over the lookup vector.
+     */
+    GA_BIN_LOOKUP_LINEAR = 0,
+    /** Bin lookup kind: binary search in a sorted lookup vector.
+     */
+    GA_BIN_LOOKUP_BINARY = 1,
+    /** Bin lookup kind: arithmetic indexing into a uniform lookup vector.
+     */
+    GA_BIN_LOOKUP_UNIFORM = 2
+};
+
+/** Bin lookup kind.
+ */
+typedef enum GABinLookupKind_Impl GABinLookupKind;
+
+/** Bin lookup.
+ *
+ * A bin lookup finds the bins of many values for the same lookup vector. 
+ * The fastest method which gives the same results as GA_get_bin_number() 
+ * is selected once when the bin lookup is initialized (see 
+ * GA_bin_lookup_init()): arithmetic indexing for uniformly spaced lookup 
+ * vectors, binary search for other sorted lookup vectors, and the linear 
+ * scan of GA_get_bin_number() for unsorted lookup vectors. A bin lookup 
+ * does not allocate memory and refers to the lookup vector, which must stay 
+ * valid as long as the bin lookup is used.
+ */
+typedef struct
+{
+    /** Lookup vector.
+     */
+    GAVectorReal* lookup;
+    /** Clamp mode.
+     */
+    GAClampMode clamp;
+    /** Lookup kind.
+     */
+    GABinLookupKind kind;
+    /** Inverse of the bin width of a uniform lookup vector.
+     */
+    double invStep;
+} GABinLookup;
+
+/** Initialize bin lookup.
+ *
+ * Initialize a bin lookup for the specified lookup vector and clamp mode. 
+ * This examines the lookup vector once, so that the bins of the values can 
+ * then be found with GA_bin_lookup_get() in constant or logarithmic time.
+ *
+ * \param binLookup bin lookup
+ * \param lookup lookup vector
+ * \param clamp clamp the result to the lookup range
+ *
+ * \return the bin lookup
+ */
+GABinLookup* GA_bin_lookup_init(GABinLookup* binLookup, 
+    GAVectorReal* lookup, GAClampMode clamp);
+
+/** Get bin number (bin lookup).
+ *
+ * Get the bin number of a value using a bin lookup. The result is the same 
+ * as that of GA_get_bin_number_quiet(), and errors are not reported either.
+ *
+ * \param binLookup bin lookup
+ * \param x number which should be binned
+ *
+ * \return bin number, or -1 if an error occurs
+ */
+int GA_bin_lookup_get(GABinLookup* binLookup, double x);
+
 /** Convert to bin vector (real).
  *
  * Convert a vector of real numbers to a vector of integer bin numbers 
@@ -356,7 +464,7 @@ int GA_get_bin_number(double x, GAVectorReal* lookup, GAClampMode clamp);
  *
  * \return vector of bin numbers
  *
- * \sa GA_get_bin_number()
+ * \sa GA_bin_lookup_get()
  */
 GAVectorInt* GA_vector_to_bin_real(GAVectorReal* vec, GAVectorReal* lookup, 
     GAClampMode clamp);
@@ -29,9 +29,16 @@
  * \brief Graph alignment module (implementation).
  */
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include <string.h>
+#include <math.h>
 #include "GraphAlignment.h"
 #include "GA_vector_R.h"
 #include "GA_matrix_R.h"
+#include "GA_sparse_R.h"
+#include "Rmath.h"
 #include "lap.h"
 
 void GA_msg_R(const char* text, GAMessageLevel level)
@@ -69,14 +76,14 @@ GAVectorInt* GA_linear_assignment_solve(GAMatrixInt* costMatrix)
     if (resultCols == 0)
         return 0;
     GA_vector_init_zero_int(resultCols);
-    GAVectorInt* u = GA_vector_create_int(costMatrix->rows);
+    /* The dual variables are 64 bit integers, so that the reduced costs 
+       cannot overflow. */
+    int64_t* u = (int64_t*)GA_alloc(costMatrix->rows, sizeof(int64_t));
     if (u == 0)
         return 0;
-    GA_vector_init_zero_int(u);
-    GAVectorInt* v = GA_vector_create_int(costMatrix->rows);
+    int64_t* v = (int64_t*)GA_alloc(costMatrix->rows, sizeof(int64_t));
     if (v == 0)
         return 0;
-    GA_vector_init_zero_int(v);
     /* ----- DEBUG ----- //
     GA_msg()("[GA_linear_assignment_solve_R] "
         "Calling LAP:\n", 
@@ -90,32 +97,422 @@ GAVectorInt* GA_linear_assignment_solve(GAMatrixInt* costMatrix)
     GA_msg()("[GA_linear_assignment_solve_R] resultCols = ", GA_MSG_DEBUG);
     GA_vector_print_int(resultCols);
     GA_msg()("\n", GA_MSG_INFO);
-    GA_msg()("[GA_linear_assignment_solve_R] u = ", GA_MSG_DEBUG);
-    GA_vector_print_int(u);
-    GA_msg()("\n", GA_MSG_INFO);
-    GA_msg()("[GA_linear_assignment_solve_R] v = ", GA_MSG_DEBUG);
-    GA_vector_print_int(v);
-    GA_msg()("\n", GA_MSG_INFO);
     char* message = GA_alloc(512, sizeof(char));
     snprintf(message, 512, "[GA_linear_assignment_solve_R] Input: "
         "costMatrix->rows = %i, costMatrix->elts = %p, "
         "resultRows->elts = %p, resultCols->elts = %p, "
-        "u->elts = %p, v->elts = %p\n", costMatrix->rows, 
+        "u = %p, v = %p\n", costMatrix->rows, 
         costMatrix->elts, resultRows->elts, resultCols->elts, 
-        u->elts, v->elts);
+        u, v);
     GA_msg()(message, GA_MSG_DEBUG);
     GA_free(message);
     // ----- DEBUG ----- */
-    LAP_lap(costMatrix->rows, costMatrix->elts, 
-        resultRows->elts, resultCols->elts, u->elts, v->elts);
+    LAP_lap_warm_int64(costMatrix->rows, costMatrix->elts, 
+        resultRows->elts, resultCols->elts, u, v, 0);
     /* ----- DEBUG ----- //
     GA_msg()("[GA_linear_assignment_solve_R] "
         "Destroying result vectors.\n", 
         GA_MSG_DEBUG);
     // ----- DEBUG ----- */
     GA_vector_destroy_int(resultRows);
-    GA_vector_destroy_int(u);
-    GA_vector_destroy_int(v);
+    GA_free((char*)u);
+    GA_free((char*)v);
+    return resultCols;
+}
+
+GAVectorInt* GA_linear_assignment_solve_real(GAMatrixReal* costMatrix)
+{
+    if (costMatrix->rows != costMatrix->cols)
+    {
+        GA_msg()("[GA_linear_assignment_solve_real] "
+            "Cost matrix is not a square matrix", GA_MSG_ERROR);
+        return 0;
+    }
+    GAVectorInt* resultRows = GA_vector_create_int(costMatrix->rows);
+    if (resultRows == 0)
+        return 0;
+    GAVectorInt* resultCols = GA_vector_create_int(costMatrix->rows);
+    if (resultCols == 0)
+        return 0;
+    GAVectorReal* u = GA_vector_create_real(costMatrix->rows);
+    if (u == 0)
+        return 0;
+    GAVectorReal* v = GA_vector_create_real(costMatrix->rows);
+    if (v == 0)
+        return 0;
+    LAP_lap_warm_real(costMatrix->rows, costMatrix->elts, 
+        resultRows->elts, resultCols->elts, u->elts, v->elts, 0);
+    GA_vector_destroy_int(resultRows);
+    GA_vector_destroy_real(u);
+    GA_vector_destroy_real(v);
+    return resultCols;
+}
+
+GALinearAssignmentState* GA_linear_assignment_state_create(int size)
+{
+    GALinearAssignmentState* result = (GALinearAssignmentState*)GA_alloc(1, 
+        sizeof(GALinearAssignmentState));
+    if (result == 0)
+        return 0;
+    result->rowSol = GA_vector_create_int(size);
+    if (result->rowSol == 0)
+        return 0;
+    result->v = GA_vector_create_real(size);
+    if (result->v == 0)
+        return 0;
+    result->valid = 0;
+    result->refs = 1;
+    return result;
+}
+
+GALinearAssignmentState* GA_linear_assignment_state_ref(
+    GALinearAssignmentState* state)
+{
+    state->refs++;
+    return state;
+}
+
+void GA_linear_assignment_state_destroy(GALinearAssignmentState* state)
+{
+    state->refs--;
+    if (state->refs > 0)
+        return;
+    GA_vector_destroy_int(state->rowSol);
+    GA_vector_destroy_real(state->v);
+    GA_free((char*)state);
+}
+
+GAVectorInt* GA_linear_assignment_solve_warm(GAMatrixInt* costMatrix, 
+    GALinearAssignmentState* state)
+{
+    if (costMatrix->rows != costMatrix->cols)
+    {
+        GA_msg()("[GA_linear_assignment_solve_warm] "
+            "Cost matrix is not a square matrix", GA_MSG_ERROR);
+        return 0;
+    }
+    if ((state->rowSol->size != costMatrix->rows)
+        || (state->v->size != costMatrix->rows))
+    {
+        GA_msg()("[GA_linear_assignment_solve_warm] "
+            "Size of the solver state does not match the cost matrix.", 
+            GA_MSG_ERROR);
+        return 0;
+    }
+    GAVectorInt* resultCols = GA_vector_create_int(costMatrix->rows);
+    if (resultCols == 0)
+        return 0;
+    int64_t* u = (int64_t*)GA_alloc(costMatrix->rows, sizeof(int64_t));
+    if (u == 0)
+        return 0;
+    int64_t* v = (int64_t*)GA_alloc(costMatrix->rows, sizeof(int64_t));
+    if (v == 0)
+        return 0;
+    int i;
+    if (state->valid)
+        for (i = 0; i < costMatrix->rows; i++)
+            v[i] = (int64_t)nearbyint(state->v->elts[i]);
+    LAP_lap_warm_int64(costMatrix->rows, costMatrix->elts, 
+        state->rowSol->elts, resultCols->elts, u, v, state->valid);
+    for (i = 0; i < costMatrix->rows; i++)
+        state->v->elts[i] = (double)v[i];
+    state->valid = 1;
+    GA_free((char*)u);
+    GA_free((char*)v);
+    return resultCols;
+}
+
+GAVectorInt* GA_linear_assignment_solve_warm_real(GAMatrixReal* costMatrix, 
+    GALinearAssignmentState* state)
+{
+    if (costMatrix->rows != costMatrix->cols)
+    {
+        GA_msg()("[GA_linear_assignment_solve_warm_real] "
+            "Cost matrix is not a square matrix", GA_MSG_ERROR);
+        return 0;
+    }
+    if ((state->rowSol->size != costMatrix->rows)
+        || (state->v->size != costMatrix->rows))
+    {
+        GA_msg()("[GA_linear_assignment_solve_warm_real] "
+            "Size of the solver state does not match the cost matrix.", 
+            GA_MSG_ERROR);
+        return 0;
+    }
+    GAVectorInt* resultCols = GA_vector_create_int(costMatrix->rows);
+    if (resultCols == 0)
+        return 0;
+    GAVectorReal* u = GA_vector_create_real(costMatrix->rows);
+    if (u == 0)
+        return 0;
+    LAP_lap_warm_real(costMatrix->rows, costMatrix->elts, 
+        state->rowSol->elts, resultCols->elts, u->elts, state->v->elts, 
+        state->valid);
+    state->valid = 1;
+    GA_vector_destroy_real(u);
+    return resultCols;
+}
+
+GAVectorInt* GA_linear_assignment_solve_rect_real(GAMatrixReal* costMatrix, 
+    double unassignedCost, int minAssigned)
+{
+    int rows = costMatrix->rows;
+    int cols = costMatrix->cols;
+    /* The smaller dimension of the cost matrix becomes the rows of the 
+       problem which is solved, so that every row can be assigned. */
+    int transposed = (rows > cols);
+    int numPrimary = transposed ? cols : rows;
+    int numSecondary = transposed ? rows : cols;
+    /* At most the smaller dimension can be assigned. */
+    if (minAssigned > numPrimary)
+        minAssigned = numPrimary;
+    GAVectorInt* result = GA_vector_create_int(cols);
+    if (result == 0)
+        return 0;
+    int i;
+    int j;
+    for (j = 0; j < cols; j++)
+        result->elts[j] = -1;
+    if (numPrimary == 0)
+        return result;
+    /* Assigning a pair instead of leaving both nodes unassigned saves 
+       twice the cost of an unassigned node. If all primary rows have to 
+       be assigned, the cost of the unassigned nodes is a constant. */
+    int allAssigned = (minAssigned >= numPrimary);
+    double shift = allAssigned ? 0. : 2. * unassignedCost;
+    int cutOff = (minAssigned <= 0);
+    int numDummies = (allAssigned || cutOff) ? 0 : numPrimary - minAssigned;
+    GAMatrixReal* work = GA_matrix_create_real(numPrimary, 
+        numSecondary + numDummies);
+    if (work == 0)
+        return 0;
+    for (i = 0; i < numPrimary; i++)
+    {
+        double* target = work->elts[i];
+        for (j = 0; j < numSecondary; j++)
+        {
+            double c = (transposed ? costMatrix->elts[j][i] 
+                : costMatrix->elts[i][j]) - shift;
+            target[j] = (cutOff && (c > 0.)) ? 0. : c;
+        }
+        for (j = numSecondary; j < numSecondary + numDummies; j++)
+            target[j] = 0.;
+    }
+    int* rowSol = (int*)GA_alloc(numPrimary, sizeof(int));
+    int* colSol = (int*)GA_alloc(numSecondary + numDummies, sizeof(int));
+    double* u = (double*)GA_alloc(numPrimary, sizeof(double));
+    double* v = (double*)GA_alloc(numSecondary + numDummies, 
+        sizeof(double));
+    if ((rowSol == 0)
+        || (colSol == 0)
+        || (u == 0)
+        || (v == 0))
+        return 0;
+    LAP_lap_rect_real(numPrimary, numSecondary + numDummies, work->elts, 
+        rowSol, colSol, u, v);
+    for (i = 0; i < numPrimary; i++)
+    {
+        /* Rows on extra columns and rows on pairs whose cost has been cut 
+           off are not assigned. */
+        j = rowSol[i];
+        if ((j >= numSecondary)
+            || (cutOff 
+                && (work->elts[i][j] >= 0.)))
+            continue;
+        if (transposed)
+            result->elts[i] = j;
+        else
+            result->elts[j] = i;
+    }
+    GA_matrix_destroy_real(work);
+    GA_free((char*)rowSol);
+    GA_free((char*)colSol);
+    GA_free((char*)u);
+    GA_free((char*)v);
+    return result;
+}
+
+/** Linear assignment batch buffers.
+ *
+ * Buffers of a thread of GA_linear_assignment_solve_batch().
+ */
+typedef struct
+{
+    /** Cost matrix for real costs.
+     */
+    GAMatrixReal* realCost;
+    /** Cost matrix for integer costs.
+     */
+    GAMatrixInt* intCost;
+    /** Column assigned to each row.
+     */
+    int* rowSol;
+    /** Row assigned to each column.
+     */
+    int* colSol;
+    /** Row dual variables (double or int64_t).
+     */
+    char* u;
+    /** Column dual variables (double or int64_t).
+     */
+    char* v;
+    /** Solver workspace.
+     */
+    LAPWorkspace* workspace;
+} GALinearAssignmentBatchBuffers;
+
+GAMatrixInt* GA_linear_assignment_solve_batch(GAMatrixViewReal** costMatrices, 
+    int numMatrices, int real, int numThreads)
+{
+    if (numMatrices < 1)
+    {
+        GA_msg()("[GA_linear_assignment_solve_batch] "
+            "There are no cost matrices.", GA_MSG_ERROR);
+        return 0;
+    }
+    int n = costMatrices[0]->rows;
+    int k;
+    for (k = 0; k < numMatrices; k++)
+        if ((costMatrices[k]->rows != n)
+            || (costMatrices[k]->cols != n))
+        {
+            GA_msg()("[GA_linear_assignment_solve_batch] "
+                "Cost matrices are not square matrices of the same size.", 
+                GA_MSG_ERROR);
+            return 0;
+        }
+    GAMatrixInt* result = GA_matrix_create_int(n, numMatrices);
+    if (result == 0)
+        return 0;
+    if (n == 0)
+        return result;
+    if (numThreads < 1)
+        numThreads = 1;
+    if (numThreads > numMatrices)
+        numThreads = numMatrices;
+    /* All buffers are allocated here, since the allocation functions may 
+       not be used by the threads. */
+    GALinearAssignmentBatchBuffers* buffers = 
+        (GALinearAssignmentBatchBuffers*)GA_alloc(numThreads, 
+            sizeof(GALinearAssignmentBatchBuffers));
+    if (buffers == 0)
+        return 0;
+    int dualSize = real ? sizeof(double) : sizeof(int64_t);
+    for (k = 0; k < numThreads; k++)
+    {
+        GALinearAssignmentBatchBuffers* own = buffers + k;
+        own->realCost = real ? GA_matrix_create_square_real(n) : 0;
+        own->intCost = real ? 0 : GA_matrix_create_square_int(n);
+        own->rowSol = (int*)GA_alloc(n, sizeof(int));
+        own->colSol = (int*)GA_alloc(n, sizeof(int));
+        own->u = GA_alloc(n, dualSize);
+        own->v = GA_alloc(n, dualSize);
+        own->workspace = LAP_workspace_create(n);
+        if (((own->realCost == 0)
+                && (own->intCost == 0))
+            || (own->rowSol == 0)
+            || (own->colSol == 0)
+            || (own->u == 0)
+            || (own->v == 0)
+            || (own->workspace == 0))
+            return 0;
+    }
+    int m;
+#pragma omp parallel num_threads(numThreads)
+    {
+#ifdef _OPENMP
+        GALinearAssignmentBatchBuffers* own = buffers + omp_get_thread_num();
+#else
+        GALinearAssignmentBatchBuffers* own = buffers;
+#endif
+#pragma omp for schedule(dynamic, 1)
+        for (m = 0; m < numMatrices; m++)
+        {
+            if (real)
+            {
+                GA_matrix_init_from_view_real(own->realCost, 
+                    costMatrices[m]);
+                LAP_lap_warm_real_ws(n, own->realCost->elts, own->rowSol, 
+                    own->colSol, (double*)own->u, (double*)own->v, 0, 
+                    own->workspace);
+            } else
+            {
+                GA_matrix_init_from_view_int(own->intCost, costMatrices[m]);
+                LAP_lap_warm_int64_ws(n, own->intCost->elts, own->rowSol, 
+                    own->colSol, (int64_t*)own->u, (int64_t*)own->v, 0, 
+                    own->workspace);
+            }
+            int j;
+            for (j = 0; j < n; j++)
+                result->elts[j][m] = own->colSol[j];
+        }
+    }
+    for (k = 0; k < numThreads; k++)
+    {
+        GALinearAssignmentBatchBuffers* own = buffers + k;
+        if (own->realCost != 0)
+            GA_matrix_destroy_real(own->realCost);
+        if (own->intCost != 0)
+            GA_matrix_destroy_int(own->intCost);
+        GA_free((char*)own->rowSol);
+        GA_free((char*)own->colSol);
+        GA_free(own->u);
+        GA_free(own->v);
+        LAP_workspace_destroy(own->workspace);
+    }
+    GA_free((char*)buffers);
+    return result;
+}
+
+GAVectorInt* GA_linear_assignment_solve_sparse(
+    GASparseMatrixReal* costMatrix)
+{
+    GALinearAssignmentState* state = GA_linear_assignment_state_create(
+        costMatrix->rows);
+    if (state == 0)
+        return 0;
+    GAVectorInt* result = GA_linear_assignment_solve_warm_sparse(costMatrix, 
+        state);
+    GA_linear_assignment_state_destroy(state);
+    return result;
+}
+
+GAVectorInt* GA_linear_assignment_solve_warm_sparse(
+    GASparseMatrixReal* costMatrix, GALinearAssignmentState* state)
+{
+    if (costMatrix->rows != costMatrix->cols)
+    {
+        GA_msg()("[GA_linear_assignment_solve_warm_sparse] "
+            "Cost matrix is not a square matrix", GA_MSG_ERROR);
+        return 0;
+    }
+    if ((state->rowSol->size != costMatrix->rows)
+        || (state->v->size != costMatrix->rows))
+    {
+        GA_msg()("[GA_linear_assignment_solve_warm_sparse] "
+            "Size of the solver state does not match the cost matrix.", 
+            GA_MSG_ERROR);
+        return 0;
+    }
+    GAVectorInt* resultCols = GA_vector_create_int(costMatrix->rows);
+    if (resultCols == 0)
+        return 0;
+    GAVectorReal* u = GA_vector_create_real(costMatrix->rows);
+    if (u == 0)
+        return 0;
+    int feasible = LAP_lapsp_warm(costMatrix->rows, costMatrix->rowStart, 
+        costMatrix->colIndex, costMatrix->elts, state->rowSol->elts, 
+        resultCols->elts, u->elts, state->v->elts, state->valid);
+    GA_vector_destroy_real(u);
+    state->valid = feasible;
+    if (!feasible)
+    {
+        GA_vector_destroy_int(resultCols);
+        GA_msg()("[GA_linear_assignment_solve_warm_sparse] "
+            "There is no complete assignment which uses only the stored "
+            "elements of the cost matrix.", GA_MSG_ERROR);
+        return 0;
+    }
     return resultCols;
 }
 
@@ -170,10 +567,109 @@ GAMatrixReal* GA_encode_directed_graph(GAMatrixReal* matrix, GAVectorInt* p)
     return result;
 }
 
+GASparseMatrixReal* GA_encode_directed_graph_sparse(
+    GASparseMatrixReal* matrix, GAVectorInt* p)
+{
+    if (matrix->rows != matrix->cols)
+    {
+        GA_msg()("[GA_encode_directed_graph_sparse] "
+            "Input matrix is not a square matrix.", GA_MSG_ERROR);
+        return 0;
+    }
+    if ((p != 0)
+        && (matrix->rows > p->size))
+    {
+        GA_msg()("[GA_encode_directed_graph_sparse] "
+            "Not enough elements in the permutation vector.", GA_MSG_ERROR);
+        return 0;
+    }
+    /* Each link (i, j) sets the elements (i, j) and (j, i). The elements 
+       are set in the same order as by GA_encode_directed_graph(), where a 
+       link (j, i) with i < j overwrites the link (i, j), so the triplets 
+       for the upper triangle are generated first. */
+    int numTriplets = 0;
+    int k;
+    for (k = 0; k < matrix->numElts; k++)
+        if (matrix->elts[k] == 1)
+            numTriplets += 2;
+    int* rowIndex = (int*)GA_alloc(numTriplets > 0 ? numTriplets : 1, 
+        sizeof(int));
+    int* colIndex = (int*)GA_alloc(numTriplets > 0 ? numTriplets : 1, 
+        sizeof(int));
+    double* elts = (double*)GA_alloc(numTriplets > 0 ? numTriplets : 1, 
+        sizeof(double));
+    if ((rowIndex == 0)
+        || (colIndex == 0)
+        || (elts == 0))
+        return 0;
+    int n = 0;
+    int lower;
+    for (lower = 0; lower < 2; lower++)
+    {
+        int i;
+        for (i = 0; i < matrix->rows; i++)
+            for (k = matrix->rowStart[i]; k < matrix->rowStart[i + 1]; k++)
+            {
+                int j = matrix->colIndex[k];
+                if ((matrix->elts[k] != 1)
+                    || ((i > j) != lower))
+                    continue;
+                double value;
+                if (p == 0)
+                    value = (i <= j) ? 1 : -1;
+                else
+                    value = (p->elts[i] <= p->elts[j]) ? 1 : -1;
+                rowIndex[n] = i;
+                colIndex[n] = j;
+                elts[n] = value;
+                rowIndex[n + 1] = j;
+                colIndex[n + 1] = i;
+                elts[n + 1] = value;
+                n += 2;
+            }
+    }
+    GASparseMatrixReal* result = GA_sparse_from_triplets_real(matrix->rows, 
+        matrix->cols, numTriplets, rowIndex, colIndex, elts, 0.0);
+    GA_free((char*)rowIndex);
+    GA_free((char*)colIndex);
+    GA_free((char*)elts);
+    return result;
+}
+
 SEXP GA_encode_directed_graph_R(SEXP matrix, SEXP p)
 {
     PROTECT(matrix);
     PROTECT(p);
+    if (GA_sparse_is_R(matrix))
+    {
+        GASparseMatrixReal* gaMatrix = GA_sparse_from_R_real(matrix);
+        if (gaMatrix == 0)
+        {
+            UNPROTECT(2);
+            return R_NilValue;
+        }
+        GAVectorInt* gaP = GA_vector_from_R_int(p);
+        if (gaP == 0)
+        {
+            GA_sparse_destroy_real(gaMatrix);
+            UNPROTECT(2);
+            return R_NilValue;
+        }
+        GASparseMatrixReal* gaResult = GA_encode_directed_graph_sparse(
+            gaMatrix, gaP);
+        GA_sparse_destroy_real(gaMatrix);
+        GA_vector_destroy_int(gaP);
+        if (gaResult == 0)
+        {
+            UNPROTECT(2);
+            return R_NilValue;
+        }
+        SEXP result;
+        result = GA_sparse_to_R_real(gaResult);
+        GA_sparse_destroy_real(gaResult);
+        UNPROTECT(2);
+        return result;
+    }
     GAMatrixReal* gaMatrix = GA_matrix_from_R_real(matrix);
     if (gaMatrix == 0)
     {
@@ -244,86 +740,474 @@ SEXP GA_linear_assignment_solve_R(SEXP costMatrix)
     return result;
 }
 
-GADirectedMode GA_directed_mode_from_R(SEXP robj)
+SEXP GA_linear_assignment_solve_real_R(SEXP costMatrix)
 {
-    PROTECT(robj);
-    SEXPTYPE objType = TYPEOF(robj);
-    if ((objType != LGLSXP)
-        && (objType != INTSXP)
-        && (objType != REALSXP))
+    PROTECT(costMatrix);
+    GAMatrixReal* gaCostMatrix = GA_matrix_from_R_real(costMatrix);
+    if (gaCostMatrix == 0)
     {
-        char* message = GA_alloc(256, sizeof(char));
-        snprintf(message, 256, 
-            "[GA_directed_mode_from_R] Input is not a logical, real or "
-            "integer value (actual type: %i).", objType);
-        GA_msg()(message, GA_MSG_ERROR);
-        GA_free(message);
         UNPROTECT(1);
-        return 0;
+        return R_NilValue;
     }
-    int size = LENGTH(robj);
-    int* inputRaw = LOGICAL(coerceVector(robj, LGLSXP));
-    if (inputRaw[0] == 0)
+    GAVectorInt* gaResult = GA_linear_assignment_solve_real(gaCostMatrix);
+    GA_matrix_destroy_real(gaCostMatrix);
+    if (gaResult == 0)
     {
         UNPROTECT(1);
-        return GA_DIRECTED_DISABLED;
+        return R_NilValue;
     }
+    SEXP result = GA_vector_to_R_int(gaResult);
+    GA_vector_destroy_int(gaResult);
     UNPROTECT(1);
-    return GA_DIRECTED_ENABLED;
+    return result;
 }
 
-GAMatrixReal* GA_compute_M(GAMatrixReal* a, GAMatrixReal* b, 
-    GAMatrixReal* r, GAVectorInt* p, GAMatrixReal* linkScore, 
-    GAMatrixReal* selfLinkScore, GAVectorReal* nodeScore1, 
-    GAVectorReal* nodeScore2, GAVectorReal* lookupLink, 
-    GAVectorReal* lookupNode, GAClampMode clamp)
+SEXP GA_linear_assignment_solve_auction_R(SEXP costMatrix, SEXP tolerance, 
+    SEXP threads)
 {
-    GAVectorInt* pInv = GA_invert_permutation_int(p);
-    if (pInv == 0)
+    PROTECT(costMatrix);
+    PROTECT(tolerance);
+    PROTECT(threads);
+    static const int numArgs = 3;
+    GAMatrixReal* gaCostMatrix = GA_matrix_from_R_real(costMatrix);
+    if (gaCostMatrix == 0)
     {
-        GA_msg()("[GA_compute_M] "
-            "Inverted permutation is null.", GA_MSG_ERROR);
-        return 0;
+        UNPROTECT(numArgs);
+        return R_NilValue;
     }
-    /* Various sanity checks of input values. */
-    if (a->rows != a->cols)
+    GAVectorInt* gaResult = GA_linear_assignment_solve_auction(gaCostMatrix, 
+        asReal(tolerance), GA_num_threads_from_R(threads));
+    GA_matrix_destroy_real(gaCostMatrix);
+    if (gaResult == 0)
     {
-        GA_msg()("[GA_compute_M] "
-            "Adjacency matrix for network A is not a square matrix.", 
-                GA_MSG_ERROR);
-        return 0;
+        UNPROTECT(numArgs);
+        return R_NilValue;
     }
-    if (b->rows != b->cols)
+    SEXP result = GA_vector_to_R_int(gaResult);
+    GA_vector_destroy_int(gaResult);
+    UNPROTECT(numArgs);
+    return result;
+}
+
+SEXP GA_linear_assignment_solve_rect_R(SEXP costMatrix, SEXP unassignedCost, 
+    SEXP minAssigned)
+{
+    PROTECT(costMatrix);
+    PROTECT(unassignedCost);
+    PROTECT(minAssigned);
+    static const int numArgs = 3;
+    GAMatrixReal* gaCostMatrix = GA_matrix_from_R_real(costMatrix);
+    if (gaCostMatrix == 0)
     {
-        GA_msg()("[GA_compute_M] "
-            "Adjacency matrix for network B is not a square matrix.", 
-                GA_MSG_ERROR);
-        return 0;
+        UNPROTECT(numArgs);
+        return R_NilValue;
     }
-    /* More sanity checks. */
-    if ((r->rows != a->rows) 
-        || (r->cols != b->rows))
+    GAVectorInt* gaResult = GA_linear_assignment_solve_rect_real( 
+        gaCostMatrix, asReal(unassignedCost), asInteger(minAssigned));
+    GA_matrix_destroy_real(gaCostMatrix);
+    if (gaResult == 0)
     {
-        char* message = GA_alloc(256, sizeof(char));
-        snprintf(message, 256, "[GA_compute_M] "
-            "Node similarity matrix R has wrong dimensions (%i, %i) "
-            "(expected (%i, %i)).", r->rows, r->cols, a->rows, b->rows);
-        GA_msg()(message, GA_MSG_ERROR);
-        GA_free(message);
-        GA_vector_destroy_int(pInv);
-        return 0;
+        UNPROTECT(numArgs);
+        return R_NilValue;
     }
-    if ((linkScore->rows < (lookupLink->size - 1))
-        || (linkScore->cols < (lookupLink->size - 1)))
+    SEXP result = GA_vector_to_R_int(gaResult);
+    GA_vector_destroy_int(gaResult);
+    UNPROTECT(numArgs);
+    return result;
+}
+
+SEXP GA_linear_assignment_solve_batch_R(SEXP costMatrices, SEXP real, 
+    SEXP threads)
+{
+    PROTECT(costMatrices);
+    PROTECT(real);
+    PROTECT(threads);
+    static const int numArgs = 3;
+    /* The cost matrices are viewed in the memory of the R objects, which 
+       are of type REALSXP. */
+    int numMatrices = 0;
+    int isList = (TYPEOF(costMatrices) == VECSXP);
+    SEXP dim = GET_DIM(costMatrices);
+    int* dims = 0;
+    if (isList)
+        numMatrices = LENGTH(costMatrices);
+    else
+    if ((TYPEOF(costMatrices) == REALSXP)
+        && (LENGTH(dim) == 3))
     {
-        char* message = GA_alloc(256, sizeof(char));
-        snprintf(message, 256, "[GA_compute_M] "
-            "Link score matrix dimension does not match number of bins "
-            "(dim(linkScore) = (%i, %i), length(lookupLink) = %i).", 
-            linkScore->rows, linkScore->cols, lookupLink->size);
-        GA_msg()(message, GA_MSG_ERROR);
-        GA_free(message);
-        GA_vector_destroy_int(pInv);
+        dims = INTEGER(dim);
+        numMatrices = dims[2];
+    } else
+    {
+        GA_msg()("[GA_linear_assignment_solve_batch_R] "
+            "Input is not a list of matrices or a three-dimensional array of "
+            "real values.", GA_MSG_ERROR);
+        UNPROTECT(numArgs);
+        return R_NilValue;
+    }
+    GAMatrixViewReal** views = (GAMatrixViewReal**)GA_alloc( 
+        (numMatrices > 0) ? numMatrices : 1, sizeof(GAMatrixViewReal*));
+    if (views == 0)
+    {
+        UNPROTECT(numArgs);
+        return R_NilValue;
+    }
+    int numViews;
+    for (numViews = 0; numViews < numMatrices; numViews++)
+    {
+        if (isList)
+            views[numViews] = GA_matrix_view_from_R_real( 
+                VECTOR_ELT(costMatrices, numViews));
+        else
+            views[numViews] = GA_matrix_view_create_real(REAL(costMatrices) 
+                + (size_t)numViews * dims[0] * dims[1], dims[0], dims[1], 1, 
+                dims[0]);
+        if (views[numViews] == 0)
+            break;
+    }
+    GAMatrixInt* gaResult = 0;
+    if (numViews == numMatrices)
+        gaResult = GA_linear_assignment_solve_batch(views, numMatrices, 
+            asLogical(real) == TRUE, GA_num_threads_from_R(threads));
+    int k;
+    for (k = 0; k < numViews; k++)
+        GA_matrix_view_destroy_real(views[k]);
+    GA_free((char*)views);
+    if (gaResult == 0)
+    {
+        UNPROTECT(numArgs);
+        return R_NilValue;
+    }
+    SEXP result = GA_matrix_to_R_int(gaResult);
+    GA_matrix_destroy_int(gaResult);
+    UNPROTECT(numArgs);
+    return result;
+}
+
+SEXP GA_linear_assignment_solve_warm_R(SEXP costMatrix, SEXP rowSol, 
+    SEXP v, SEXP real)
+{
+    PROTECT(costMatrix);
+    PROTECT(rowSol);
+    PROTECT(v);
+    PROTECT(real);
+    static const int numArgs = 4;
+    int useReal = (asLogical(real) == TRUE);
+    GAMatrixInt* gaCostMatrix = 0;
+    GAMatrixReal* gaCostMatrixReal = 0;
+    int size;
+    if (useReal)
+    {
+        gaCostMatrixReal = GA_matrix_from_R_real(costMatrix);
+        if (gaCostMatrixReal == 0)
+        {
+            UNPROTECT(numArgs);
+            return R_NilValue;
+        }
+        size = gaCostMatrixReal->rows;
+    } else
+    {
+        gaCostMatrix = GA_matrix_from_R_int(costMatrix);
+        if (gaCostMatrix == 0)
+        {
+            UNPROTECT(numArgs);
+            return R_NilValue;
+        }
+        size = gaCostMatrix->rows;
+    }
+    GALinearAssignmentState* state = GA_linear_assignment_state_create(size);
+    if (state == 0)
+    {
+        UNPROTECT(numArgs);
+        return R_NilValue;
+    }
+    /* A previous solution of a different size is ignored. */
+    if ((rowSol != R_NilValue)
+        && (v != R_NilValue)
+        && (LENGTH(rowSol) == size)
+        && (LENGTH(v) == size))
+    {
+        SEXP rowSolInt;
+        PROTECT(rowSolInt = coerceVector(rowSol, INTSXP));
+        SEXP vReal;
+        PROTECT(vReal = coerceVector(v, REALSXP));
+        memcpy(state->rowSol->elts, INTEGER(rowSolInt), size * sizeof(int));
+        memcpy(state->v->elts, REAL(vReal), size * sizeof(double));
+        state->valid = 1;
+        UNPROTECT(2);
+    }
+    GAVectorInt* gaResult;
+    if (useReal)
+    {
+        gaResult = GA_linear_assignment_solve_warm_real(gaCostMatrixReal, 
+            state);
+        GA_matrix_destroy_real(gaCostMatrixReal);
+    } else
+    {
+        gaResult = GA_linear_assignment_solve_warm(gaCostMatrix, state);
+        GA_matrix_destroy_int(gaCostMatrix);
+    }
+    SEXP result = R_NilValue;
+    if (gaResult != 0)
+    {
+        PROTECT(result = allocVector(VECSXP, 3));
+        SET_VECTOR_ELT(result, 0, GA_vector_to_R_int(gaResult));
+        SET_VECTOR_ELT(result, 1, GA_vector_to_R_int(state->rowSol));
+        SET_VECTOR_ELT(result, 2, GA_vector_to_R_real(state->v));
+        GA_vector_destroy_int(gaResult);
+        UNPROTECT(1);
+    }
+    GA_linear_assignment_state_destroy(state);
+    UNPROTECT(numArgs);
+    return result;
+}
+
+SEXP GA_linear_assignment_solve_sparse_R(SEXP costMatrix, SEXP rowSol, 
+    SEXP v)
+{
+    PROTECT(costMatrix);
+    PROTECT(rowSol);
+    PROTECT(v);
+    static const int numArgs = 3;
+    /* Elements which are not stored have infinite cost. */
+    GASparseMatrixReal* gaCostMatrix = GA_sparse_from_R_default_real(
+        costMatrix, R_PosInf);
+    if (gaCostMatrix == 0)
+    {
+        UNPROTECT(numArgs);
+        return R_NilValue;
+    }
+    int size = gaCostMatrix->rows;
+    GALinearAssignmentState* state = GA_linear_assignment_state_create(size);
+    if (state == 0)
+    {
+        UNPROTECT(numArgs);
+        return R_NilValue;
+    }
+    /* A previous solution of a different size is ignored. */
+    if ((rowSol != R_NilValue)
+        && (v != R_NilValue)
+        && (LENGTH(rowSol) == size)
+        && (LENGTH(v) == size))
+    {
+        SEXP rowSolInt;
+        PROTECT(rowSolInt = coerceVector(rowSol, INTSXP));
+        SEXP vReal;
+        PROTECT(vReal = coerceVector(v, REALSXP));
+        memcpy(state->rowSol->elts, INTEGER(rowSolInt), size * sizeof(int));
+        memcpy(state->v->elts, REAL(vReal), size * sizeof(double));
+        state->valid = 1;
+        UNPROTECT(2);
+    }
+    GAVectorInt* gaResult = GA_linear_assignment_solve_warm_sparse(
+        gaCostMatrix, state);
+    GA_sparse_destroy_real(gaCostMatrix);
+    SEXP result = R_NilValue;
+    if (gaResult != 0)
+    {
+        PROTECT(result = allocVector(VECSXP, 3));
+        SET_VECTOR_ELT(result, 0, GA_vector_to_R_int(gaResult));
+        SET_VECTOR_ELT(result, 1, GA_vector_to_R_int(state->rowSol));
+        SET_VECTOR_ELT(result, 2, GA_vector_to_R_real(state->v));
+        GA_vector_destroy_int(gaResult);
+        UNPROTECT(1);
+    }
+    GA_linear_assignment_state_destroy(state);
+    UNPROTECT(numArgs);
+    return result;
+}
+
+GADirectedMode GA_directed_mode_from_R(SEXP robj)
+{
+    PROTECT(robj);
+    SEXPTYPE objType = TYPEOF(robj);
+    if ((objType != LGLSXP)
+        && (objType != INTSXP)
+        && (objType != REALSXP))
+    {
+        char* message = GA_alloc(256, sizeof(char));
+        snprintf(message, 256, 
+            "[GA_directed_mode_from_R] Input is not a logical, real or "
+            "integer value (actual type: %i).", objType);
+        GA_msg()(message, GA_MSG_ERROR);
+        GA_free(message);
+        UNPROTECT(1);
+        return 0;
+    }
+    int size = LENGTH(robj);
+    int* inputRaw = LOGICAL(coerceVector(robj, LGLSXP));
+    if (inputRaw[0] == 0)
+    {
+        UNPROTECT(1);
+        return GA_DIRECTED_DISABLED;
+    }
+    UNPROTECT(1);
+    return GA_DIRECTED_ENABLED;
+}
+
+int GA_num_threads_from_R(SEXP robj)
+{
+    PROTECT(robj);
+    SEXPTYPE objType = TYPEOF(robj);
+    if ((objType != INTSXP)
+        && (objType != REALSXP))
+    {
+        char* message = GA_alloc(256, sizeof(char));
+        snprintf(message, 256, 
+            "[GA_num_threads_from_R] Input is not a real or "
+            "integer value (actual type: %i).", objType);
+        GA_msg()(message, GA_MSG_ERROR);
+        GA_free(message);
+        UNPROTECT(1);
+        return 1;
+    }
+    /* An empty value selects the default, like NA. */
+    if (LENGTH(robj) < 1)
+    {
+        UNPROTECT(1);
+        return 1;
+    }
+    int numThreads = asInteger(robj);
+    UNPROTECT(1);
+    if (numThreads == NA_INTEGER)
+        return 1;
+    if (numThreads < 1)
+        return GA_get_max_threads();
+    return numThreads;
+}
+
+GAComputeEngine GA_compute_engine_from_R(SEXP robj)
+{
+    PROTECT(robj);
+    if ((TYPEOF(robj) != STRSXP)
+        || (LENGTH(robj) < 1))
+    {
+        GA_msg()("[GA_compute_engine_from_R] Input is not a character "
+            "string.", GA_MSG_ERROR);
+        UNPROTECT(1);
+        return GA_ENGINE_SCALAR;
+    }
+    const char* name = CHAR(STRING_ELT(robj, 0));
+    UNPROTECT(1);
+    if (strcmp(name, "scalar") == 0)
+        return GA_ENGINE_SCALAR;
+    if (strcmp(name, "blas") == 0)
+        return GA_ENGINE_BLAS;
+    if (strcmp(name, "bitset") == 0)
+        return GA_ENGINE_BITSET;
+    if (strcmp(name, "sparse") == 0)
+        return GA_ENGINE_SPARSE;
+    char* message = GA_alloc(256, sizeof(char));
+    snprintf(message, 256, "[GA_compute_engine_from_R] "
+        "Unknown compute engine '%s'.", name);
+    GA_msg()(message, GA_MSG_ERROR);
+    GA_free(message);
+    return GA_ENGINE_SCALAR;
+}
+
+GAAssignmentEngine GA_assignment_engine_from_R(SEXP robj)
+{
+    PROTECT(robj);
+    if ((TYPEOF(robj) != STRSXP)
+        || (LENGTH(robj) < 1))
+    {
+        GA_msg()("[GA_assignment_engine_from_R] Input is not a character "
+            "string.", GA_MSG_ERROR);
+        UNPROTECT(1);
+        return GA_ASSIGNMENT_JV;
+    }
+    const char* name = CHAR(STRING_ELT(robj, 0));
+    UNPROTECT(1);
+    if (strcmp(name, "jv") == 0)
+        return GA_ASSIGNMENT_JV;
+    if (strcmp(name, "auction") == 0)
+        return GA_ASSIGNMENT_AUCTION;
+    char* message = GA_alloc(256, sizeof(char));
+    snprintf(message, 256, "[GA_assignment_engine_from_R] "
+        "Unknown assignment engine '%s'.", name);
+    GA_msg()(message, GA_MSG_ERROR);
+    GA_free(message);
+    return GA_ASSIGNMENT_JV;
+}
+
+GAPrecision GA_precision_from_R(SEXP robj)
+{
+    PROTECT(robj);
+    if ((TYPEOF(robj) != STRSXP)
+        || (LENGTH(robj) < 1))
+    {
+        GA_msg()("[GA_precision_from_R] Input is not a character string.", 
+            GA_MSG_ERROR);
+        UNPROTECT(1);
+        return GA_PRECISION_DOUBLE;
+    }
+    const char* name = CHAR(STRING_ELT(robj, 0));
+    UNPROTECT(1);
+    if (strcmp(name, "double") == 0)
+        return GA_PRECISION_DOUBLE;
+    if (strcmp(name, "single") == 0)
+        return GA_PRECISION_SINGLE;
+    char* message = GA_alloc(256, sizeof(char));
+    snprintf(message, 256, "[GA_precision_from_R] "
+        "Unknown precision '%s'.", name);
+    GA_msg()(message, GA_MSG_ERROR);
+    GA_free(message);
+    return GA_PRECISION_DOUBLE;
+}
+
+int GA_get_max_threads()
+{
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+/** Check arguments for the computation of M.
+ *
+ * Check the dimensions of the node similarity matrix, the score matrices 
+ * and the score vectors against the network sizes and the number of bins.
+ *
+ * \param numA number of nodes in network A
+ * \param numB number of nodes in network B
+ * \param rRows number of rows of the node similarity matrix
+ * \param rCols number of columns of the node similarity matrix
+ * \param linkScore link score matrix
+ * \param selfLinkScore self link score matrix
+ * \param nodeScore1 node score matrix (1)
+ * \param nodeScore2 node score matrix (2)
+ * \param lookupLink link bin lookup table
+ * \param lookupNode node bin lookup table
+ *
+ * \return 1 if the arguments are valid, 0 otherwise
+ */
+static int GA_compute_M_check(int numA, int numB, int rRows, int rCols, 
+    GAMatrixReal* linkScore, GAMatrixReal* selfLinkScore, 
+    GAVectorReal* nodeScore1, GAVectorReal* nodeScore2, 
+    GAVectorReal* lookupLink, GAVectorReal* lookupNode)
+{
+    if ((rRows != numA) 
+        || (rCols != numB))
+    {
+        char* message = GA_alloc(256, sizeof(char));
+        snprintf(message, 256, "[GA_compute_M] "
+            "Node similarity matrix R has wrong dimensions (%i, %i) "
+            "(expected (%i, %i)).", rRows, rCols, numA, numB);
+        GA_msg()(message, GA_MSG_ERROR);
+        GA_free(message);
+        return 0;
+    }
+    if ((linkScore->rows < (lookupLink->size - 1))
+        || (linkScore->cols < (lookupLink->size - 1)))
+    {
+        char* message = GA_alloc(256, sizeof(char));
+        snprintf(message, 256, "[GA_compute_M] "
+            "Link score matrix dimension does not match number of bins "
+            "(dim(linkScore) = (%i, %i), length(lookupLink) = %i).", 
+            linkScore->rows, linkScore->cols, lookupLink->size);
+        GA_msg()(message, GA_MSG_ERROR);
+        GA_free(message);
         return 0;
     }
     if ((selfLinkScore->rows < (lookupLink->size - 1))
@@ -336,7 +1220,6 @@ GAMatrixReal* GA_compute_M(GAMatrixReal* a, GAMatrixReal* b,
             linkScore->rows, linkScore->cols, lookupLink->size);
         GA_msg()(message, GA_MSG_ERROR);
         GA_free(message);
-        GA_vector_destroy_int(pInv);
         return 0;
     }
     if (nodeScore1->size < (lookupNode->size - 1))
@@ -348,7 +1231,6 @@ GAMatrixReal* GA_compute_M(GAMatrixReal* a, GAMatrixReal* b,
             nodeScore1->size, lookupNode->size);
         GA_msg()(message, GA_MSG_ERROR);
         GA_free(message);
-        GA_vector_destroy_int(pInv);
         return 0;
     }
     if (nodeScore2->size < (lookupNode->size - 1))
@@ -360,144 +1242,2046 @@ GAMatrixReal* GA_compute_M(GAMatrixReal* a, GAMatrixReal* b,
             nodeScore2->size, lookupNode->size);
         GA_msg()(message, GA_MSG_ERROR);
         GA_free(message);
-        GA_vector_destroy_int(pInv);
         return 0;
     }
-    /* ----- DEBUG ----- //
-    GA_msg()("[GA_compute_M] p:\n", GA_MSG_DEBUG);
-    GA_vector_print_int(p);
-    GA_msg()("\n", GA_MSG_INFO);
-    GA_msg()("[GA_compute_M] Binning matrices...\n", GA_MSG_DEBUG);
-    // ----- DEBUG ----- */
-    GAMatrixInt* aBin = GA_matrix_to_bin_real(a, lookupLink, clamp);
-    if (aBin == 0)
-        return 0;
-    GAMatrixInt* bBin = GA_matrix_to_bin_real(b, lookupLink, clamp);
-    if (bBin == 0)
-        return 0;
-    GAMatrixInt* rBin = GA_matrix_to_bin_real(r, lookupNode, clamp);
-    if (rBin == 0)
-        return 0;
-    /* ----- DEBUG ----- //
-    GA_msg()("[GA_compute_M] Done.\n", GA_MSG_DEBUG);
-    GA_msg()("[GA_compute_M] Calculating M...\n", GA_MSG_DEBUG);
-    GAMatrixReal* linkScoreResult = GA_matrix_create_square_real(p->size);
-    GAMatrixReal* selfLinkScoreResult = GA_matrix_create_square_real(p->size);
-    GAMatrixReal* nodeScoreResult = GA_matrix_create_square_real(p->size);
-    GA_matrix_init_zero_real(linkScoreResult);
-    GA_matrix_init_zero_real(selfLinkScoreResult);
-    GA_matrix_init_zero_real(nodeScoreResult);
-    // ----- DEBUG ----- */
-    GAMatrixReal* result = GA_matrix_create_square_real(p->size);
-    GA_matrix_init_zero_real(result);
-    int i;
-    int j;
-    for (i = 0; i < p->size; i++)
+    return 1;
+}
+
+/** Add self link and node scores to M.
+ *
+ * Add the self link scores and the node similarity scores to the link 
+ * score sums, which have already been stored in \c result or, for a 
+ * single precision score matrix, in \c resultFloat. The sums of the node 
+ * scores are computed in double precision in both cases.
+ *
+ * \param result score matrix containing the link score sums, or 0
+ * \param resultFloat single precision score matrix containing the link 
+ * score sums (used if \c result is 0)
+ * \param aSelfBin self link bins for network A
+ * \param bSelfBin self link bins for network B
+ * \param rBin bin matrix for the node similarity matrix
+ * \param p permutation vector
+ * \param pInv inverse permutation vector
+ * \param selfLinkScore self link score matrix
+ * \param nodeScore1 node score matrix (1)
+ * \param nodeScore2 node score matrix (2)
+ * \param numThreads number of threads
+ *
+ * \return 1 on success, or 0 if an error occurs
+ */
+static int GA_compute_M_add_node_scores(GAMatrixReal* result, 
+    GAMatrixFloat* resultFloat, GAVectorInt* aSelfBin, 
+    GAVectorInt* bSelfBin, GAMatrixBin* rBin, GAVectorInt* p, 
+    GAVectorInt* pInv, GAMatrixReal* selfLinkScore, 
+    GAVectorReal* nodeScore1, GAVectorReal* nodeScore2, int numThreads)
+{
+    int numA = aSelfBin->size;
+    int numB = bSelfBin->size;
+    /* The node score sums over unaligned nodes depend only on a single 
+       index of M, apart from one excluded term. The complete sums are 
+       computed once for each column of R (unaligned nodes of network A) 
+       and each row of R (unaligned nodes of network B), so that the 
+       excluded term can be subtracted for each element of M. */
+    GAVectorReal* unalignedASum = GA_vector_create_real(numB);
+    if (unalignedASum == 0)
+        return 0;
+    GA_vector_init_zero_real(unalignedASum);
+    GAVectorReal* unalignedBSum = GA_vector_create_real(numA);
+    if (unalignedBSum == 0)
+        return 0;
+    GA_vector_init_zero_real(unalignedBSum);
+    int k;
+    for (k = 0; k < numA; k++)
+        if (p->elts[k] >= numB)
+        {
+            int l;
+            for (l = 0; l < numB; l++)
+                unalignedASum->elts[l] += nodeScore2->elts[
+                    GA_MATRIX_BIN_ELT(rBin, k, l)];
+        }
+    for (k = 0; k < numA; k++)
+    {
+        int l;
+        for (l = 0; l < numB; l++)
+            if (pInv->elts[l] >= numA)
+                unalignedBSum->elts[k] += nodeScore2->elts[
+                    GA_MATRIX_BIN_ELT(rBin, k, l)];
+    }
+    /* Rows of M are independent of each other, so they are distributed 
+       among the threads. No memory is allocated and no messages are sent 
+       inside the parallel region, since neither the R allocator nor the 
+       R message functions may be called from a worker thread. */
+    int i;
+#pragma omp parallel for num_threads(numThreads) schedule(dynamic, 1)
+    for (i = 0; i < numB; i++)
+    {
+        int j;
+        for (j = 0; j < numA; j++)
+        {
+            /* The link score sum has been computed by the kernel. */
+            double linkScoreSum = (result != 0) ? result->elts[i][j] 
+                : resultFloat->elts[i][j];
+            /* Sum up self link scores. */
+            double selfLinkScoreSum = selfLinkScore->elts[aSelfBin->elts[j]]
+                [bSelfBin->elts[i]];
+            /* Sum up node similarity scores. */
+            double nodeScoreSum = nodeScore1->elts[
+                GA_MATRIX_BIN_ELT(rBin, j, i)];
+            nodeScoreSum += unalignedASum->elts[i];
+            if (p->elts[j] >= numB)
+                nodeScoreSum -= nodeScore2->elts[
+                    GA_MATRIX_BIN_ELT(rBin, j, i)];
+            nodeScoreSum += unalignedBSum->elts[j];
+            if (pInv->elts[i] >= numA)
+                nodeScoreSum -= nodeScore2->elts[
+                    GA_MATRIX_BIN_ELT(rBin, j, i)];
+            /* Set the element of M. */
+            if (result != 0)
+                result->elts[i][j] = linkScoreSum + selfLinkScoreSum 
+                    + nodeScoreSum;
+            else
+                resultFloat->elts[i][j] = (float)(linkScoreSum 
+                    + selfLinkScoreSum + nodeScoreSum);
+        }
+    }
+    GA_vector_destroy_real(unalignedASum);
+    GA_vector_destroy_real(unalignedBSum);
+    return 1;
+}
+
+/** Convert to bin matrix.
+ *
+ * Convert a matrix of real numbers to a matrix of bin numbers with the 
+ * smallest element size for the lookup vector (see 
+ * GA_matrix_view_to_bin_real()).
+ *
+ * \param matrix matrix
+ * \param lookup lookup vector
+ * \param clamp clamp mode
+ * \param numThreads number of threads
+ *
+ * \return matrix of bin numbers, or 0 if an error occurs
+ */
+static GAMatrixBin* GA_matrix_to_bin_compact_real(GAMatrixReal* matrix, 
+    GAVectorReal* lookup, GAClampMode clamp, int numThreads)
+{
+    GAMatrixViewReal* view = GA_matrix_view_of_real(matrix);
+    if (view == 0)
+        return 0;
+    GAMatrixBin* result = GA_matrix_view_to_bin_real(view, lookup, clamp, 
+        numThreads);
+    GA_matrix_view_destroy_real(view);
+    return result;
+}
+
+/** Get dimensions of score matrix.
+ *
+ * Get the dimensions of the score matrix M for networks with \c numA and 
+ * \c numB nodes. M has a row for each element of the permutation vector 
+ * and a column for each element of the permutation vector, or, if 
+ * \c rectangular is nonzero, a row for each node of network B and a 
+ * column for each node of network A. The elements for dummy nodes are 
+ * always zero, so they are left out of a rectangular M.
+ *
+ * \param numA number of nodes of network A
+ * \param numB number of nodes of network B
+ * \param p permutation vector
+ * \param rectangular rectangular score matrix
+ * \param rows where to store the number of rows
+ * \param cols where to store the number of columns
+ *
+ * \return 1 on success, or 0 if an error occurs
+ */
+static int GA_compute_M_dims(int numA, int numB, GAVectorInt* p, 
+    int rectangular, int* rows, int* cols)
+{
+    if ((p->size < numA)
+        || (p->size < numB))
+    {
+        GA_msg()("[GA_compute_M] "
+            "Permutation vector is shorter than the networks.", GA_MSG_ERROR);
+        return 0;
+    }
+    *rows = rectangular ? numB : p->size; 
+    *cols = rectangular ? numA : p->size;
+    return 1;
+}
+
+/** Create score matrix.
+ *
+ * Create the score matrix M for networks with \c numA and \c numB nodes 
+ * (see GA_compute_M_dims()), or check the dimensions of \c result, and 
+ * initialize it to zero.
+ *
+ * \param result matrix for the result, or 0 to create a new matrix
+ * \param numA number of nodes of network A
+ * \param numB number of nodes of network B
+ * \param p permutation vector
+ * \param rectangular create a rectangular score matrix
+ *
+ * \return the score matrix M, or 0 if an error occurs
+ */
+static GAMatrixReal* GA_compute_M_create(GAMatrixReal* result, int numA, 
+    int numB, GAVectorInt* p, int rectangular)
+{
+    int rows;
+    int cols;
+    if (!GA_compute_M_dims(numA, numB, p, rectangular, &rows, &cols))
+        return 0;
+    if (result == 0)
+    {
+        result = GA_matrix_create_real(rows, cols);
+        if (result == 0)
+            return 0;
+    } else
+    if ((result->rows != rows)
+        || (result->cols != cols))
+    {
+        GA_msg()("[GA_compute_M] "
+            "Result matrix does not have the dimensions of M.", 
+            GA_MSG_ERROR);
+        return 0;
+    }
+    GA_matrix_init_zero_real(result);
+    return result;
+}
+
+/** Create score matrix (single precision).
+ *
+ * See GA_compute_M_create().
+ */
+static GAMatrixFloat* GA_compute_M_create_float(GAMatrixFloat* result, 
+    int numA, int numB, GAVectorInt* p, int rectangular)
+{
+    int rows;
+    int cols;
+    if (!GA_compute_M_dims(numA, numB, p, rectangular, &rows, &cols))
+        return 0;
+    if (result == 0)
+    {
+        result = GA_matrix_create_float(rows, cols);
+        if (result == 0)
+            return 0;
+    } else
+    if ((result->rows != rows)
+        || (result->cols != cols))
+    {
+        GA_msg()("[GA_compute_M] "
+            "Result matrix does not have the dimensions of M.", 
+            GA_MSG_ERROR);
+        return 0;
+    }
+    GA_matrix_init_zero_float(result);
+    return result;
+}
+
+/** Check arguments of dense score matrix computation.
+ *
+ * Check that the bin matrices of the networks are square and that the 
+ * dimensions of the node similarity matrix and the score matrices match 
+ * (see GA_compute_M_check()).
+ *
+ * \return 1 if the arguments are valid, 0 otherwise
+ */
+static int GA_compute_M_binned_check(GAMatrixBin* aBin, GAMatrixBin* bBin, 
+    GAMatrixBin* rBin, GAMatrixReal* linkScore, GAMatrixReal* selfLinkScore, 
+    GAVectorReal* nodeScore1, GAVectorReal* nodeScore2, 
+    GAVectorReal* lookupLink, GAVectorReal* lookupNode)
+{
+    if (aBin->rows != aBin->cols)
+    {
+        GA_msg()("[GA_compute_M] "
+            "Adjacency matrix for network A is not a square matrix.", 
+                GA_MSG_ERROR);
+        return 0;
+    }
+    if (bBin->rows != bBin->cols)
+    {
+        GA_msg()("[GA_compute_M] "
+            "Adjacency matrix for network B is not a square matrix.", 
+                GA_MSG_ERROR);
+        return 0;
+    }
+    return GA_compute_M_check(aBin->rows, bBin->rows, rBin->rows, 
+        rBin->cols, linkScore, selfLinkScore, nodeScore1, nodeScore2, 
+        lookupLink, lookupNode);
+}
+
+/** Get self link bins.
+ *
+ * Get the diagonal of a bin matrix.
+ *
+ * \param bin bin matrix
+ *
+ * \return vector of self link bins, or 0 if an error occurs
+ */
+static GAVectorInt* GA_compute_M_self_bins(GAMatrixBin* bin)
+{
+    GAVectorInt* result = GA_vector_create_int(bin->rows);
+    if (result == 0)
+        return 0;
+    int k;
+    for (k = 0; k < bin->rows; k++)
+        result->elts[k] = GA_MATRIX_BIN_ELT(bin, k, k);
+    return result;
+}
+
+GAMatrixReal* GA_compute_M_binned(GAMatrixReal* result, 
+    GAMatrixBin* aBin, GAMatrixBin* bBin, GAMatrixBin* rBin, 
+    GAVectorInt* p, GAMatrixReal* linkScore, GAMatrixReal* selfLinkScore, 
+    GAVectorReal* nodeScore1, GAVectorReal* nodeScore2, 
+    GAVectorReal* lookupLink, GAVectorReal* lookupNode, 
+    GAComputeEngine engine, int numThreads, int rectangular)
+{
+    /* Various sanity checks of input values. */
+    if (!GA_compute_M_binned_check(aBin, bBin, rBin, linkScore, 
+        selfLinkScore, nodeScore1, nodeScore2, lookupLink, lookupNode))
+        return 0;
+    GAVectorInt* pInv = GA_invert_permutation_int(p);
+    if (pInv == 0)
+    {
+        GA_msg()("[GA_compute_M] "
+            "Inverted permutation is null.", GA_MSG_ERROR);
+        return 0;
+    }
+    result = GA_compute_M_create(result, aBin->rows, bBin->rows, p, 
+        rectangular);
+    if (result == 0)
+        return 0;
+    if (numThreads < 1)
+        numThreads = 1;
+    /* Sum up link scores. */
+    GAMatrixReal* linkResult = 0;
+    if (engine == GA_ENGINE_BLAS)
+        linkResult = GA_link_sum_blas(result, aBin, bBin, p, pInv, 
+            linkScore, lookupLink->size - 1, numThreads);
+    else
+    if (engine == GA_ENGINE_BITSET)
+    {
+        if (lookupLink->size != 3)
+        {
+            GA_msg()("[GA_compute_M] "
+                "The bitset engine requires exactly two link bins.", 
+                GA_MSG_ERROR);
+            return 0;
+        }
+        linkResult = GA_link_sum_bitset(result, aBin, bBin, p, pInv, 
+            linkScore, numThreads);
+    } else
+    if (engine == GA_ENGINE_SPARSE)
+        linkResult = GA_link_sum_sparse(result, aBin, bBin, p, pInv, 
+            linkScore, lookupLink->size - 1, numThreads);
+    else
+        linkResult = GA_link_sum_scalar(result, aBin, bBin, p, pInv, 
+            linkScore, numThreads);
+    if (linkResult == 0)
+        return 0;
+    GAVectorInt* aSelfBin = GA_compute_M_self_bins(aBin);
+    if (aSelfBin == 0)
+        return 0;
+    GAVectorInt* bSelfBin = GA_compute_M_self_bins(bBin);
+    if (bSelfBin == 0)
+        return 0;
+    int ok = GA_compute_M_add_node_scores(result, 0, aSelfBin, bSelfBin, 
+        rBin, p, pInv, selfLinkScore, nodeScore1, nodeScore2, numThreads);
+    GA_vector_destroy_int(pInv);
+    GA_vector_destroy_int(aSelfBin);
+    GA_vector_destroy_int(bSelfBin);
+    return ok ? result : 0;
+}
+
+GAMatrixFloat* GA_compute_M_binned_float(GAMatrixFloat* result, 
+    GAMatrixBin* aBin, GAMatrixBin* bBin, GAMatrixBin* rBin, 
+    GAVectorInt* p, GAMatrixReal* linkScore, GAMatrixReal* selfLinkScore, 
+    GAVectorReal* nodeScore1, GAVectorReal* nodeScore2, 
+    GAVectorReal* lookupLink, GAVectorReal* lookupNode, int numThreads, 
+    int rectangular)
+{
+    /* Various sanity checks of input values. */
+    if (!GA_compute_M_binned_check(aBin, bBin, rBin, linkScore, 
+        selfLinkScore, nodeScore1, nodeScore2, lookupLink, lookupNode))
+        return 0;
+    GAVectorInt* pInv = GA_invert_permutation_int(p);
+    if (pInv == 0)
+    {
+        GA_msg()("[GA_compute_M] "
+            "Inverted permutation is null.", GA_MSG_ERROR);
+        return 0;
+    }
+    result = GA_compute_M_create_float(result, aBin->rows, bBin->rows, p, 
+        rectangular);
+    if (result == 0)
+        return 0;
+    if (numThreads < 1)
+        numThreads = 1;
+    /* Sum up link scores. */
+    if (GA_link_sum_scalar_float(result, aBin, bBin, p, pInv, linkScore, 
+        numThreads) == 0)
+        return 0;
+    GAVectorInt* aSelfBin = GA_compute_M_self_bins(aBin);
+    if (aSelfBin == 0)
+        return 0;
+    GAVectorInt* bSelfBin = GA_compute_M_self_bins(bBin);
+    if (bSelfBin == 0)
+        return 0;
+    int ok = GA_compute_M_add_node_scores(0, result, aSelfBin, bSelfBin, 
+        rBin, p, pInv, selfLinkScore, nodeScore1, nodeScore2, numThreads);
+    GA_vector_destroy_int(pInv);
+    GA_vector_destroy_int(aSelfBin);
+    GA_vector_destroy_int(bSelfBin);
+    return ok ? result : 0;
+}
+
+GAMatrixReal* GA_compute_M(GAMatrixReal* a, GAMatrixReal* b, 
+    GAMatrixReal* r, GAVectorInt* p, GAMatrixReal* linkScore, 
+    GAMatrixReal* selfLinkScore, GAVectorReal* nodeScore1, 
+    GAVectorReal* nodeScore2, GAVectorReal* lookupLink, 
+    GAVectorReal* lookupNode, GAClampMode clamp, GAComputeEngine engine, 
+    int numThreads, int rectangular)
+{
+    GAMatrixBin* aBin = GA_matrix_to_bin_compact_real(a, lookupLink, clamp, 
+        numThreads);
+    if (aBin == 0)
+        return 0;
+    GAMatrixBin* bBin = GA_matrix_to_bin_compact_real(b, lookupLink, clamp, 
+        numThreads);
+    if (bBin == 0)
+        return 0;
+    GAMatrixBin* rBin = GA_matrix_to_bin_compact_real(r, lookupNode, clamp, 
+        numThreads);
+    if (rBin == 0)
+        return 0;
+    GAMatrixReal* result = GA_compute_M_binned(0, aBin, bBin, rBin, p, 
+        linkScore, selfLinkScore, nodeScore1, nodeScore2, lookupLink, 
+        lookupNode, engine, numThreads, rectangular);
+    GA_matrix_destroy_bin(aBin);
+    GA_matrix_destroy_bin(bBin);
+    GA_matrix_destroy_bin(rBin);
+    return result;
+}
+
+GAMatrixReal* GA_compute_M_sparse_binned(GAMatrixReal* result, 
+    GASparseMatrixInt* aBin, GASparseMatrixInt* bBin, GAMatrixBin* rBin, 
+    GAVectorInt* p, GAMatrixReal* linkScore, GAMatrixReal* selfLinkScore, 
+    GAVectorReal* nodeScore1, GAVectorReal* nodeScore2, 
+    GAVectorReal* lookupLink, GAVectorReal* lookupNode, int numThreads, 
+    int rectangular)
+{
+    /* Various sanity checks of input values. */
+    if (aBin->rows != aBin->cols)
+    {
+        GA_msg()("[GA_compute_M_sparse] "
+            "Adjacency matrix for network A is not a square matrix.", 
+                GA_MSG_ERROR);
+        return 0;
+    }
+    if (bBin->rows != bBin->cols)
+    {
+        GA_msg()("[GA_compute_M_sparse] "
+            "Adjacency matrix for network B is not a square matrix.", 
+                GA_MSG_ERROR);
+        return 0;
+    }
+    if (!GA_compute_M_check(aBin->rows, bBin->rows, rBin->rows, rBin->cols, 
+        linkScore, selfLinkScore, nodeScore1, nodeScore2, lookupLink, 
+        lookupNode))
+        return 0;
+    GAVectorInt* pInv = GA_invert_permutation_int(p);
+    if (pInv == 0)
+    {
+        GA_msg()("[GA_compute_M_sparse] "
+            "Inverted permutation is null.", GA_MSG_ERROR);
+        return 0;
+    }
+    result = GA_compute_M_create(result, aBin->rows, bBin->rows, p, 
+        rectangular);
+    if (result == 0)
+        return 0;
+    if (numThreads < 1)
+        numThreads = 1;
+    /* Sum up link scores. */
+    if (GA_link_sum_sparse_csr(result, aBin, bBin, p, pInv, linkScore, 
+        numThreads) == 0)
+        return 0;
+    GAVectorInt* aSelfBin = GA_vector_create_int(aBin->rows);
+    if (aSelfBin == 0)
+        return 0;
+    GAVectorInt* bSelfBin = GA_vector_create_int(bBin->rows);
+    if (bSelfBin == 0)
+        return 0;
+    int k;
+    for (k = 0; k < aBin->rows; k++)
+        aSelfBin->elts[k] = GA_sparse_get_int(aBin, k, k);
+    for (k = 0; k < bBin->rows; k++)
+        bSelfBin->elts[k] = GA_sparse_get_int(bBin, k, k);
+    int ok = GA_compute_M_add_node_scores(result, 0, aSelfBin, bSelfBin, 
+        rBin, p, pInv, selfLinkScore, nodeScore1, nodeScore2, numThreads);
+    GA_vector_destroy_int(pInv);
+    GA_vector_destroy_int(aSelfBin);
+    GA_vector_destroy_int(bSelfBin);
+    return ok ? result : 0;
+}
+
+GAMatrixReal* GA_compute_M_sparse(GASparseMatrixReal* a, 
+    GASparseMatrixReal* b, GAMatrixReal* r, GAVectorInt* p, 
+    GAMatrixReal* linkScore, GAMatrixReal* selfLinkScore, 
+    GAVectorReal* nodeScore1, GAVectorReal* nodeScore2, 
+    GAVectorReal* lookupLink, GAVectorReal* lookupNode, GAClampMode clamp, 
+    int numThreads, int rectangular)
+{
+    /* The networks stay sparse: only the elements outside of the bin of 
+       zero are binned and stored. */
+    GASparseMatrixInt* aBin = GA_sparse_to_bin_real(a, lookupLink, clamp);
+    if (aBin == 0)
+        return 0;
+    GASparseMatrixInt* bBin = GA_sparse_to_bin_real(b, lookupLink, clamp);
+    if (bBin == 0)
+        return 0;
+    GAMatrixBin* rBin = GA_matrix_to_bin_compact_real(r, lookupNode, clamp, 
+        numThreads);
+    if (rBin == 0)
+        return 0;
+    GAMatrixReal* result = GA_compute_M_sparse_binned(0, aBin, bBin, rBin, 
+        p, linkScore, selfLinkScore, nodeScore1, nodeScore2, lookupLink, 
+        lookupNode, numThreads, rectangular);
+    GA_sparse_destroy_int(aBin);
+    GA_sparse_destroy_int(bBin);
+    GA_matrix_destroy_bin(rBin);
+    return result;
+}
+
+/** Update score matrix (binned, implementation).
+ *
+ * Update the score matrix M after a change of the alignment (see 
+ * GA_update_M_binned()). Exactly one of \c m and \c mFloat must be 
+ * specified.
+ *
+ * \param m score matrix M for the old permutation, or 0
+ * \param mFloat single precision score matrix M for the old permutation 
+ * (used if \c m is 0)
+ * \param aBin bin matrix for network A
+ * \param bBin bin matrix for network B
+ * \param rBin bin matrix for the node similarity matrix
+ * \param oldP old permutation vector
+ * \param newP new permutation vector
+ * \param linkScore link score matrix
+ * \param nodeScore2 node score matrix (2)
+ * \param numThreads number of threads
+ *
+ * \return 1 on success, or 0 if an error occurs
+ */
+static int GA_update_M_binned_impl(GAMatrixReal* m, GAMatrixFloat* mFloat, 
+    GAMatrixBin* aBin, GAMatrixBin* bBin, GAMatrixBin* rBin, 
+    GAVectorInt* oldP, GAVectorInt* newP, GAMatrixReal* linkScore, 
+    GAVectorReal* nodeScore2, int numThreads)
+{
+    int numA = aBin->rows;
+    int numB = bBin->rows;
+    int mRows = (m != 0) ? m->rows : mFloat->rows;
+    int mCols = (m != 0) ? m->cols : mFloat->cols;
+    /* M is either square or rectangular (see GA_compute_M_binned()). */
+    if ((oldP->size != newP->size)
+        || (((mRows != newP->size)
+                || (mCols != newP->size))
+            && ((mRows != numB)
+                || (mCols != numA))))
+    {
+        char* message = GA_alloc(256, sizeof(char));
+        snprintf(message, 256, "[GA_update_M_binned] "
+            "Dimensions of M (%i, %i) do not match the size of the old and "
+            "new permutation vectors (%i, %i) or the networks (%i, %i).", 
+            mRows, mCols, oldP->size, newP->size, numB, numA);
+        GA_msg()(message, GA_MSG_ERROR);
+        GA_free(message);
+        return 0;
+    }
+    GAVectorInt* oldPInv = GA_invert_permutation_int(oldP);
+    GAVectorInt* newPInv = GA_invert_permutation_int(newP);
+    GAVectorInt* changedA = GA_vector_create_int(numA);
+    GAVectorInt* changedB = GA_vector_create_int(numB);
+    if ((oldPInv == 0)
+        || (newPInv == 0)
+        || (changedA == 0)
+        || (changedB == 0))
+        return 0;
+    /* Collect the nodes of network A which have been realigned and the 
+       nodes of network B which have been realigned. Only the terms of the 
+       sums in M which refer to these nodes are updated. */
+    int numChangedA = 0;
+    int numChangedB = 0;
+    int k;
+    for (k = 0; k < numA; k++)
+        if (oldP->elts[k] != newP->elts[k])
+            changedA->elts[numChangedA++] = k;
+    for (k = 0; k < numB; k++)
+        if (oldPInv->elts[k] != newPInv->elts[k])
+            changedB->elts[numChangedB++] = k;
+    if (numThreads < 1)
+        numThreads = 1;
+    int i;
+#pragma omp parallel for num_threads(numThreads) schedule(dynamic, 1)
+    for (i = 0; i < numB; i++)
+    {
+        int j;
+        for (j = 0; j < numA; j++)
+        {
+            double delta = 0.0;
+            int c;
+            for (c = 0; c < numChangedA; c++)
+            {
+                int l = changedA->elts[c];
+                if (l == j)
+                    continue;
+                int oldPl = oldP->elts[l];
+                int newPl = newP->elts[l];
+                /* Link score term. */
+                if ((oldPl != i)
+                    && (oldPl < numB))
+                    delta -= linkScore->elts[GA_MATRIX_BIN_ELT(aBin, j, l)]
+                        [GA_MATRIX_BIN_ELT(bBin, i, oldPl)];
+                if ((newPl != i)
+                    && (newPl < numB))
+                    delta += linkScore->elts[GA_MATRIX_BIN_ELT(aBin, j, l)]
+                        [GA_MATRIX_BIN_ELT(bBin, i, newPl)];
+                /* Node score term for unaligned nodes of network A. */
+                if ((oldPl >= numB)
+                    && (newPl < numB))
+                    delta -= nodeScore2->elts[GA_MATRIX_BIN_ELT(rBin, l, i)];
+                else
+                if ((oldPl < numB)
+                    && (newPl >= numB))
+                    delta += nodeScore2->elts[GA_MATRIX_BIN_ELT(rBin, l, i)];
+            }
+            for (c = 0; c < numChangedB; c++)
+            {
+                /* Node score term for unaligned nodes of network B. */
+                int l = changedB->elts[c];
+                if (l == i)
+                    continue;
+                if ((oldPInv->elts[l] >= numA)
+                    && (newPInv->elts[l] < numA))
+                    delta -= nodeScore2->elts[GA_MATRIX_BIN_ELT(rBin, j, l)];
+                else
+                if ((oldPInv->elts[l] < numA)
+                    && (newPInv->elts[l] >= numA))
+                    delta += nodeScore2->elts[GA_MATRIX_BIN_ELT(rBin, j, l)];
+            }
+            if (m != 0)
+                m->elts[i][j] += delta;
+            else
+                mFloat->elts[i][j] += (float)delta;
+        }
+    }
+    GA_vector_destroy_int(oldPInv);
+    GA_vector_destroy_int(newPInv);
+    GA_vector_destroy_int(changedA);
+    GA_vector_destroy_int(changedB);
+    return 1;
+}
+
+GAMatrixReal* GA_update_M_binned(GAMatrixReal* m, GAMatrixBin* aBin, 
+    GAMatrixBin* bBin, GAMatrixBin* rBin, GAVectorInt* oldP, 
+    GAVectorInt* newP, GAMatrixReal* linkScore, GAVectorReal* nodeScore2, 
+    int numThreads)
+{
+    if (!GA_update_M_binned_impl(m, 0, aBin, bBin, rBin, oldP, newP, 
+        linkScore, nodeScore2, numThreads))
+        return 0;
+    return m;
+}
+
+GAMatrixFloat* GA_update_M_binned_float(GAMatrixFloat* m, GAMatrixBin* aBin, 
+    GAMatrixBin* bBin, GAMatrixBin* rBin, GAVectorInt* oldP, 
+    GAVectorInt* newP, GAMatrixReal* linkScore, GAVectorReal* nodeScore2, 
+    int numThreads)
+{
+    if (!GA_update_M_binned_impl(0, m, aBin, bBin, rBin, oldP, newP, 
+        linkScore, nodeScore2, numThreads))
+        return 0;
+    return m;
+}
+
+GAMatrixReal* GA_update_M(GAMatrixReal* m, GAMatrixReal* a, GAMatrixReal* b, 
+    GAMatrixReal* r, GAVectorInt* oldP, GAVectorInt* newP, 
+    GAMatrixReal* linkScore, GAVectorReal* nodeScore2, 
+    GAVectorReal* lookupLink, GAVectorReal* lookupNode, GAClampMode clamp, 
+    int numThreads)
+{
+    if ((r->rows != a->rows) 
+        || (r->cols != b->rows))
+    {
+        char* message = GA_alloc(256, sizeof(char));
+        snprintf(message, 256, "[GA_update_M] "
+            "Node similarity matrix R has wrong dimensions (%i, %i) "
+            "(expected (%i, %i)).", r->rows, r->cols, a->rows, b->rows);
+        GA_msg()(message, GA_MSG_ERROR);
+        GA_free(message);
+        return 0;
+    }
+    GAMatrixBin* aBin = GA_matrix_to_bin_compact_real(a, lookupLink, clamp, 
+        numThreads);
+    if (aBin == 0)
+        return 0;
+    GAMatrixBin* bBin = GA_matrix_to_bin_compact_real(b, lookupLink, clamp, 
+        numThreads);
+    if (bBin == 0)
+        return 0;
+    GAMatrixBin* rBin = GA_matrix_to_bin_compact_real(r, lookupNode, clamp, 
+        numThreads);
+    if (rBin == 0)
+        return 0;
+    GAMatrixReal* result = GA_update_M_binned(m, aBin, bBin, rBin, oldP, 
+        newP, linkScore, nodeScore2, numThreads);
+    GA_matrix_destroy_bin(aBin);
+    GA_matrix_destroy_bin(bBin);
+    GA_matrix_destroy_bin(rBin);
+    return result;
+}
+
+GAAlignProblem* GA_align_problem_create()
+{
+    GAAlignProblem* result = (GAAlignProblem*)GA_alloc(1, 
+        sizeof(GAAlignProblem));
+    if (result == 0)
+        return 0;
+    memset(result, 0, sizeof(GAAlignProblem));
+    result->clamp = GA_CLAMP_ENABLED;
+    result->directed = GA_DIRECTED_DISABLED;
+    result->engine = GA_ENGINE_SCALAR;
+    result->precision = GA_PRECISION_DOUBLE;
+    result->assignmentEngine = GA_ASSIGNMENT_JV;
+    result->tolerance = GA_AUCTION_DEFAULT_TOLERANCE;
+    result->numThreads = 1;
+    result->refs = 1;
+    return result;
+}
+
+GAAlignProblem* GA_align_problem_ref(GAAlignProblem* problem)
+{
+    problem->refs++;
+    return problem;
+}
+
+void GA_align_problem_destroy(GAAlignProblem* problem)
+{
+    problem->refs--;
+    if (problem->refs > 0)
+        return;
+    if (problem->aBin != 0)
+        GA_matrix_destroy_bin(problem->aBin);
+    if (problem->bBin != 0)
+        GA_matrix_destroy_bin(problem->bBin);
+    if (problem->aSparseBin != 0)
+        GA_sparse_destroy_int(problem->aSparseBin);
+    if (problem->bSparseBin != 0)
+        GA_sparse_destroy_int(problem->bSparseBin);
+    if (problem->a != 0)
+        GA_matrix_destroy_real(problem->a);
+    if (problem->b != 0)
+        GA_matrix_destroy_real(problem->b);
+    if (problem->aSparse != 0)
+        GA_sparse_destroy_real(problem->aSparse);
+    if (problem->bSparse != 0)
+        GA_sparse_destroy_real(problem->bSparse);
+    if (problem->rBin != 0)
+        GA_matrix_destroy_bin(problem->rBin);
+    if (problem->linkScore != 0)
+        GA_matrix_destroy_real(problem->linkScore);
+    if (problem->selfLinkScore != 0)
+        GA_matrix_destroy_real(problem->selfLinkScore);
+    if (problem->nodeScore1 != 0)
+        GA_vector_destroy_real(problem->nodeScore1);
+    if (problem->nodeScore2 != 0)
+        GA_vector_destroy_real(problem->nodeScore2);
+    if (problem->lookupLink != 0)
+        GA_vector_destroy_real(problem->lookupLink);
+    if (problem->lookupNode != 0)
+        GA_vector_destroy_real(problem->lookupNode);
+    if (problem->cost != 0)
+        GA_matrix_destroy_int(problem->cost);
+    if (problem->costReal != 0)
+        GA_matrix_destroy_real(problem->costReal);
+    if (problem->candidates != 0)
+        GA_sparse_destroy_real(problem->candidates);
+    if (problem->lapState != 0)
+        GA_linear_assignment_state_destroy(problem->lapState);
+    if (problem->arena != 0)
+        GA_arena_destroy(problem->arena);
+    GA_free((char*)problem);
+}
+
+GAMatrixReal* GA_align_problem_compute_M(GAAlignProblem* problem, 
+    GAVectorInt* p, GAMatrixReal* m, GAVectorInt* prevP)
+{
+    if ((problem->aBin != 0)
+        && (problem->bBin != 0))
+    {
+        if ((m != 0)
+            && (prevP != 0))
+            return GA_update_M_binned(m, problem->aBin, problem->bBin, 
+                problem->rBin, prevP, p, problem->linkScore, 
+                problem->nodeScore2, problem->numThreads);
+        return GA_compute_M_binned(m, problem->aBin, problem->bBin, 
+            problem->rBin, p, problem->linkScore, problem->selfLinkScore, 
+            problem->nodeScore1, problem->nodeScore2, problem->lookupLink, 
+            problem->lookupNode, problem->engine, problem->numThreads, 
+            problem->rectangular);
+    }
+    if ((problem->aSparseBin != 0)
+        && (problem->bSparseBin != 0))
+        return GA_compute_M_sparse_binned(m, problem->aSparseBin, 
+            problem->bSparseBin, problem->rBin, p, problem->linkScore, 
+            problem->selfLinkScore, problem->nodeScore1, problem->nodeScore2, 
+            problem->lookupLink, problem->lookupNode, problem->numThreads, 
+            problem->rectangular);
+    /* Directed networks are encoded for the current alignment. */
+    if ((problem->a != 0)
+        && (problem->b != 0))
+    {
+        GAMatrixReal* aEnc = GA_encode_directed_graph(problem->a, p);
+        if (aEnc == 0)
+            return 0;
+        GAMatrixReal* bEnc = GA_encode_directed_graph(problem->b, p);
+        if (bEnc == 0)
+            return 0;
+        GAMatrixBin* aBin = GA_matrix_to_bin_compact_real(aEnc, 
+            problem->lookupLink, problem->clamp, problem->numThreads);
+        if (aBin == 0)
+            return 0;
+        GAMatrixBin* bBin = GA_matrix_to_bin_compact_real(bEnc, 
+            problem->lookupLink, problem->clamp, problem->numThreads);
+        if (bBin == 0)
+            return 0;
+        GAMatrixReal* result = GA_compute_M_binned(m, aBin, bBin, 
+            problem->rBin, p, problem->linkScore, problem->selfLinkScore, 
+            problem->nodeScore1, problem->nodeScore2, problem->lookupLink, 
+            problem->lookupNode, problem->engine, problem->numThreads, 
+            problem->rectangular);
+        GA_matrix_destroy_real(aEnc);
+        GA_matrix_destroy_real(bEnc);
+        GA_matrix_destroy_bin(aBin);
+        GA_matrix_destroy_bin(bBin);
+        return result;
+    }
+    if ((problem->aSparse != 0)
+        && (problem->bSparse != 0))
+    {
+        GASparseMatrixReal* aEnc = GA_encode_directed_graph_sparse(
+            problem->aSparse, p);
+        if (aEnc == 0)
+            return 0;
+        GASparseMatrixReal* bEnc = GA_encode_directed_graph_sparse(
+            problem->bSparse, p);
+        if (bEnc == 0)
+            return 0;
+        GASparseMatrixInt* aBin = GA_sparse_to_bin_real(aEnc, 
+            problem->lookupLink, problem->clamp);
+        if (aBin == 0)
+            return 0;
+        GASparseMatrixInt* bBin = GA_sparse_to_bin_real(bEnc, 
+            problem->lookupLink, problem->clamp);
+        if (bBin == 0)
+            return 0;
+        GAMatrixReal* result = GA_compute_M_sparse_binned(m, aBin, bBin, 
+            problem->rBin, p, problem->linkScore, problem->selfLinkScore, 
+            problem->nodeScore1, problem->nodeScore2, problem->lookupLink, 
+            problem->lookupNode, problem->numThreads, problem->rectangular);
+        GA_sparse_destroy_real(aEnc);
+        GA_sparse_destroy_real(bEnc);
+        GA_sparse_destroy_int(aBin);
+        GA_sparse_destroy_int(bBin);
+        return result;
+    }
+    GA_msg()("[GA_align_problem_compute_M] "
+        "Alignment problem does not specify the networks.", GA_MSG_ERROR);
+    return 0;
+}
+
+GAMatrixFloat* GA_align_problem_compute_M_float(GAAlignProblem* problem, 
+    GAVectorInt* p, GAMatrixFloat* m, GAVectorInt* prevP)
+{
+    if ((problem->aBin != 0)
+        && (problem->bBin != 0))
+    {
+        if ((m != 0)
+            && (prevP != 0))
+            return GA_update_M_binned_float(m, problem->aBin, 
+                problem->bBin, problem->rBin, prevP, p, problem->linkScore, 
+                problem->nodeScore2, problem->numThreads);
+        if (problem->engine == GA_ENGINE_SCALAR)
+            return GA_compute_M_binned_float(m, problem->aBin, 
+                problem->bBin, problem->rBin, p, problem->linkScore, 
+                problem->selfLinkScore, problem->nodeScore1, 
+                problem->nodeScore2, problem->lookupLink, 
+                problem->lookupNode, problem->numThreads, 
+                problem->rectangular);
+    }
+    /* The other kernels only work in double precision. */
+    GAMatrixReal* mReal = GA_align_problem_compute_M(problem, p, 0, 0);
+    if (mReal == 0)
+        return 0;
+    if (m == 0)
+    {
+        m = GA_matrix_to_float_real(mReal);
+        GA_matrix_destroy_real(mReal);
+        return m;
+    }
+    if ((m->rows != mReal->rows)
+        || (m->cols != mReal->cols))
+    {
+        GA_msg()("[GA_align_problem_compute_M_float] "
+            "Result matrix does not have the dimensions of M.", 
+            GA_MSG_ERROR);
+        GA_matrix_destroy_real(mReal);
+        return 0;
+    }
+    int i;
+    int j;
+    for (i = 0; i < m->rows; i++)
+    {
+        for (j = 0; j < m->cols; j++)
+            m->elts[i][j] = (float)mReal->elts[i][j];
+    }
+    GA_matrix_destroy_real(mReal);
+    return m;
+}
+
+/** Get bin number from dense or sparse bin matrix.
+ *
+ * \param dense dense bin matrix, or 0
+ * \param sparse sparse bin matrix (used if \c dense is 0)
+ * \param i row index
+ * \param j column index
+ *
+ * \return bin number
+ */
+static int GA_align_problem_get_bin(GAMatrixBin* dense, 
+    GASparseMatrixInt* sparse, int i, int j)
+{
+    if (dense != 0)
+        return GA_MATRIX_BIN_ELT(dense, i, j);
+    return GA_sparse_get_int(sparse, i, j);
+}
+
+GAVectorReal* GA_align_problem_compute_scores(GAAlignProblem* problem, 
+    GAVectorInt* p, int symmetric)
+{
+    GAMatrixBin* aBin = problem->aBin;
+    GAMatrixBin* bBin = problem->bBin;
+    GASparseMatrixInt* aSparseBin = problem->aSparseBin;
+    GASparseMatrixInt* bSparseBin = problem->bSparseBin;
+    int numA;
+    int numB;
+    if ((aBin != 0)
+        && (bBin != 0))
+    {
+        numA = aBin->rows;
+        numB = bBin->rows;
+    } else
+    if ((aSparseBin != 0)
+        && (bSparseBin != 0))
+    {
+        numA = aSparseBin->rows;
+        numB = bSparseBin->rows;
+    } else
+    {
+        GA_msg()("[GA_align_problem_compute_scores] "
+            "Scores can only be computed for undirected networks.", 
+            GA_MSG_ERROR);
+        return 0;
+    }
+    if ((p->size < numA)
+        || (p->size < numB))
+    {
+        GA_msg()("[GA_align_problem_compute_scores] "
+            "Not enough elements in the permutation vector.", GA_MSG_ERROR);
+        return 0;
+    }
+    GAVectorInt* pInv = GA_invert_permutation_int(p);
+    GAVectorReal* linkSum = GA_vector_create_real(numA);
+    GAVectorReal* selfLinkSum = GA_vector_create_real(numA);
+    GAVectorReal* nodeSumA = GA_vector_create_real(numA);
+    GAVectorReal* nodeSumB = GA_vector_create_real(numB);
+    GAVectorReal* result = GA_vector_create_real(2);
+    if ((pInv == 0)
+        || (linkSum == 0)
+        || (selfLinkSum == 0)
+        || (nodeSumA == 0)
+        || (nodeSumB == 0)
+        || (result == 0))
+        return 0;
+    GAMatrixReal* linkScore = problem->linkScore;
+    GAMatrixReal* selfLinkScore = problem->selfLinkScore;
+    GAVectorReal* nodeScore1 = problem->nodeScore1;
+    GAVectorReal* nodeScore2 = problem->nodeScore2;
+    GAMatrixBin* rBin = problem->rBin;
+    int numThreads = (problem->numThreads < 1) ? 1 : problem->numThreads;
+    /* The sums are accumulated per node and added up afterwards, so the 
+       result does not depend on the number of threads. Node scores for 
+       unaligned nodes are weighted by 0.5 if both nodes are aligned to 
+       other nodes, since the pair is then counted for both of them. */
+    int i;
+#pragma omp parallel for num_threads(numThreads) schedule(dynamic, 16)
+    for (i = 0; i < numA; i++)
+    {
+        double link = 0.;
+        double selfLink = 0.;
+        double node = 0.;
+        int pi = p->elts[i];
+        if (pi < numB)
+        {
+            int j;
+            for (j = 0; j < numA; j++)
+                if ((j != i) 
+                    && (p->elts[j] < numB))
+                    link += linkScore->elts[GA_align_problem_get_bin(aBin, 
+                        aSparseBin, i, j)][GA_align_problem_get_bin(bBin, 
+                        bSparseBin, pi, p->elts[j])];
+            selfLink = selfLinkScore->elts[GA_align_problem_get_bin(aBin, 
+                aSparseBin, i, i)][GA_align_problem_get_bin(bBin, 
+                bSparseBin, pi, pi)];
+            node = nodeScore1->elts[GA_MATRIX_BIN_ELT(rBin, i, pi)];
+            for (j = 0; j < numB; j++)
+                if (j != pi)
+                    node += ((pInv->elts[j] < numA) ? 0.5 : 1.) 
+                        * nodeScore2->elts[GA_MATRIX_BIN_ELT(rBin, i, j)];
+        }
+        linkSum->elts[i] = link;
+        selfLinkSum->elts[i] = selfLink;
+        nodeSumA->elts[i] = node;
+    }
+    int j;
+#pragma omp parallel for num_threads(numThreads) schedule(dynamic, 16)
+    for (j = 0; j < numB; j++)
+    {
+        double node = 0.;
+        int pInvj = pInv->elts[j];
+        if (pInvj < numA)
+        {
+            int k;
+            for (k = 0; k < numA; k++)
+                if (k != pInvj)
+                    node += ((p->elts[k] < numB) ? 0.5 : 1.) 
+                        * nodeScore2->elts[GA_MATRIX_BIN_ELT(rBin, k, j)];
+        }
+        nodeSumB->elts[j] = node;
+    }
+    double linkScoreTotal = 0.;
+    double selfLinkScoreTotal = 0.;
+    double nodeScoreTotal = 0.;
+    for (i = 0; i < numA; i++)
+    {
+        linkScoreTotal += linkSum->elts[i];
+        selfLinkScoreTotal += selfLinkSum->elts[i];
+        nodeScoreTotal += nodeSumA->elts[i];
+    }
+    for (j = 0; j < numB; j++)
+        nodeScoreTotal += nodeSumB->elts[j];
+    if (symmetric)
+        linkScoreTotal *= 0.5;
+    result->elts[0] = linkScoreTotal + selfLinkScoreTotal;
+    result->elts[1] = nodeScoreTotal;
+    GA_vector_destroy_int(pInv);
+    GA_vector_destroy_real(linkSum);
+    GA_vector_destroy_real(selfLinkSum);
+    GA_vector_destroy_real(nodeSumA);
+    GA_vector_destroy_real(nodeSumB);
+    return result;
+}
+
+/** Get element of score matrix for alignment step.
+ *
+ * \param m score matrix M, or 0
+ * \param mFloat single precision score matrix M (used if \c m is 0)
+ * \param i row index
+ * \param j column index
+ *
+ * \return the element (i, j) of M
+ */
+static double GA_align_networks_get_M(GAMatrixReal* m, GAMatrixFloat* mFloat, 
+    int i, int j)
+{
+    if (m != 0)
+        return m->elts[i][j];
+    return mFloat->elts[i][j];
+}
+
+/** Fill sparse cost matrix for alignment step.
+ *
+ * Fill the sparse cost matrix for a step of GA_align_networks() with the 
+ * negated normalized elements of M for the candidate pairs, plus noise if 
+ * \c b is not zero. The pairs of the current alignment \c p are added to 
+ * the candidates, so that there is always a complete assignment. The 
+ * noise is drawn for the stored elements only, in row-major order.
+ *
+ * \param candidates candidate pairs
+ * \param p current permutation vector
+ * \param pInv buffer for the inverse permutation
+ * \param m score matrix M, or 0
+ * \param mFloat single precision score matrix M (used if \c m is 0)
+ * \param maxAbs maximum absolute value of the elements of M
+ * \param b inverse noise level, or 0 for no noise
+ * \param cost sparse cost matrix, with space for the candidates and one 
+ * additional element per row
+ */
+static void GA_align_networks_fill_sparse_cost(GASparseMatrixReal* candidates, 
+    GAVectorInt* p, int* pInv, GAMatrixReal* m, GAMatrixFloat* mFloat, 
+    double maxAbs, double b, GASparseMatrixReal* cost)
+{
+    int n = p->size;
+    int i;
+    int j;
+    int t;
+    int k = 0;
+    for (j = 0; j < n; j++)
+        pInv[p->elts[j]] = j;
+    for (i = 0; i < n; i++)
+    {
+        /* The aligned column is inserted in ascending order of the column 
+           index, unless it is a candidate anyway. */
+        int aligned = pInv[i];
+        cost->rowStart[i] = k;
+        for (t = candidates->rowStart[i]; t < candidates->rowStart[i + 1]; 
+            t++)
+        {
+            j = candidates->colIndex[t];
+            if (j == aligned)
+                aligned = -1;
+            else
+            if ((aligned >= 0)
+                && (j > aligned))
+            {
+                cost->colIndex[k] = aligned;
+                k++;
+                aligned = -1;
+            }
+            cost->colIndex[k] = j;
+            k++;
+        }
+        if (aligned >= 0)
+        {
+            cost->colIndex[k] = aligned;
+            k++;
+        }
+        for (t = cost->rowStart[i]; t < k; t++)
+        {
+            double s = (b != 0) ? norm_rand() / b : 0.;
+            cost->elts[t] = -(GA_align_networks_get_M(m, mFloat, i, 
+                cost->colIndex[t]) / maxAbs + s);
+        }
+    }
+    cost->rowStart[n] = k;
+    cost->numElts = k;
+}
+
+/** Solve rectangular assignment problem for alignment step.
+ *
+ * Solve the rectangular linear assignment problem for a step of 
+ * GA_align_networks() and convert the result to a permutation vector of 
+ * size \c n. Nodes of network A which are not assigned get the labels of 
+ * dummy nodes of network B, and the dummy nodes of network A get the 
+ * remaining labels in ascending order.
+ *
+ * \param cost cost matrix, with a row for each node of network B and a 
+ * column for each node of network A
+ * \param minAssigned minimum number of aligned pairs
+ * \param n size of the permutation vector
+ *
+ * \return the permutation vector, or 0 if an error occurs
+ */
+static GAVectorInt* GA_align_networks_solve_rect(GAMatrixReal* cost, 
+    int minAssigned, int n)
+{
+    int numA = cost->cols;
+    int numB = cost->rows;
+    GAVectorInt* assigned = GA_linear_assignment_solve_rect_real(cost, 0., 
+        minAssigned);
+    if (assigned == 0)
+        return 0;
+    GAVectorInt* result = GA_vector_create_int(n);
+    int* used = (int*)GA_alloc(n, sizeof(int));
+    if ((result == 0)
+        || (used == 0))
+        return 0;
+    int i;
+    int j;
+    for (i = 0; i < n; i++)
+        used[i] = 0;
+    for (j = 0; j < numA; j++)
+    {
+        result->elts[j] = assigned->elts[j];
+        if (result->elts[j] >= 0)
+            used[result->elts[j]] = 1;
+    }
+    /* Unassigned nodes of network A are aligned to dummy nodes. */
+    int next = numB;
+    for (j = 0; j < numA; j++)
+        if (result->elts[j] < 0)
+        {
+            result->elts[j] = next;
+            used[next] = 1;
+            next++;
+        }
+    next = 0;
+    for (j = numA; j < n; j++)
+    {
+        while (used[next])
+            next++;
+        result->elts[j] = next;
+        used[next] = 1;
+    }
+    GA_free((char*)used);
+    GA_vector_destroy_int(assigned);
+    return result;
+}
+
+GAVectorInt* GA_align_networks(GAAlignProblem* problem, GAVectorInt* p, 
+    double bStart, double bEnd, int maxNumSteps, int warmStart)
+{
+    if (maxNumSteps <= 1)
+    {
+        GA_msg()("[GA_align_networks] "
+            "Maximum number of steps must be greater than 1.", GA_MSG_ERROR);
+        return 0;
+    }
+    int n = p->size;
+    double bStep = (bEnd - bStart) / (maxNumSteps - 1);
+    double bCur = bStart;
+    /* Everything which is kept from one step to the next is allocated 
+       before the first step. All other memory is released at the end of 
+       each step. */
+    GAVectorInt* curP = GA_vector_create_int(n);
+    GAVectorInt* prevP = GA_vector_create_int(n);
+    /* A rectangular M has a row for each node of network B and a column for 
+       each node of network A. */
+    int numA = problem->rBin->rows;
+    int numB = problem->rBin->cols;
+    int minAssigned = 0;
+    if (problem->rectangular)
+    {
+        if (problem->candidates != 0)
+        {
+            GA_msg()("[GA_align_networks] "
+                "Rectangular score matrices are not supported with "
+                "candidate pairs.", GA_MSG_ERROR);
+            return 0;
+        }
+        if ((n < numA)
+            || (n < numB))
+        {
+            GA_msg()("[GA_align_networks] "
+                "Permutation vector is shorter than the networks.", 
+                GA_MSG_ERROR);
+            return 0;
+        }
+        /* A permutation of size n aligns at least this many pairs. */
+        if (numA + numB > n)
+            minAssigned = numA + numB - n;
+    }
+    int mRows = problem->rectangular ? numB : n;
+    int mCols = problem->rectangular ? numA : n;
+    /* Only one of m and mFloat is used, depending on the precision. */
+    int single = (problem->precision == GA_PRECISION_SINGLE);
+    GAMatrixReal* m = 0;
+    GAMatrixFloat* mFloat = 0;
+    if (single)
+        mFloat = GA_matrix_create_float(mRows, mCols);
+    else
+        m = GA_matrix_create_real(mRows, mCols);
+    /* With candidate pairs, the linear assignment problems are sparse, and 
+       the dense cost matrix is not needed. */
+    GAMatrixReal* cost = 0;
+    GASparseMatrixReal* sparseCost = 0;
+    int* pInv = 0;
+    if (problem->candidates != 0)
+    {
+        if ((problem->candidates->rows != n)
+            || (problem->candidates->cols != n))
+        {
+            GA_msg()("[GA_align_networks] "
+                "Candidate matrix does not match the permutation vector.", 
+                GA_MSG_ERROR);
+            return 0;
+        }
+        sparseCost = GA_sparse_create_real(n, n, 
+            problem->candidates->numElts + n, 0.);
+        pInv = (int*)GA_alloc(n, sizeof(int));
+        if ((sparseCost == 0)
+            || (pInv == 0))
+            return 0;
+    } else
+    {
+        cost = GA_matrix_create_real(mRows, mCols);
+        if (cost == 0)
+            return 0;
+    }
+    GALinearAssignmentState* lapState = 0;
+    if (warmStart 
+        && !problem->rectangular)
+    {
+        lapState = GA_linear_assignment_state_create(n);
+        if (lapState == 0)
+            return 0;
+    }
+    if ((curP == 0)
+        || (prevP == 0)
+        || ((m == 0)
+            && (mFloat == 0)))
+        return 0;
+    if (problem->arena == 0)
+    {
+        /* Blocks have the size of M, so that the temporary matrices of a 
+           step need only a few of them. */
+        size_t blockSize = (size_t)n * n 
+            * (single ? sizeof(float) : sizeof(double));
+        problem->arena = GA_arena_create((blockSize > GA_ARENA_MIN_BLOCK_SIZE) 
+            ? blockSize : GA_ARENA_MIN_BLOCK_SIZE);
+        if (problem->arena == 0)
+            return 0;
+    }
+    memcpy(curP->elts, p->elts, n * sizeof(int));
+    /* M is updated incrementally if only a few nodes have been realigned 
+       in the previous step. This is only supported for undirected dense 
+       networks. */
+    int incremental = ((problem->aBin != 0) 
+        && (problem->bBin != 0));
+    int havePrevM = 0;
+    int maxChanged = n / 10;
+    if (bStep != 0)
+        GetRNGstate();
+    int ok = 1;
+    int step;
+    for (step = 0; (step < maxNumSteps) && ok; step++)
+    {
+        /* Long alignments can be interrupted between steps, while the 
+           arena is not active. */
+        R_CheckUserInterrupt();
+        GAArenaMark mark = GA_arena_mark(problem->arena);
+        GA_arena_activate(problem->arena);
+        int numChanged = 0;
+        int i;
+        int j;
+        if (havePrevM)
+            for (i = 0; i < n; i++)
+                if (curP->elts[i] != prevP->elts[i])
+                    numChanged++;
+        /* M is computed directly into m, from scratch unless prevP is 
+           passed. */
+        GAVectorInt* fromP = (havePrevM 
+            && (numChanged <= maxChanged)) ? prevP : 0;
+        if (single)
+            ok = (GA_align_problem_compute_M_float(problem, curP, mFloat, 
+                fromP) != 0);
+        else
+            ok = (GA_align_problem_compute_M(problem, curP, m, fromP) != 0);
+        if (ok 
+            && incremental)
+        {
+            memcpy(prevP->elts, curP->elts, n * sizeof(int));
+            havePrevM = 1;
+        }
+        if (ok)
+        {
+            double maxAbs = 0.;
+            for (i = 0; i < mRows; i++)
+                for (j = 0; j < mCols; j++)
+                {
+                    double x = fabs(GA_align_networks_get_M(m, mFloat, i, j));
+                    if (x > maxAbs)
+                        maxAbs = x;
+                }
+            if (maxAbs == 0.)
+                maxAbs = 1.;
+            GAVectorInt* newP;
+            if (sparseCost != 0)
+            {
+                GA_align_networks_fill_sparse_cost(problem->candidates, curP, 
+                    pInv, m, mFloat, maxAbs, (bStep != 0) ? bCur : 0., 
+                    sparseCost);
+                if (bStep != 0)
+                    bCur += bStep;
+                if (lapState != 0)
+                    newP = GA_linear_assignment_solve_warm_sparse(sparseCost, 
+                        lapState);
+                else
+                    newP = GA_linear_assignment_solve_sparse(sparseCost);
+            } else
+            {
+                /* The noise is drawn in column-major order, in the same 
+                   sequence as by rnorm() for an R matrix. The costs are not 
+                   rounded, since the solver works with real costs. */
+                if (bStep != 0)
+                {
+                    for (j = 0; j < mCols; j++)
+                        for (i = 0; i < mRows; i++)
+                        {
+                            double s = norm_rand() / bCur;
+                            cost->elts[i][j] = -(GA_align_networks_get_M(m, 
+                                mFloat, i, j) / maxAbs + s);
+                        }
+                    bCur += bStep;
+                } else
+                    for (i = 0; i < mRows; i++)
+                        for (j = 0; j < mCols; j++)
+                            cost->elts[i][j] = -GA_align_networks_get_M(m, 
+                                mFloat, i, j) / maxAbs;
+                if (problem->rectangular)
+                    newP = GA_align_networks_solve_rect(cost, minAssigned, 
+                        n);
+                else
+                if (problem->assignmentEngine == GA_ASSIGNMENT_AUCTION)
+                    newP = GA_linear_assignment_solve_auction(cost, 
+                        problem->tolerance, problem->numThreads);
+                else
+                if (lapState != 0)
+                    newP = GA_linear_assignment_solve_warm_real(cost, 
+                        lapState);
+                else
+                    newP = GA_linear_assignment_solve_real(cost);
+            }
+            ok = (newP != 0);
+            if (ok)
+            {
+                memcpy(curP->elts, newP->elts, n * sizeof(int));
+                GA_vector_destroy_int(newP);
+            }
+        }
+        GA_arena_deactivate(problem->arena);
+        GA_arena_reset(problem->arena, mark);
+    }
+    if (bStep != 0)
+        PutRNGstate();
+    GA_vector_destroy_int(prevP);
+    if (m != 0)
+        GA_matrix_destroy_real(m);
+    if (mFloat != 0)
+        GA_matrix_destroy_float(mFloat);
+    if (cost != 0)
+        GA_matrix_destroy_real(cost);
+    if (sparseCost != 0)
+    {
+        GA_sparse_destroy_real(sparseCost);
+        GA_free((char*)pInv);
+    }
+    if (lapState != 0)
+        GA_linear_assignment_state_destroy(lapState);
+    if (!ok)
+    {
+        GA_vector_destroy_int(curP);
+        return 0;
+    }
+    return curP;
+}
+
+/** Bin R matrix.
+ *
+ * Convert an R matrix to a matrix of bin numbers, reading the elements 
+ * directly from the memory of the R object. The R object must be of type 
+ * \c REALSXP and protected.
+ *
+ * \param robj R object
+ * \param lookup lookup vector
+ * \param clamp clamp mode
+ * \param numThreads number of threads
+ *
+ * \return matrix of bin numbers, or 0 if an error occurs
+ */
+static GAMatrixBin* GA_matrix_to_bin_R(SEXP robj, GAVectorReal* lookup, 
+    GAClampMode clamp, int numThreads)
+{
+    GAMatrixViewReal* view = GA_matrix_view_from_R_real(robj);
+    if (view == 0)
+        return 0;
+    GAMatrixBin* result = GA_matrix_view_to_bin_real(view, lookup, clamp, 
+        numThreads);
+    GA_matrix_view_destroy_real(view);
+    return result;
+}
+
+SEXP GA_matrix_to_bin_real_R(SEXP matrix, SEXP lookup, SEXP clamp, 
+    SEXP threads)
+{
+    PROTECT(matrix);
+    PROTECT(lookup);
+    PROTECT(clamp);
+    PROTECT(threads);
+    static const int numArgs = 4;
+    /* The matrix is binned in place, so it has to be stored as real 
+       numbers (see GA_matrix_view_from_R_real()). */
+    if (TYPEOF(matrix) != REALSXP)
+    {
+        GA_msg()("[GA_matrix_to_bin_real_R] "
+            "Matrix is not stored as real numbers.", GA_MSG_ERROR);
+        UNPROTECT(numArgs);
+        return R_NilValue;
+    }
+    GAVectorReal* gaLookup = GA_vector_from_R_real(lookup);
+    if (gaLookup == 0)
+    {
+        UNPROTECT(numArgs);
+        return R_NilValue;
+    }
+    GAMatrixBin* gaResult = GA_matrix_to_bin_R(matrix, gaLookup, 
+        GA_clamp_mode_from_R(clamp), GA_num_threads_from_R(threads));
+    GA_vector_destroy_real(gaLookup);
+    SEXP result = R_NilValue;
+    if (gaResult != 0)
+    {
+        result = GA_matrix_to_R_bin(gaResult);
+        GA_matrix_destroy_bin(gaResult);
+    }
+    UNPROTECT(numArgs);
+    return result;
+}
+
+SEXP GA_vector_to_bin_real_R(SEXP vec, SEXP lookup, SEXP clamp, 
+    SEXP threads)
+{
+    PROTECT(vec);
+    PROTECT(lookup);
+    PROTECT(clamp);
+    PROTECT(threads);
+    static const int numArgs = 4;
+    if (TYPEOF(vec) != REALSXP)
+    {
+        GA_msg()("[GA_vector_to_bin_real_R] "
+            "Vector is not stored as real numbers.", GA_MSG_ERROR);
+        UNPROTECT(numArgs);
+        return R_NilValue;
+    }
+    GAVectorReal* gaLookup = GA_vector_from_R_real(lookup);
+    if (gaLookup == 0)
+    {
+        UNPROTECT(numArgs);
+        return R_NilValue;
+    }
+    /* The vector is binned as a matrix with a single column. */
+    int size = LENGTH(vec);
+    GAMatrixViewReal* view = GA_matrix_view_create_real(REAL(vec), 
+        size, 1, 1, size);
+    GAMatrixBin* gaResult = 0;
+    if (view != 0)
+    {
+        gaResult = GA_matrix_view_to_bin_real(view, gaLookup, 
+            GA_clamp_mode_from_R(clamp), GA_num_threads_from_R(threads));
+        GA_matrix_view_destroy_real(view);
+    }
+    GA_vector_destroy_real(gaLookup);
+    if (gaResult == 0)
+    {
+        UNPROTECT(numArgs);
+        return R_NilValue;
+    }
+    SEXP result;
+    PROTECT(result = allocVector(INTSXP, size));
+    int* resultRaw = INTEGER(result);
+    int i;
+    for (i = 0; i < size; i++)
+        resultRaw[i] = GA_MATRIX_BIN_ELT(gaResult, i, 0);
+    GA_matrix_destroy_bin(gaResult);
+    UNPROTECT(numArgs + 1);
+    return result;
+}
+
+SEXP GA_update_M_R(SEXP m, SEXP a, SEXP b, SEXP r, SEXP oldP, SEXP newP, 
+    SEXP linkScore, SEXP nodeScore2, SEXP lookupLink, SEXP lookupNode, 
+    SEXP clamp, SEXP threads)
+{
+    PROTECT(m);
+    PROTECT(a);
+    PROTECT(b);
+    PROTECT(r);
+    PROTECT(oldP);
+    PROTECT(newP);
+    PROTECT(linkScore);
+    PROTECT(nodeScore2);
+    PROTECT(lookupLink);
+    PROTECT(lookupNode);
+    PROTECT(clamp);
+    PROTECT(threads);
+    static const int numArgs = 12;
+    /* The networks and the node similarity matrix are binned in place 
+       (see GA_matrix_view_from_R_real()). */
+    if ((TYPEOF(a) != REALSXP)
+        || (TYPEOF(b) != REALSXP)
+        || (TYPEOF(r) != REALSXP))
+    {
+        GA_msg()("[GA_update_M_R] Networks or node similarity matrix "
+            "not stored as real numbers.", GA_MSG_ERROR);
+        UNPROTECT(numArgs);
+        return R_NilValue;
+    }
+    GAMatrixReal* gaM = GA_matrix_from_R_real(m);
+    GAVectorInt* gaOldP = GA_vector_from_R_int(oldP);
+    GAVectorInt* gaNewP = GA_vector_from_R_int(newP);
+    GAMatrixReal* gaLinkScore = GA_matrix_from_R_real(linkScore);
+    GAVectorReal* gaNodeScore2 = GA_vector_from_R_real(nodeScore2);
+    GAVectorReal* gaLookupLink = GA_vector_from_R_real(lookupLink);
+    GAVectorReal* gaLookupNode = GA_vector_from_R_real(lookupNode);
+    if ((gaM == 0)
+        || (gaOldP == 0)
+        || (gaNewP == 0)
+        || (gaLinkScore == 0)
+        || (gaNodeScore2 == 0)
+        || (gaLookupLink == 0)
+        || (gaLookupNode == 0))
+    {
+        UNPROTECT(numArgs);
+        return R_NilValue;
+    }
+    GAClampMode gaClamp = GA_clamp_mode_from_R(clamp);
+    int gaNumThreads = GA_num_threads_from_R(threads);
+    GAMatrixBin* aBin = GA_matrix_to_bin_R(a, gaLookupLink, gaClamp, 
+        gaNumThreads);
+    GAMatrixBin* bBin = GA_matrix_to_bin_R(b, gaLookupLink, gaClamp, 
+        gaNumThreads);
+    GAMatrixBin* rBin = GA_matrix_to_bin_R(r, gaLookupNode, gaClamp, 
+        gaNumThreads);
+    SEXP result = R_NilValue;
+    if ((aBin != 0)
+        && (bBin != 0)
+        && (rBin != 0))
+    {
+        if ((rBin->rows != aBin->rows) 
+            || (rBin->cols != bBin->rows))
+            GA_msg()("[GA_update_M_R] "
+                "Node similarity matrix R has wrong dimensions.", 
+                GA_MSG_ERROR);
+        else
+        if (GA_update_M_binned(gaM, aBin, bBin, rBin, gaOldP, gaNewP, 
+            gaLinkScore, gaNodeScore2, gaNumThreads) != 0)
+            result = GA_matrix_to_R_real(gaM);
+    }
+    if (aBin != 0)
+        GA_matrix_destroy_bin(aBin);
+    if (bBin != 0)
+        GA_matrix_destroy_bin(bBin);
+    if (rBin != 0)
+        GA_matrix_destroy_bin(rBin);
+    GA_matrix_destroy_real(gaM);
+    GA_vector_destroy_int(gaOldP);
+    GA_vector_destroy_int(gaNewP);
+    GA_matrix_destroy_real(gaLinkScore);
+    GA_vector_destroy_real(gaNodeScore2);
+    GA_vector_destroy_real(gaLookupLink);
+    GA_vector_destroy_real(gaLookupNode);
+    UNPROTECT(numArgs);
+    return result;
+}
+
+/** Compute score matrix for sparse networks (R).
+ *
+ * Compute the complete score matrix M for networks of which at least one 
+ * is a sparse network (see GA_sparse_R.h). See GA_compute_M_R() for the 
+ * parameters.
+ */
+static SEXP GA_compute_M_sparse_R(SEXP a, SEXP b, SEXP r, SEXP p, 
+    SEXP linkScore, SEXP selfLinkScore, SEXP nodeScore1, SEXP nodeScore2, 
+    SEXP lookupLink, SEXP lookupNode, SEXP clamp, SEXP threads, 
+    SEXP rectangular)
+{
+    GASparseMatrixReal* gaA = GA_sparse_from_R_real(a);
+    if (gaA == 0)
+        return R_NilValue;
+    GASparseMatrixReal* gaB = GA_sparse_from_R_real(b);
+    if (gaB == 0)
+    {
+        GA_sparse_destroy_real(gaA);
+        return R_NilValue;
+    }
+    GAMatrixReal* gaR = GA_matrix_from_R_real(r);
+    GAVectorInt* gaP = GA_vector_from_R_int(p);
+    GAMatrixReal* gaLinkScore = GA_matrix_from_R_real(linkScore);
+    GAMatrixReal* gaSelfLinkScore = GA_matrix_from_R_real(selfLinkScore);
+    GAVectorReal* gaNodeScore1 = GA_vector_from_R_real(nodeScore1);
+    GAVectorReal* gaNodeScore2 = GA_vector_from_R_real(nodeScore2);
+    GAVectorReal* gaLookupLink = GA_vector_from_R_real(lookupLink);
+    GAVectorReal* gaLookupNode = GA_vector_from_R_real(lookupNode);
+    GAMatrixReal* gaResult = 0;
+    if ((gaR != 0)
+        && (gaP != 0)
+        && (gaLinkScore != 0)
+        && (gaSelfLinkScore != 0)
+        && (gaNodeScore1 != 0)
+        && (gaNodeScore2 != 0)
+        && (gaLookupLink != 0)
+        && (gaLookupNode != 0))
+        gaResult = GA_compute_M_sparse(gaA, gaB, gaR, gaP, gaLinkScore, 
+            gaSelfLinkScore, gaNodeScore1, gaNodeScore2, gaLookupLink, 
+            gaLookupNode, GA_clamp_mode_from_R(clamp), 
+            GA_num_threads_from_R(threads), asLogical(rectangular));
+    SEXP result = R_NilValue;
+    if (gaResult != 0)
+    {
+        result = GA_matrix_to_R_real(gaResult);
+        GA_matrix_destroy_real(gaResult);
+    }
+    GA_sparse_destroy_real(gaA);
+    GA_sparse_destroy_real(gaB);
+    if (gaR != 0)
+        GA_matrix_destroy_real(gaR);
+    if (gaP != 0)
+        GA_vector_destroy_int(gaP);
+    if (gaLinkScore != 0)
+        GA_matrix_destroy_real(gaLinkScore);
+    if (gaSelfLinkScore != 0)
+        GA_matrix_destroy_real(gaSelfLinkScore);
+    if (gaNodeScore1 != 0)
+        GA_vector_destroy_real(gaNodeScore1);
+    if (gaNodeScore2 != 0)
+        GA_vector_destroy_real(gaNodeScore2);
+    if (gaLookupLink != 0)
+        GA_vector_destroy_real(gaLookupLink);
+    if (gaLookupNode != 0)
+        GA_vector_destroy_real(gaLookupNode);
+    return result;
+}
+
+SEXP GA_compute_M_R(SEXP a, SEXP b, SEXP r, SEXP p, SEXP linkScore, 
+    SEXP selfLinkScore, SEXP nodeScore1, SEXP nodeScore2, SEXP lookupLink, 
+    SEXP lookupNode, SEXP clamp, SEXP engine, SEXP threads, 
+    SEXP rectangular)
+{
+    PROTECT(a);
+    PROTECT(b);
+    PROTECT(r);
+    PROTECT(p);
+    PROTECT(linkScore);
+    PROTECT(selfLinkScore);
+    PROTECT(nodeScore1);
+    PROTECT(nodeScore2);
+    PROTECT(lookupLink);
+    PROTECT(lookupNode);
+    PROTECT(clamp);
+    PROTECT(engine);
+    PROTECT(threads);
+    PROTECT(rectangular);
+    static const int numArgs = 14;
+    if (GA_sparse_is_R(a)
+        || GA_sparse_is_R(b))
+    {
+        SEXP result = GA_compute_M_sparse_R(a, b, r, p, linkScore, 
+            selfLinkScore, nodeScore1, nodeScore2, lookupLink, lookupNode, 
+            clamp, threads, rectangular);
+        UNPROTECT(numArgs);
+        return result;
+    }
+    /* The networks and the node similarity matrix are binned in place 
+       (see GA_matrix_view_from_R_real()). */
+    if ((TYPEOF(a) != REALSXP)
+        || (TYPEOF(b) != REALSXP)
+        || (TYPEOF(r) != REALSXP))
+    {
+        GA_msg()("[GA_compute_M_R] Networks or node similarity matrix "
+            "not stored as real numbers.", GA_MSG_ERROR);
+        UNPROTECT(numArgs);
+        return R_NilValue;
+    }
+    GAVectorInt* gaP = GA_vector_from_R_int(p);
+    GAMatrixReal* gaLinkScore = GA_matrix_from_R_real(linkScore);
+    GAMatrixReal* gaSelfLinkScore = GA_matrix_from_R_real(selfLinkScore);
+    GAVectorReal* gaNodeScore1 = GA_vector_from_R_real(nodeScore1);
+    GAVectorReal* gaNodeScore2 = GA_vector_from_R_real(nodeScore2);
+    GAVectorReal* gaLookupLink = GA_vector_from_R_real(lookupLink);
+    GAVectorReal* gaLookupNode = GA_vector_from_R_real(lookupNode);
+    if ((gaP == 0)
+        || (gaLinkScore == 0)
+        || (gaSelfLinkScore == 0)
+        || (gaNodeScore1 == 0)
+        || (gaNodeScore2 == 0)
+        || (gaLookupLink == 0)
+        || (gaLookupNode == 0))
+    {
+        UNPROTECT(numArgs);
+        return R_NilValue;
+    }
+    GAClampMode gaClamp = GA_clamp_mode_from_R(clamp);
+    GAComputeEngine gaEngine = GA_compute_engine_from_R(engine);
+    int gaNumThreads = GA_num_threads_from_R(threads);
+    GAMatrixBin* aBin = GA_matrix_to_bin_R(a, gaLookupLink, gaClamp, 
+        gaNumThreads);
+    GAMatrixBin* bBin = GA_matrix_to_bin_R(b, gaLookupLink, gaClamp, 
+        gaNumThreads);
+    GAMatrixBin* rBin = GA_matrix_to_bin_R(r, gaLookupNode, gaClamp, 
+        gaNumThreads);
+    SEXP result = R_NilValue;
+    if ((aBin != 0)
+        && (bBin != 0)
+        && (rBin != 0))
+    {
+        GAMatrixReal* gaResult = GA_compute_M_binned(0, aBin, bBin, rBin, 
+            gaP, gaLinkScore, gaSelfLinkScore, gaNodeScore1, gaNodeScore2, 
+            gaLookupLink, gaLookupNode, gaEngine, gaNumThreads, 
+            asLogical(rectangular));
+        if (gaResult != 0)
+        {
+            result = GA_matrix_to_R_real(gaResult);
+            GA_matrix_destroy_real(gaResult);
+        }
+    }
+    if (aBin != 0)
+        GA_matrix_destroy_bin(aBin);
+    if (bBin != 0)
+        GA_matrix_destroy_bin(bBin);
+    if (rBin != 0)
+        GA_matrix_destroy_bin(rBin);
+    GA_vector_destroy_int(gaP);
+    GA_matrix_destroy_real(gaLinkScore);
+    GA_matrix_destroy_real(gaSelfLinkScore);
+    GA_vector_destroy_real(gaNodeScore1);
+    GA_vector_destroy_real(gaNodeScore2);
+    GA_vector_destroy_real(gaLookupLink);
+    GA_vector_destroy_real(gaLookupNode);
+    UNPROTECT(numArgs);
+    return result;
+}
+
+/** Initialize alignment problem from R objects.
+ *
+ * Initialize an empty alignment problem from R objects (see 
+ * GA_align_networks_R() for the parameters). The networks and the node 
+ * similarity matrix are binned, except for directed networks, which are 
+ * binned after they have been encoded for an alignment. The alignment 
+ * problem keeps the data which has been set up before an error occurs, so 
+ * it has to be destroyed by the caller in any case.
+ *
+ * \param problem alignment problem (see GA_align_problem_create())
+ *
+ * \return 1 on success, or 0 if an error occurs
+ */
+static int GA_align_problem_init_R(GAAlignProblem* problem, SEXP a, SEXP b, 
+    SEXP r, SEXP linkScore, SEXP selfLinkScore, SEXP nodeScore1, 
+    SEXP nodeScore2, SEXP lookupLink, SEXP lookupNode, SEXP clamp, 
+    SEXP directed, SEXP engine, SEXP threads, SEXP candidates, 
+    SEXP rectangular, SEXP precision)
+{
+    /* Dense undirected networks and the node similarity matrix are binned 
+       in place (see GA_matrix_view_from_R_real()). */
+    int dense = !(GA_sparse_is_R(a) 
+        || GA_sparse_is_R(b));
+    if ((TYPEOF(r) != REALSXP)
+        || (dense 
+            && (GA_directed_mode_from_R(directed) != GA_DIRECTED_ENABLED)
+            && ((TYPEOF(a) != REALSXP)
+                || (TYPEOF(b) != REALSXP))))
+    {
+        GA_msg()("[GA_align_problem_from_R] Networks or node similarity "
+            "matrix not stored as real numbers.", GA_MSG_ERROR);
+        return 0;
+    }
+    problem->linkScore = GA_matrix_from_R_real(linkScore);
+    problem->selfLinkScore = GA_matrix_from_R_real(selfLinkScore);
+    problem->nodeScore1 = GA_vector_from_R_real(nodeScore1);
+    problem->nodeScore2 = GA_vector_from_R_real(nodeScore2);
+    problem->lookupLink = GA_vector_from_R_real(lookupLink);
+    problem->lookupNode = GA_vector_from_R_real(lookupNode);
+    problem->clamp = GA_clamp_mode_from_R(clamp);
+    problem->directed = GA_directed_mode_from_R(directed);
+    problem->engine = GA_compute_engine_from_R(engine);
+    problem->numThreads = GA_num_threads_from_R(threads);
+    problem->rectangular = (asLogical(rectangular) == TRUE);
+    problem->precision = GA_precision_from_R(precision);
+    if ((problem->linkScore == 0)
+        || (problem->selfLinkScore == 0)
+        || (problem->nodeScore1 == 0)
+        || (problem->nodeScore2 == 0)
+        || (problem->lookupLink == 0)
+        || (problem->lookupNode == 0))
+        return 0;
+    problem->rBin = GA_matrix_to_bin_R(r, problem->lookupNode, 
+        problem->clamp, problem->numThreads);
+    int sparse = (GA_sparse_is_R(a) 
+        || GA_sparse_is_R(b));
+    int ok;
+    if (problem->directed == GA_DIRECTED_ENABLED)
+    {
+        /* Directed networks are encoded and binned in each step. */
+        if (sparse)
+        {
+            problem->aSparse = GA_sparse_from_R_real(a);
+            problem->bSparse = GA_sparse_from_R_real(b);
+            ok = ((problem->aSparse != 0)
+                && (problem->bSparse != 0));
+        } else
+        {
+            problem->a = GA_matrix_from_R_real(a);
+            problem->b = GA_matrix_from_R_real(b);
+            ok = ((problem->a != 0)
+                && (problem->b != 0));
+        }
+    } else
+    if (sparse)
+    {
+        GASparseMatrixReal* gaA = GA_sparse_from_R_real(a);
+        if (gaA != 0)
+        {
+            problem->aSparseBin = GA_sparse_to_bin_real(gaA, 
+                problem->lookupLink, problem->clamp);
+            GA_sparse_destroy_real(gaA);
+        }
+        GASparseMatrixReal* gaB = GA_sparse_from_R_real(b);
+        if (gaB != 0)
+        {
+            problem->bSparseBin = GA_sparse_to_bin_real(gaB, 
+                problem->lookupLink, problem->clamp);
+            GA_sparse_destroy_real(gaB);
+        }
+        ok = ((problem->aSparseBin != 0)
+            && (problem->bSparseBin != 0));
+    } else
+    {
+        problem->aBin = GA_matrix_to_bin_R(a, problem->lookupLink, 
+            problem->clamp, problem->numThreads);
+        problem->bBin = GA_matrix_to_bin_R(b, problem->lookupLink, 
+            problem->clamp, problem->numThreads);
+        ok = ((problem->aBin != 0)
+            && (problem->bBin != 0));
+    }
+    if (ok 
+        && (candidates != R_NilValue))
+    {
+        problem->candidates = GA_sparse_from_R_real(candidates);
+        ok = (problem->candidates != 0);
+    }
+    return (ok 
+        && (problem->rBin != 0));
+}
+
+/** Create alignment problem from R objects.
+ *
+ * Create an alignment problem from R objects (see 
+ * GA_align_problem_init_R()). The new alignment problem should be 
+ * destroyed by using GA_align_problem_destroy() when it is not needed 
+ * anymore.
+ *
+ * \return alignment problem, or 0 if an error occurs
+ */
+static GAAlignProblem* GA_align_problem_from_R(SEXP a, SEXP b, SEXP r, 
+    SEXP linkScore, SEXP selfLinkScore, SEXP nodeScore1, SEXP nodeScore2, 
+    SEXP lookupLink, SEXP lookupNode, SEXP clamp, SEXP directed, 
+    SEXP engine, SEXP threads, SEXP candidates, SEXP rectangular, 
+    SEXP precision)
+{
+    GAAlignProblem* problem = GA_align_problem_create();
+    if (problem == 0)
+        return 0;
+    if (!GA_align_problem_init_R(problem, a, b, r, linkScore, 
+        selfLinkScore, nodeScore1, nodeScore2, lookupLink, lookupNode, 
+        clamp, directed, engine, threads, candidates, rectangular, 
+        precision))
+    {
+        GA_align_problem_destroy(problem);
+        return 0;
+    }
+    return problem;
+}
+
+/** Arguments for GA_align_networks_exec_R().
+ */
+typedef struct
+{
+    /** Alignment problem.
+     */
+    GAAlignProblem* problem;
+    /** Initial permutation vector.
+     */
+    GAVectorInt* p;
+    /** Initial inverse noise level.
+     */
+    double bStart;
+    /** Final inverse noise level.
+     */
+    double bEnd;
+    /** Number of steps.
+     */
+    int maxNumSteps;
+    /** Warm start the linear assignment solver.
+     */
+    int warmStart;
+    /** Release the arena of the problem afterwards.
+     */
+    int releaseArena;
+    /** Position of the arena at the start of each step.
+     */
+    GAArenaMark mark;
+    /** Final permutation vector.
+     */
+    GAVectorInt* result;
+} GAAlignNetworksArgs;
+
+/** Align networks (R helper).
+ *
+ * \param data arguments (GAAlignNetworksArgs)
+ *
+ * \return \c R_NilValue
+ */
+static SEXP GA_align_networks_exec_R(void* data)
+{
+    GAAlignNetworksArgs* args = (GAAlignNetworksArgs*)data;
+    args->result = GA_align_networks(args->problem, args->p, args->bStart, 
+        args->bEnd, args->maxNumSteps, args->warmStart);
+    return R_NilValue;
+}
+
+/** Clean up after aligning networks.
+ *
+ * If an R error is raised during a step of GA_align_networks(), the arena 
+ * of the problem is still active and holds the allocations of the step, 
+ * so the allocation functions are restored and the arena is reset to the 
+ * mark of the step here. The arena of a problem which is only used for 
+ * one call is released.
+ *
+ * \param data arguments (GAAlignNetworksArgs)
+ */
+static void GA_align_networks_cleanup_R(void* data)
+{
+    GAAlignNetworksArgs* args = (GAAlignNetworksArgs*)data;
+    GAArena* arena = args->problem->arena;
+    if (arena == 0)
+        return;
+    if (GA_arena_get_active() == arena)
+        GA_arena_deactivate(arena);
+    GA_arena_reset(arena, args->mark);
+    if (args->releaseArena)
+    {
+        GA_arena_destroy(arena);
+        args->problem->arena = 0;
+    }
+}
+
+/** Align networks (R helper).
+ *
+ * Call GA_align_networks() so that the allocation functions are restored 
+ * even if an R error is raised.
+ *
+ * \param args arguments
+ *
+ * \return the final permutation vector, or 0 if an error occurs
+ */
+static GAVectorInt* GA_align_networks_with_cleanup_R( 
+    GAAlignNetworksArgs* args)
+{
+    args->result = 0;
+    /* Each step resets the arena to the position it had before the call, 
+       or to its beginning if it is created by the call. */
+    if (args->problem->arena != 0)
+        args->mark = GA_arena_mark(args->problem->arena);
+    else
     {
-        for (j = 0; j < p->size; j++)
-        {
-            int k;
-            /* Sum up link scores. */
-            /* ----- DEBUG ----- //
-            char* message = GA_alloc(256, sizeof(char));
-            snprintf(message, 256, "[GA_compute_M] "
-                "Calculating link scores for M(%i, %i)...\n", i, j);
-            GA_msg()(message, GA_MSG_DEBUG);
-            // ----- DEBUG ----- */
-            double linkScoreSum = 0.0;
-            if ((i < b->rows)
-                && (j < a->rows))
-                for (k = 0; k < a->rows; k++)
-                {
-                    if ((k != j)
-                        && (p->elts[k] != i)
-                        && (p->elts[k] < b->rows))
-                    {
-                        /* ----- DEBUG ----- //
-                        snprintf(message, 256, "[GA_compute_M] "
-                            "(i, j, k, p[k], aBin->elts[j][k], "
-                            "bBin->elts[i][p->elts[k]]) = "
-                            "(%i, %i, %i, %i, %i, %i)\n", 
-                            i, j, k, p->elts[k], aBin->elts[j][k], 
-                            bBin->elts[i][p->elts[k]]);
-                        GA_msg()(message, GA_MSG_DEBUG);
-                        // ----- DEBUG ----- */
-                        linkScoreSum += linkScore->elts[aBin->elts[j][k]]
-                            [bBin->elts[i][p->elts[k]]];
-                    }
-                }
-            /* Sum up self link scores. */
-            /* ----- DEBUG ----- //
-            snprintf(message, 256, "[GA_compute_M] "
-                "Calculating self link scores for M(%i, %i)...\n", i, j);
-            GA_msg()(message, GA_MSG_DEBUG);
-            // ----- DEBUG ----- */
-            double selfLinkScoreSum = 0.0;
-            if ((i < b->rows)
-                && (j < a->rows))
-            {
-                selfLinkScoreSum += selfLinkScore->elts[aBin->elts[j][j]]
-                    [bBin->elts[i][i]];
-            }
-            /* Sum up node similarity scores. */
-            /* ----- DEBUG ----- //
-            snprintf(message, 256, "[GA_compute_M] "
-                "Calculating node scores for M(%i, %i)...\n", i, j);
-            GA_msg()(message, GA_MSG_DEBUG);
-            // ----- DEBUG ----- */
-            double nodeScoreSum = 0.0;
-            if ((i < b->rows)
-                && (j < a->rows))
-            {
-                nodeScoreSum += nodeScore1->elts[rBin->elts[j][i]];
-                for (k = 0; k < a->rows; k++)
-                {
-                    if ((p->elts[k] >= b->rows)
-                        && (k != j))
-                        nodeScoreSum += nodeScore2->elts[rBin->elts[k][i]];
-                }
-                for (k = 0; k < b->rows; k++)
-                {
-                    if ((pInv->elts[k] >= a->rows)
-                        && (k != i))
-                        nodeScoreSum += nodeScore2->elts[rBin->elts[j][k]];
-                }
-            }
-            /* Set the element of M. */
-            result->elts[i][j] = linkScoreSum + selfLinkScoreSum 
-                + nodeScoreSum;
-            /* ----- DEBUG ----- //
-            linkScoreResult->elts[i][j] = linkScoreSum;
-            selfLinkScoreResult->elts[i][j] = selfLinkScoreSum;
-            nodeScoreResult->elts[i][j] = nodeScoreSum;
-            // ----- DEBUG ----- */
-        }
+        args->mark.block = 0;
+        args->mark.used = 0;
     }
-    /* ----- DEBUG ----- //
-    GA_msg()("[GA_compute_M] Link score result:\n", GA_MSG_DEBUG);
-    GA_matrix_print_real(linkScoreResult);
-    GA_msg()("\n", GA_MSG_INFO);
-    GA_msg()("[GA_compute_M] Self link score result:\n", GA_MSG_DEBUG);
-    GA_matrix_print_real(selfLinkScoreResult);
-    GA_msg()("\n", GA_MSG_INFO);
-    GA_msg()("[GA_compute_M] Node score result:\n", GA_MSG_DEBUG);
-    GA_matrix_print_real(nodeScoreResult);
-    GA_msg()("\n", GA_MSG_INFO);
-    GA_matrix_destroy_real(linkScoreResult);
-    GA_matrix_destroy_real(selfLinkScoreResult);
-    GA_matrix_destroy_real(nodeScoreResult);
-    GA_msg()("[GA_compute_M] Done.\n", GA_MSG_DEBUG);
-    // ----- DEBUG ----- */
-    GA_vector_destroy_int(pInv);
-    GA_matrix_destroy_int(aBin);
-    GA_matrix_destroy_int(bBin);
-    GA_matrix_destroy_int(rBin);
-    return result;
+    R_ExecWithCleanup(GA_align_networks_exec_R, args, 
+        GA_align_networks_cleanup_R, args);
+    return args->result;
 }
 
-SEXP GA_compute_M_R(SEXP a, SEXP b, SEXP r, SEXP p, SEXP linkScore, 
+SEXP GA_align_networks_R(SEXP a, SEXP b, SEXP r, SEXP p, SEXP linkScore, 
     SEXP selfLinkScore, SEXP nodeScore1, SEXP nodeScore2, SEXP lookupLink, 
-    SEXP lookupNode, SEXP clamp)
+    SEXP lookupNode, SEXP bStart, SEXP bEnd, SEXP maxNumSteps, SEXP clamp, 
+    SEXP directed, SEXP engine, SEXP threads, SEXP warmStart, 
+    SEXP candidates, SEXP lapEngine, SEXP tolerance, SEXP rectangular, 
+    SEXP precision)
 {
     PROTECT(a);
     PROTECT(b);
@@ -509,129 +3293,476 @@ SEXP GA_compute_M_R(SEXP a, SEXP b, SEXP r, SEXP p, SEXP linkScore,
     PROTECT(nodeScore2);
     PROTECT(lookupLink);
     PROTECT(lookupNode);
+    PROTECT(bStart);
+    PROTECT(bEnd);
+    PROTECT(maxNumSteps);
     PROTECT(clamp);
-    static const int numArgs = 11;
-    GAMatrixReal* gaA = GA_matrix_from_R_real(a);
-    if (gaA == 0)
+    PROTECT(directed);
+    PROTECT(engine);
+    PROTECT(threads);
+    PROTECT(warmStart);
+    PROTECT(candidates);
+    PROTECT(lapEngine);
+    PROTECT(tolerance);
+    PROTECT(rectangular);
+    PROTECT(precision);
+    static const int numArgs = 23;
+    GAVectorInt* gaP = GA_vector_from_R_int(p);
+    if (gaP == 0)
     {
         UNPROTECT(numArgs);
         return R_NilValue;
     }
-    GAMatrixReal* gaB = GA_matrix_from_R_real(b);
-    if (gaB == 0)
+    GAAlignProblem* problem = GA_align_problem_from_R(a, b, r, linkScore, 
+        selfLinkScore, nodeScore1, nodeScore2, lookupLink, lookupNode, 
+        clamp, directed, engine, threads, candidates, rectangular, 
+        precision);
+    SEXP result = R_NilValue;
+    if (problem != 0)
     {
-        GA_matrix_destroy_real(gaA);
-        UNPROTECT(numArgs);
-        return R_NilValue;
+        problem->assignmentEngine = GA_assignment_engine_from_R(lapEngine);
+        problem->tolerance = asReal(tolerance);
+        GAAlignNetworksArgs args;
+        args.problem = problem;
+        args.p = gaP;
+        args.bStart = asReal(bStart);
+        args.bEnd = asReal(bEnd);
+        args.maxNumSteps = asInteger(maxNumSteps);
+        args.warmStart = (asLogical(warmStart) == TRUE);
+        args.releaseArena = 1;
+        GAVectorInt* gaResult = GA_align_networks_with_cleanup_R(&args);
+        if (gaResult != 0)
+        {
+            result = GA_vector_to_R_int(gaResult);
+            GA_vector_destroy_int(gaResult);
+        }
+        GA_align_problem_destroy(problem);
     }
-    GAMatrixReal* gaR = GA_matrix_from_R_real(r);
-    if (gaR == 0)
+    GA_vector_destroy_int(gaP);
+    UNPROTECT(numArgs);
+    return result;
+}
+
+/** Allocation functions.
+ *
+ * Allocation functions which are restored by GA_restore_alloc_funcs_R().
+ */
+typedef struct
+{
+    /** Allocation function.
+     */
+    GAAllocFunc allocFunc;
+    /** Freeing function.
+     */
+    GAFreeFunc freeFunc;
+} GAAllocFuncs;
+
+/** Restore allocation functions.
+ *
+ * \param data allocation functions (GAAllocFuncs)
+ */
+static void GA_restore_alloc_funcs_R(void* data)
+{
+    GAAllocFuncs* funcs = (GAAllocFuncs*)data;
+    GA_set_alloc_funcs(funcs->allocFunc, funcs->freeFunc);
+}
+
+/** Execute function with persistent allocation.
+ *
+ * Execute a function while the allocation functions are set to 
+ * <tt>calloc()</tt> and <tt>free()</tt>, so that the memory which is 
+ * allocated by the function is not released at the end of the current 
+ * call from R. The previous allocation functions are restored afterwards, 
+ * even if the function raises an R error.
+ *
+ * \param func function
+ * \param data data which is passed to the function
+ *
+ * \return the result of the function
+ */
+static SEXP GA_exec_persistent_R(SEXP (*func)(void*), void* data)
+{
+    GAAllocFuncs funcs;
+    funcs.allocFunc = GA_get_alloc_func();
+    funcs.freeFunc = GA_get_free_func();
+    GA_set_alloc_funcs((GAAllocFunc)calloc, (GAFreeFunc)free);
+    return R_ExecWithCleanup(func, data, GA_restore_alloc_funcs_R, &funcs);
+}
+
+/** Destroy alignment problem (R finalizer).
+ *
+ * \param context external pointer to the alignment problem
+ */
+static void GA_align_problem_finalize_R(SEXP context)
+{
+    GAAlignProblem* problem = (GAAlignProblem*)R_ExternalPtrAddr(context);
+    if (problem == 0)
+        return;
+    GAAllocFuncs funcs;
+    funcs.allocFunc = GA_get_alloc_func();
+    funcs.freeFunc = GA_get_free_func();
+    GA_set_alloc_funcs((GAAllocFunc)calloc, (GAFreeFunc)free);
+    GA_align_problem_destroy(problem);
+    GA_restore_alloc_funcs_R(&funcs);
+    R_ClearExternalPtr(context);
+}
+
+/** Get alignment problem from external pointer.
+ *
+ * \param context external pointer to an alignment problem
+ *
+ * \return alignment problem, or 0 if an error occurs
+ */
+static GAAlignProblem* GA_align_problem_from_ptr_R(SEXP context)
+{
+    if ((TYPEOF(context) != EXTPTRSXP)
+        || (R_ExternalPtrAddr(context) == 0))
     {
-        GA_matrix_destroy_real(gaA);
-        GA_matrix_destroy_real(gaB);
-        UNPROTECT(numArgs);
+        GA_msg()("[GA_align_problem_from_ptr_R] "
+            "Invalid prepared alignment.", GA_MSG_ERROR);
+        return 0;
+    }
+    return (GAAlignProblem*)R_ExternalPtrAddr(context);
+}
+
+/** Arguments of GA_prepare_alignment_R().
+ */
+typedef struct
+{
+    /** Arguments (see GA_prepare_alignment_R()).
+     */
+    SEXP args[16];
+    /** Alignment problem until it is owned by the external pointer.
+     */
+    GAAlignProblem* problem;
+} GAPrepareAlignmentArgs;
+
+/** Create prepared alignment (R helper).
+ *
+ * \param data arguments (GAPrepareAlignmentArgs)
+ *
+ * \return external pointer to the alignment problem
+ */
+static SEXP GA_prepare_alignment_init_R(void* data)
+{
+    GAPrepareAlignmentArgs* prepareArgs = (GAPrepareAlignmentArgs*)data;
+    SEXP* args = prepareArgs->args;
+    GAAlignProblem* problem = GA_align_problem_create();
+    if (problem == 0)
+        return R_NilValue;
+    prepareArgs->problem = problem;
+    if (!GA_align_problem_init_R(problem, args[0], args[1], args[2], 
+        args[3], args[4], args[5], args[6], args[7], args[8], args[9], 
+        args[10], args[11], args[12], args[13], args[14], args[15]))
         return R_NilValue;
+    SEXP result;
+    PROTECT(result = R_MakeExternalPtr(problem, R_NilValue, R_NilValue));
+    R_RegisterCFinalizerEx(result, GA_align_problem_finalize_R, TRUE);
+    prepareArgs->problem = 0;
+    UNPROTECT(1);
+    return result;
+}
+
+/** Clean up after creating a prepared alignment.
+ *
+ * The alignment problem is allocated persistently, so it is destroyed 
+ * here if an error occurs before it is owned by the external pointer. 
+ * This includes R errors, which are raised by GA_msg_R().
+ *
+ * \param data arguments (GAPrepareAlignmentArgs)
+ */
+static void GA_prepare_alignment_cleanup_R(void* data)
+{
+    GAPrepareAlignmentArgs* args = (GAPrepareAlignmentArgs*)data;
+    if (args->problem != 0)
+    {
+        GA_align_problem_destroy(args->problem);
+        args->problem = 0;
     }
+}
+
+/** Create prepared alignment.
+ *
+ * \param data arguments (GAPrepareAlignmentArgs)
+ *
+ * \return external pointer to the alignment problem
+ */
+static SEXP GA_prepare_alignment_exec_R(void* data)
+{
+    return R_ExecWithCleanup(GA_prepare_alignment_init_R, data, 
+        GA_prepare_alignment_cleanup_R, data);
+}
+
+SEXP GA_prepare_alignment_R(SEXP a, SEXP b, SEXP r, SEXP linkScore, 
+    SEXP selfLinkScore, SEXP nodeScore1, SEXP nodeScore2, SEXP lookupLink, 
+    SEXP lookupNode, SEXP clamp, SEXP directed, SEXP engine, SEXP threads, 
+    SEXP candidates, SEXP rectangular, SEXP precision)
+{
+    GAPrepareAlignmentArgs args = {{ a, b, r, linkScore, selfLinkScore, 
+        nodeScore1, nodeScore2, lookupLink, lookupNode, clamp, directed, 
+        engine, threads, candidates, rectangular, precision }, 0 };
+    return GA_exec_persistent_R(GA_prepare_alignment_exec_R, &args);
+}
+
+SEXP GA_prepared_compute_M_R(SEXP context, SEXP p, SEXP m0, SEXP p0)
+{
+    PROTECT(context);
+    PROTECT(p);
+    PROTECT(m0);
+    PROTECT(p0);
+    static const int numArgs = 4;
+    GAAlignProblem* problem = GA_align_problem_from_ptr_R(context);
     GAVectorInt* gaP = GA_vector_from_R_int(p);
-    if (gaP == 0)
+    if ((problem == 0)
+        || (gaP == 0))
     {
-        GA_matrix_destroy_real(gaA);
-        GA_matrix_destroy_real(gaB);
-        GA_matrix_destroy_real(gaR);
         UNPROTECT(numArgs);
         return R_NilValue;
     }
-    GAMatrixReal* gaLinkScore = GA_matrix_from_R_real(linkScore);
-    if (gaLinkScore == 0)
+    GAMatrixReal* gaM0 = 0;
+    GAVectorInt* gaP0 = 0;
+    if ((problem->precision == GA_PRECISION_SINGLE)
+        && ((m0 == R_NilValue)
+            || (p0 == R_NilValue)))
     {
-        GA_matrix_destroy_real(gaA);
-        GA_matrix_destroy_real(gaB);
-        GA_matrix_destroy_real(gaR);
+        /* M is only converted to double precision for R. */
+        GAMatrixFloat* gaResultFloat = GA_align_problem_compute_M_float( 
+            problem, gaP, 0, 0);
+        SEXP result = R_NilValue;
+        if (gaResultFloat != 0)
+        {
+            result = GA_matrix_to_R_float(gaResultFloat);
+            GA_matrix_destroy_float(gaResultFloat);
+        }
         GA_vector_destroy_int(gaP);
+        UNPROTECT(numArgs);
+        return result;
+    }
+    if ((m0 != R_NilValue)
+        && (p0 != R_NilValue))
+    {
+        gaM0 = GA_matrix_from_R_real(m0);
+        gaP0 = GA_vector_from_R_int(p0);
+    }
+    GAMatrixReal* gaResult = GA_align_problem_compute_M(problem, gaP, gaM0, 
+        gaP0);
+    SEXP result = R_NilValue;
+    if (gaResult != 0)
+        result = GA_matrix_to_R_real(gaResult);
+    /* The result is either a new matrix or the updated matrix gaM0. */
+    if ((gaResult != 0)
+        && (gaResult != gaM0))
+        GA_matrix_destroy_real(gaResult);
+    if (gaM0 != 0)
+        GA_matrix_destroy_real(gaM0);
+    if (gaP0 != 0)
+        GA_vector_destroy_int(gaP0);
+    GA_vector_destroy_int(gaP);
+    UNPROTECT(numArgs);
+    return result;
+}
+
+SEXP GA_prepared_compute_scores_R(SEXP context, SEXP p, SEXP symmetric)
+{
+    PROTECT(context);
+    PROTECT(p);
+    PROTECT(symmetric);
+    static const int numArgs = 3;
+    GAAlignProblem* problem = GA_align_problem_from_ptr_R(context);
+    GAVectorInt* gaP = GA_vector_from_R_int(p);
+    if ((problem == 0)
+        || (gaP == 0))
+    {
         UNPROTECT(numArgs);
         return R_NilValue;
     }
-    GAMatrixReal* gaSelfLinkScore = GA_matrix_from_R_real(selfLinkScore);
-    if (gaSelfLinkScore == 0)
+    GAVectorReal* gaResult = GA_align_problem_compute_scores(problem, gaP, 
+        asLogical(symmetric) == TRUE);
+    SEXP result = R_NilValue;
+    if (gaResult != 0)
+    {
+        result = GA_vector_to_R_real(gaResult);
+        GA_vector_destroy_real(gaResult);
+    }
+    GA_vector_destroy_int(gaP);
+    UNPROTECT(numArgs);
+    return result;
+}
+
+/** Arguments of GA_prepared_cost_buffer_exec_R().
+ */
+typedef struct
+{
+    /** Alignment problem.
+     */
+    GAAlignProblem* problem;
+    /** Size of the cost matrix.
+     */
+    int size;
+    /** Whether the cost matrix is real.
+     */
+    int real;
+} GACostBufferArgs;
+
+/** Reallocate cost matrix buffer.
+ *
+ * Reallocate the cost matrix buffer for the requested type, and the 
+ * solver state if its size does not match.
+ *
+ * \param data arguments (GACostBufferArgs)
+ *
+ * \return \c NULL
+ */
+static SEXP GA_prepared_cost_buffer_exec_R(void* data)
+{
+    GACostBufferArgs* args = (GACostBufferArgs*)data;
+    GAAlignProblem* problem = args->problem;
+    if (args->real)
+    {
+        if (problem->costReal != 0)
+            GA_matrix_destroy_real(problem->costReal);
+        problem->costReal = GA_matrix_create_square_real(args->size);
+    } else
+    {
+        if (problem->cost != 0)
+            GA_matrix_destroy_int(problem->cost);
+        problem->cost = GA_matrix_create_square_int(args->size);
+    }
+    if ((problem->lapState != 0)
+        && (problem->lapState->rowSol->size != args->size))
+    {
+        GA_linear_assignment_state_destroy(problem->lapState);
+        problem->lapState = 0;
+    }
+    if (problem->lapState == 0)
+        problem->lapState = GA_linear_assignment_state_create(args->size);
+    return R_NilValue;
+}
+
+SEXP GA_prepared_linear_assignment_R(SEXP context, SEXP costMatrix, 
+    SEXP warmStart, SEXP real)
+{
+    PROTECT(context);
+    PROTECT(costMatrix);
+    PROTECT(warmStart);
+    PROTECT(real);
+    static const int numArgs = 4;
+    GAAlignProblem* problem = GA_align_problem_from_ptr_R(context);
+    if (problem == 0)
     {
-        GA_matrix_destroy_real(gaA);
-        GA_matrix_destroy_real(gaB);
-        GA_matrix_destroy_real(gaR);
-        GA_vector_destroy_int(gaP);
-        GA_matrix_destroy_real(gaLinkScore);
         UNPROTECT(numArgs);
         return R_NilValue;
     }
-    GAVectorReal* gaNodeScore1 = GA_vector_from_R_real(nodeScore1);
-    if (gaNodeScore1 == 0)
+    SEXP dim = GET_DIM(costMatrix);
+    if (LENGTH(dim) != 2)
     {
-        GA_matrix_destroy_real(gaA);
-        GA_matrix_destroy_real(gaB);
-        GA_matrix_destroy_real(gaR);
-        GA_vector_destroy_int(gaP);
-        GA_matrix_destroy_real(gaLinkScore);
-        GA_matrix_destroy_real(gaSelfLinkScore);
+        GA_msg()("[GA_prepared_linear_assignment_R] "
+            "Cost matrix is not a two-dimensional matrix.", GA_MSG_ERROR);
         UNPROTECT(numArgs);
         return R_NilValue;
     }
-    GAVectorReal* gaNodeScore2 = GA_vector_from_R_real(nodeScore2);
-    if (gaNodeScore2 == 0)
+    /* The cost buffers are square, so a rectangular cost matrix would be 
+       read with the wrong dimensions. */
+    if (INTEGER(dim)[0] != INTEGER(dim)[1])
     {
-        GA_matrix_destroy_real(gaA);
-        GA_matrix_destroy_real(gaB);
-        GA_matrix_destroy_real(gaR);
-        GA_vector_destroy_int(gaP);
-        GA_matrix_destroy_real(gaLinkScore);
-        GA_matrix_destroy_real(gaSelfLinkScore);
-        GA_vector_destroy_real(gaNodeScore1);
+        GA_msg()("[GA_prepared_linear_assignment_R] "
+            "Cost matrix is not square.", GA_MSG_ERROR);
         UNPROTECT(numArgs);
         return R_NilValue;
     }
-    GAVectorReal* gaLookupLink = GA_vector_from_R_real(lookupLink);
-    if (gaLookupLink == 0)
+    int size = INTEGER(dim)[0];
+    int useReal = (asLogical(real) == TRUE);
+    int bufferSize = -1;
+    if (useReal 
+        && (problem->costReal != 0))
+        bufferSize = problem->costReal->rows;
+    if (!useReal 
+        && (problem->cost != 0))
+        bufferSize = problem->cost->rows;
+    if ((bufferSize != size)
+        || (problem->lapState == 0)
+        || (problem->lapState->rowSol->size != size))
+    {
+        GACostBufferArgs args;
+        args.problem = problem;
+        args.size = size;
+        args.real = useReal;
+        GA_exec_persistent_R(GA_prepared_cost_buffer_exec_R, &args);
+    }
+    if (problem->lapState == 0)
     {
-        GA_matrix_destroy_real(gaA);
-        GA_matrix_destroy_real(gaB);
-        GA_matrix_destroy_real(gaR);
-        GA_vector_destroy_int(gaP);
-        GA_matrix_destroy_real(gaLinkScore);
-        GA_matrix_destroy_real(gaSelfLinkScore);
-        GA_vector_destroy_real(gaNodeScore1);
-        GA_vector_destroy_real(gaNodeScore2);
         UNPROTECT(numArgs);
         return R_NilValue;
     }
-    GAVectorReal* gaLookupNode = GA_vector_from_R_real(lookupNode);
-    if (gaLookupNode == 0)
+    /* The state is kept up to date, so that a warm start can follow a 
+       cold start. */
+    if (asLogical(warmStart) != TRUE)
+        problem->lapState->valid = 0;
+    GAVectorInt* gaResult = 0;
+    if (useReal)
+    {
+        if ((problem->costReal != 0)
+            && (GA_matrix_init_from_R_real(problem->costReal, costMatrix) 
+                != 0))
+            gaResult = GA_linear_assignment_solve_warm_real(
+                problem->costReal, problem->lapState);
+    } else
+    {
+        if ((problem->cost != 0)
+            && (GA_matrix_init_from_R_int(problem->cost, costMatrix) != 0))
+            gaResult = GA_linear_assignment_solve_warm(problem->cost, 
+                problem->lapState);
+    }
+    SEXP result = R_NilValue;
+    if (gaResult != 0)
+    {
+        result = GA_vector_to_R_int(gaResult);
+        GA_vector_destroy_int(gaResult);
+    }
+    UNPROTECT(numArgs);
+    return result;
+}
+
+SEXP GA_prepared_align_networks_R(SEXP context, SEXP p, SEXP bStart, 
+    SEXP bEnd, SEXP maxNumSteps, SEXP warmStart, SEXP lapEngine, 
+    SEXP tolerance)
+{
+    PROTECT(context);
+    PROTECT(p);
+    PROTECT(bStart);
+    PROTECT(bEnd);
+    PROTECT(maxNumSteps);
+    PROTECT(warmStart);
+    PROTECT(lapEngine);
+    PROTECT(tolerance);
+    static const int numArgs = 8;
+    GAAlignProblem* problem = GA_align_problem_from_ptr_R(context);
+    GAVectorInt* gaP = GA_vector_from_R_int(p);
+    if ((problem == 0)
+        || (gaP == 0))
     {
-        GA_matrix_destroy_real(gaA);
-        GA_matrix_destroy_real(gaB);
-        GA_matrix_destroy_real(gaR);
-        GA_vector_destroy_int(gaP);
-        GA_matrix_destroy_real(gaLinkScore);
-        GA_matrix_destroy_real(gaSelfLinkScore);
-        GA_vector_destroy_real(gaNodeScore1);
-        GA_vector_destroy_real(gaNodeScore2);
-        GA_vector_destroy_real(gaLookupLink);
         UNPROTECT(numArgs);
         return R_NilValue;
     }
-    GAClampMode gaClamp = GA_clamp_mode_from_R(clamp);
-    GAMatrixReal* gaResult = GA_compute_M(gaA, gaB, gaR, gaP, gaLinkScore, 
-        gaSelfLinkScore, gaNodeScore1, gaNodeScore2, gaLookupLink,
-        gaLookupNode, gaClamp);
-    SEXP result = GA_matrix_to_R_real(gaResult);
-    GA_matrix_destroy_real(gaResult);
-    GA_matrix_destroy_real(gaA);
-    GA_matrix_destroy_real(gaB);
-    GA_matrix_destroy_real(gaR);
+    problem->assignmentEngine = GA_assignment_engine_from_R(lapEngine);
+    problem->tolerance = asReal(tolerance);
+    /* The arena is kept with the prepared alignment for the next call. */
+    GAAlignNetworksArgs args;
+    args.problem = problem;
+    args.p = gaP;
+    args.bStart = asReal(bStart);
+    args.bEnd = asReal(bEnd);
+    args.maxNumSteps = asInteger(maxNumSteps);
+    args.warmStart = (asLogical(warmStart) == TRUE);
+    args.releaseArena = 0;
+    GAVectorInt* gaResult = GA_align_networks_with_cleanup_R(&args);
+    SEXP result = R_NilValue;
+    if (gaResult != 0)
+    {
+        result = GA_vector_to_R_int(gaResult);
+        GA_vector_destroy_int(gaResult);
+    }
     GA_vector_destroy_int(gaP);
-    GA_matrix_destroy_real(gaLinkScore);
-    GA_matrix_destroy_real(gaSelfLinkScore);
-    GA_vector_destroy_real(gaNodeScore1);
-    GA_vector_destroy_real(gaNodeScore2);
-    GA_vector_destroy_real(gaLookupLink);
-    GA_vector_destroy_real(gaLookupNode);
     UNPROTECT(numArgs);
     return result;
 }
@@ -644,16 +3775,91 @@ R_CallMethodDef GA_callMethods[] = {
         (DL_FUNC)&GA_linear_assignment_solve_R,
         1
     },
+    {
+        "GA_linear_assignment_solve_real_R",
+        (DL_FUNC)&GA_linear_assignment_solve_real_R,
+        1
+    },
+    {
+        "GA_linear_assignment_solve_warm_R",
+        (DL_FUNC)&GA_linear_assignment_solve_warm_R,
+        4
+    },
+    {
+        "GA_linear_assignment_solve_sparse_R",
+        (DL_FUNC)&GA_linear_assignment_solve_sparse_R,
+        3
+    },
+    {
+        "GA_linear_assignment_solve_auction_R",
+        (DL_FUNC)&GA_linear_assignment_solve_auction_R,
+        3
+    },
+    {
+        "GA_linear_assignment_solve_rect_R",
+        (DL_FUNC)&GA_linear_assignment_solve_rect_R,
+        3
+    },
+    {
+        "GA_linear_assignment_solve_batch_R",
+        (DL_FUNC)&GA_linear_assignment_solve_batch_R,
+        3
+    },
+    {
+        "GA_matrix_to_bin_real_R",
+        (DL_FUNC)&GA_matrix_to_bin_real_R,
+        4
+    },
+    {
+        "GA_vector_to_bin_real_R",
+        (DL_FUNC)&GA_vector_to_bin_real_R,
+        4
+    },
     {
         "GA_compute_M_R",
         (DL_FUNC)&GA_compute_M_R,
-        11
+        14
+    },
+    {
+        "GA_update_M_R",
+        (DL_FUNC)&GA_update_M_R,
+        12
     },
     {
         "GA_encode_directed_graph_R",
         (DL_FUNC)&GA_encode_directed_graph_R,
         2
     },
+    {
+        "GA_align_networks_R",
+        (DL_FUNC)&GA_align_networks_R,
+        23
+    },
+    {
+        "GA_prepare_alignment_R",
+        (DL_FUNC)&GA_prepare_alignment_R,
+        16
+    },
+    {
+        "GA_prepared_compute_M_R",
+        (DL_FUNC)&GA_prepared_compute_M_R,
+        4
+    },
+    {
+        "GA_prepared_compute_scores_R",
+        (DL_FUNC)&GA_prepared_compute_scores_R,
+        3
+    },
+    {
+        "GA_prepared_linear_assignment_R",
+        (DL_FUNC)&GA_prepared_linear_assignment_R,
+        4
+    },
+    {
+        "GA_prepared_align_networks_R",
+        (DL_FUNC)&GA_prepared_align_networks_R,
+        8
+    },
     {
         NULL,
         NULL,
@@ -43,6 +43,9 @@
 #include "GA_message.h"
 #include "GA_vector.h"
 #include "GA_matrix.h"
+#include "GA_sparse.h"
+#include "GA_kernel.h"
+#include "GA_auction.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -87,6 +90,203 @@ void GA_msg_R(const char* text, GAMessageLevel level);
  */
 GAVectorInt* GA_linear_assignment_solve(GAMatrixInt* costMatrix);
 
+/** Solve linear assignment problem (real).
+ *
+ * Solve the linear assignment problem specified by a cost matrix of real 
+ * numbers (see GA_linear_assignment_solve()). The costs are used as they 
+ * are, so they do not have to be scaled and rounded to integers first.
+ *
+ * \param costMatrix cost matrix
+ *
+ * \return Solution of the linear assignment problem
+ */
+GAVectorInt* GA_linear_assignment_solve_real(GAMatrixReal* costMatrix);
+
+/** Linear assignment solver state (implementation).
+ *
+ * This type holds the assignment and the column dual variables of a 
+ * solution of a linear assignment problem, which can be used to warm start 
+ * the solver for a similar problem (see GA_linear_assignment_solve_warm()). 
+ * To create a new state, use GA_linear_assignment_state_create(). To 
+ * reference a state, use GA_linear_assignment_state_ref().
+ */
+struct GALinearAssignmentState_Impl
+{
+    /** Column assigned to each row.
+     */
+    GAVectorInt* rowSol;
+    /** Column dual variables.
+     */
+    GAVectorReal* v;
+    /** Whether the state contains a solution.
+     */
+    int valid;
+    /** Reference count.
+     */
+    int refs;
+};
+
+/** Linear assignment solver state.
+ */
+typedef struct GALinearAssignmentState_Impl GALinearAssignmentState;
+
+/** Create linear assignment solver state.
+ *
+ * Create a state for linear assignment problems of the specified size, 
+ * which does not contain a solution yet. The new state will be referenced 
+ * and should be destroyed by using GA_linear_assignment_state_destroy() 
+ * when it is not needed anymore.
+ *
+ * \param size Size of the linear assignment problems.
+ *
+ * \return Pointer to a state, or 0 if an error occurs.
+ *
+ * \sa GA_linear_assignment_state_destroy
+ */
+GALinearAssignmentState* GA_linear_assignment_state_create(int size);
+
+/** Add reference.
+ *
+ * Add a reference for a linear assignment solver state. The user of this 
+ * function is responsible for removing the reference using 
+ * GA_linear_assignment_state_destroy().
+ *
+ * \param state State.
+ *
+ * \return The state.
+ *
+ * \sa GA_linear_assignment_state_destroy
+ */
+GALinearAssignmentState* GA_linear_assignment_state_ref(
+    GALinearAssignmentState* state);
+
+/** Destroy linear assignment solver state.
+ *
+ * Remove a reference from a linear assignment solver state. If the 
+ * reference count drops to zero, the state will be destroyed.
+ *
+ * \param state State.
+ */
+void GA_linear_assignment_state_destroy(GALinearAssignmentState* state);
+
+/** Solve linear assignment problem (warm start).
+ *
+ * Solve the linear assignment problem specified by the cost matrix (see 
+ * GA_linear_assignment_solve()). If the state contains a solution, the 
+ * solver is warm started from it (see LAP_lap_warm()), which is much 
+ * faster if the cost matrix differs only slightly from the previous one, 
+ * as in consecutive steps of an alignment. The solution is stored in the 
+ * state afterwards. The result is an optimal assignment, but if there are 
+ * several optimal assignments, it may differ from the one found by 
+ * GA_linear_assignment_solve().
+ *
+ * \param costMatrix cost matrix
+ * \param state linear assignment solver state
+ *
+ * \return Solution of the linear assignment problem
+ */
+GAVectorInt* GA_linear_assignment_solve_warm(GAMatrixInt* costMatrix, 
+    GALinearAssignmentState* state);
+
+/** Solve linear assignment problem (warm start, real).
+ *
+ * Solve the linear assignment problem specified by a cost matrix of real 
+ * numbers, warm started from the solution in the state if there is one 
+ * (see GA_linear_assignment_solve_warm()).
+ *
+ * \param costMatrix cost matrix
+ * \param state linear assignment solver state
+ *
+ * \return Solution of the linear assignment problem
+ */
+GAVectorInt* GA_linear_assignment_solve_warm_real(GAMatrixReal* costMatrix, 
+    GALinearAssignmentState* state);
+
+/** Solve rectangular linear assignment problem.
+ *
+ * Solve a linear assignment problem for a cost matrix of real numbers 
+ * with any number of rows and columns, in which rows and columns may be 
+ * left unassigned. Each row and each column which is not assigned adds 
+ * \c unassignedCost to the cost of the assignment, and at least 
+ * \c minAssigned pairs are assigned. If \c minAssigned is at least the 
+ * smaller dimension of the cost matrix, it is reduced to that dimension, 
+ * so all rows or all columns are assigned and \c unassignedCost has no 
+ * effect. The problem is reduced to one with the smaller dimension as 
+ * rows (see LAP_lap_rect_real()), with one extra column of zero cost for 
+ * each row which may remain unassigned. If \c minAssigned is zero, these 
+ * columns are not needed, and the costs are cut off at the cost of 
+ * leaving both nodes unassigned instead. No square matrix of the larger 
+ * dimension is allocated.
+ *
+ * \param costMatrix cost matrix
+ * \param unassignedCost cost of each unassigned row and column
+ * \param minAssigned minimum number of assigned pairs
+ *
+ * \return row assigned to each column, or -1 if the column is not 
+ * assigned, or 0 if an error occurs
+ */
+GAVectorInt* GA_linear_assignment_solve_rect_real(GAMatrixReal* costMatrix, 
+    double unassignedCost, int minAssigned);
+
+/** Solve linear assignment problems (batch).
+ *
+ * Solve a batch of independent linear assignment problems of the same 
+ * size in parallel. The cost matrices are read through views, so they can 
+ * be stored in the memory of R objects. Each thread copies the cost 
+ * matrices it solves into its own cost buffer and solves them with its 
+ * own solver workspace (see LAP_lap_warm_real_ws()), and all buffers are 
+ * allocated before the threads are started, so the allocation functions 
+ * are not used in parallel. If \c real is zero, the costs are truncated to 
+ * integers, and the problems are solved as by 
+ * GA_linear_assignment_solve(), otherwise as by 
+ * GA_linear_assignment_solve_real(). The result does not depend on the 
+ * number of threads.
+ *
+ * \param costMatrices views of the cost matrices
+ * \param numMatrices number of cost matrices
+ * \param real solve for the real costs
+ * \param numThreads number of threads
+ *
+ * \return matrix with a column for each cost matrix, which contains the 
+ * row assigned to each column of the cost matrix, or 0 if an error occurs
+ */
+GAMatrixInt* GA_linear_assignment_solve_batch(GAMatrixViewReal** costMatrices, 
+    int numMatrices, int real, int numThreads);
+
+/** Solve sparse linear assignment problem.
+ *
+ * Solve the linear assignment problem specified by a sparse cost matrix, 
+ * in which only the stored elements may be assigned (see 
+ * LAP_lapsp_warm()). The other elements are not considered, regardless of 
+ * the default element of the matrix. This needs memory proportional to 
+ * the number of stored elements instead of the square of the size. If 
+ * there is no complete assignment which uses only stored elements, an 
+ * error is reported.
+ *
+ * \param costMatrix sparse cost matrix
+ *
+ * \return Solution of the linear assignment problem, or 0 if an error 
+ * occurs
+ */
+GAVectorInt* GA_linear_assignment_solve_sparse(
+    GASparseMatrixReal* costMatrix);
+
+/** Solve sparse linear assignment problem (warm start).
+ *
+ * Solve the linear assignment problem specified by a sparse cost matrix 
+ * (see GA_linear_assignment_solve_sparse()), warm started from the 
+ * solution in the state if there is one (see 
+ * GA_linear_assignment_solve_warm()).
+ *
+ * \param costMatrix sparse cost matrix
+ * \param state linear assignment solver state
+ *
+ * \return Solution of the linear assignment problem, or 0 if an error 
+ * occurs
+ */
+GAVectorInt* GA_linear_assignment_solve_warm_sparse(
+    GASparseMatrixReal* costMatrix, GALinearAssignmentState* state);
+
 /** Encode directed graph.
  *
  * Encode an adjacency matrix for a directed graph into a symmetric matrix.
@@ -105,9 +305,27 @@ GAVectorInt* GA_linear_assignment_solve(GAMatrixInt* costMatrix);
  */
 GAMatrixReal* GA_encode_directed_graph(GAMatrixReal* matrix, GAVectorInt* p);
 
+/** Encode directed graph (sparse).
+ *
+ * Encode a sparse adjacency matrix for a directed graph into a symmetric 
+ * sparse matrix (see GA_encode_directed_graph()).
+ * 
+ * The matrix which is returned will be referenced and should be destroyed by 
+ * using GA_sparse_destroy_real() when it is not needed anymore.
+ * 
+ * \param matrix sparse matrix
+ * \param p permutation vector
+ *
+ * \return symmetric sparse matrix
+ */
+GASparseMatrixReal* GA_encode_directed_graph_sparse(
+    GASparseMatrixReal* matrix, GAVectorInt* p);
+
 /** Encode directed graph (R).
  *
  * Encode an adjacency matrix for a directed graph into a symmetric matrix.
+ * If the matrix is a sparse network (see GA_sparse_R.h), the result is a 
+ * sparse network as well.
  * 
  * \param matrix matrix
  * \param p permutation vector
@@ -127,6 +345,104 @@ SEXP GA_encode_directed_graph_R(SEXP matrix, SEXP p);
  */
 SEXP GA_linear_assignment_solve_R(SEXP costMatrix);
 
+/** Solve linear assignment problem (R, real).
+ *
+ * Solve the linear assignment problem specified by a cost matrix of real 
+ * numbers (see GA_linear_assignment_solve_real()). The solution returned 
+ * is a vector of rows assigned to columns.
+ *
+ * \param costMatrix cost matrix
+ *
+ * \return Solution of the linear assignment problem
+ */
+SEXP GA_linear_assignment_solve_real_R(SEXP costMatrix);
+
+/** Solve linear assignment problem with warm start (R).
+ *
+ * Solve the linear assignment problem specified by the cost matrix, warm 
+ * started from a previous solution if \c rowSol and \c v are not 
+ * \c NULL (see GA_linear_assignment_solve_warm()).
+ *
+ * \param costMatrix cost matrix
+ * \param rowSol columns assigned to rows in the previous solution, or 
+ * \c NULL
+ * \param v column dual variables of the previous solution, or \c NULL
+ * \param real \c TRUE to solve for real costs instead of integer costs
+ *
+ * \return list containing the solution (rows assigned to columns), the 
+ * columns assigned to rows and the column dual variables
+ */
+SEXP GA_linear_assignment_solve_warm_R(SEXP costMatrix, SEXP rowSol, 
+    SEXP v, SEXP real);
+
+/** Solve sparse linear assignment problem (R).
+ *
+ * Solve the linear assignment problem specified by a sparse cost matrix 
+ * (see GA_sparse_R.h), in which the elements which are not stored cannot 
+ * be assigned (see GA_linear_assignment_solve_sparse()). Dense cost 
+ * matrices are accepted as well, with infinite elements not being 
+ * assigned. The solver is warm started from a previous solution if 
+ * \c rowSol and \c v are not \c NULL.
+ *
+ * \param costMatrix sparse cost matrix
+ * \param rowSol columns assigned to rows in the previous solution, or 
+ * \c NULL
+ * \param v column dual variables of the previous solution, or \c NULL
+ *
+ * \return list containing the solution (rows assigned to columns), the 
+ * columns assigned to rows and the column dual variables
+ */
+SEXP GA_linear_assignment_solve_sparse_R(SEXP costMatrix, SEXP rowSol, 
+    SEXP v);
+
+/** Solve linear assignment problem with the auction algorithm (R).
+ *
+ * Solve the linear assignment problem specified by a cost matrix of real 
+ * numbers with the auction algorithm (see 
+ * GA_linear_assignment_solve_auction()). The solution returned is a vector 
+ * of rows assigned to columns.
+ *
+ * \param costMatrix cost matrix
+ * \param tolerance maximum excess over the optimal cost
+ * \param threads number of threads
+ *
+ * \return Solution of the linear assignment problem
+ */
+SEXP GA_linear_assignment_solve_auction_R(SEXP costMatrix, SEXP tolerance, 
+    SEXP threads);
+
+/** Solve rectangular linear assignment problem (R).
+ *
+ * Solve the linear assignment problem specified by a cost matrix of real 
+ * numbers with any dimensions, in which rows and columns may be left 
+ * unassigned (see GA_linear_assignment_solve_rect_real()).
+ *
+ * \param costMatrix cost matrix
+ * \param unassignedCost cost of each unassigned row and column
+ * \param minAssigned minimum number of assigned pairs
+ *
+ * \return rows assigned to columns, with -1 for unassigned columns
+ */
+SEXP GA_linear_assignment_solve_rect_R(SEXP costMatrix, SEXP unassignedCost, 
+    SEXP minAssigned);
+
+/** Solve linear assignment problems (batch, R).
+ *
+ * Solve a batch of linear assignment problems of the same size in 
+ * parallel (see GA_linear_assignment_solve_batch()). The cost matrices are 
+ * given as a list of square matrices or as a three-dimensional array, 
+ * whose third index selects the matrix.
+ *
+ * \param costMatrices list or array of cost matrices
+ * \param real solve for the real costs
+ * \param threads number of threads
+ *
+ * \return matrix with a column of rows assigned to columns for each cost 
+ * matrix
+ */
+SEXP GA_linear_assignment_solve_batch_R(SEXP costMatrices, SEXP real, 
+    SEXP threads);
+
 /** Directed mode (implementation).
  *
  * The directed mode specifies whether input matrices should be treated as 
@@ -156,12 +472,98 @@ typedef enum GADirectedMode_Impl GADirectedMode;
  */
 GADirectedMode GA_directed_mode_from_R(SEXP robj);
 
+/** Precision (implementation).
+ *
+ * The precision specifies in which floating point format the score matrix 
+ * M is computed and kept by the alignment driver (see GA_align_networks()).
+ */
+enum GAPrecision_Impl
+{
+    /** Precision: double.
+     */
+    GA_PRECISION_DOUBLE = 0,
+    /** Precision: single.
+     */
+    GA_PRECISION_SINGLE = 1
+};
+
+/** Precision.
+ */
+typedef enum GAPrecision_Impl GAPrecision;
+
+/** Get precision from R object.
+ *
+ * Get the precision corresponding to the value of the specified R object, 
+ * which must be one of the character strings \c "double" or \c "single".
+ *
+ * \param robj R object
+ *
+ * \return precision
+ */
+GAPrecision GA_precision_from_R(SEXP robj);
+
+/** Get compute engine from R object.
+ *
+ * Get the compute engine corresponding to the value of the specified R 
+ * object, which must be one of the character strings \c "scalar", 
+ * \c "blas", \c "bitset" or \c "sparse".
+ *
+ * \param robj R object
+ *
+ * \return compute engine
+ */
+GAComputeEngine GA_compute_engine_from_R(SEXP robj);
+
+/** Get assignment engine from R object.
+ *
+ * Get the assignment engine corresponding to the value of the specified R 
+ * object, which must be one of the character strings \c "jv" or 
+ * \c "auction".
+ *
+ * \param robj R object
+ *
+ * \return assignment engine
+ */
+GAAssignmentEngine GA_assignment_engine_from_R(SEXP robj);
+
+/** Get maximum number of threads.
+ *
+ * Get the maximum number of threads which can be used by the parallel 
+ * parts of the package. If the package has been compiled without OpenMP 
+ * support, this is always 1.
+ *
+ * \return maximum number of threads
+ */
+int GA_get_max_threads();
+
+/** Get number of threads from R object.
+ *
+ * Get the number of threads corresponding to the value of the specified R 
+ * object. A value smaller than 1 selects the maximum number of threads 
+ * available (see GA_get_max_threads()), while NA or an empty vector selects 
+ * a single thread.
+ *
+ * \param robj R object
+ *
+ * \return number of threads
+ */
+int GA_num_threads_from_R(SEXP robj);
+
 /** Compute score matrix.
  *
  * Compute the complete score matrix M. The matrix which is returned will be
  * referenced and should be destroyed by using GA_matrix_destroy_real() when 
  * it is not needed anymore.
  *
+ * The rows of M are computed in parallel if more than one thread is 
+ * requested and the package has been compiled with OpenMP support. The 
+ * result does not depend on the number of threads. The link score part of 
+ * M is computed by the kernel selected by \c engine (see GA_kernel.h). 
+ * M has a row and a column for each element of the permutation vector, 
+ * where the elements for dummy nodes are zero. If \c rectangular is 
+ * nonzero, these elements are left out, and M has a row for each node of 
+ * network B and a column for each node of network A.
+ *
  * \param na adjacency matrix for network A
  * \param nb adjacency matrix for network B
  * \param r node similarity matrix
@@ -173,6 +575,9 @@ GADirectedMode GA_directed_mode_from_R(SEXP robj);
  * \param lookupLink link bin lookup table
  * \param lookupNode node bin lookup table
  * \param clamp clamp mode for bin lookups
+ * \param engine compute engine for the link score sums
+ * \param numThreads number of threads
+ * \param rectangular compute a rectangular score matrix
  *
  * \return the score matrix M
  *
@@ -182,11 +587,277 @@ GAMatrixReal* GA_compute_M(GAMatrixReal* na, GAMatrixReal* nb,
     GAMatrixReal* r, GAVectorInt* p, GAMatrixReal* linkScore, 
     GAMatrixReal* selfLinkScore, GAVectorReal* nodeScore1, 
     GAVectorReal* nodeScore2, GAVectorReal* lookupLink, 
-    GAVectorReal* lookupNode, GAClampMode clamp);
+    GAVectorReal* lookupNode, GAClampMode clamp, GAComputeEngine engine, 
+    int numThreads, int rectangular);
+
+/** Compute score matrix (binned).
+ *
+ * Compute the complete score matrix M (see GA_compute_M()) from networks 
+ * and a node similarity matrix which have already been converted to bin 
+ * matrices. The lookup tables are only used for checking the dimensions of 
+ * the score matrices. If \c result is specified, M is stored in it, 
+ * otherwise a new matrix is created, which will be referenced and should 
+ * be destroyed by using GA_matrix_destroy_real() when it is not needed 
+ * anymore.
+ *
+ * \param result matrix for the result, or 0 to create a new matrix
+ * \param aBin bin matrix for network A
+ * \param bBin bin matrix for network B
+ * \param rBin bin matrix for the node similarity matrix
+ * \param p permutation vector
+ * \param linkScore link score matrix
+ * \param selfLinkScore self link score matrix
+ * \param nodeScore1 node score matrix (1)
+ * \param nodeScore2 node score matrix (2)
+ * \param lookupLink link bin lookup table
+ * \param lookupNode node bin lookup table
+ * \param engine compute engine for the link score sums
+ * \param numThreads number of threads
+ * \param rectangular compute a rectangular score matrix
+ *
+ * \return the score matrix M
+ */
+GAMatrixReal* GA_compute_M_binned(GAMatrixReal* result, 
+    GAMatrixBin* aBin, GAMatrixBin* bBin, GAMatrixBin* rBin, 
+    GAVectorInt* p, GAMatrixReal* linkScore, GAMatrixReal* selfLinkScore, 
+    GAVectorReal* nodeScore1, GAVectorReal* nodeScore2, 
+    GAVectorReal* lookupLink, GAVectorReal* lookupNode, 
+    GAComputeEngine engine, int numThreads, int rectangular);
+
+/** Compute score matrix (binned, single precision).
+ *
+ * Compute the complete score matrix M (see GA_compute_M_binned()) in single 
+ * precision. The link score sums are computed by 
+ * GA_link_sum_scalar_float(). If \c result is specified, M is stored in 
+ * it, otherwise a new matrix is created, which will be referenced and 
+ * should be destroyed by using GA_matrix_destroy_float() when it is not 
+ * needed anymore.
+ *
+ * \param result matrix for the result, or 0 to create a new matrix
+ * \param aBin bin matrix for network A
+ * \param bBin bin matrix for network B
+ * \param rBin bin matrix for the node similarity matrix
+ * \param p permutation vector
+ * \param linkScore link score matrix
+ * \param selfLinkScore self link score matrix
+ * \param nodeScore1 node score matrix (1)
+ * \param nodeScore2 node score matrix (2)
+ * \param lookupLink link bin lookup table
+ * \param lookupNode node bin lookup table
+ * \param numThreads number of threads
+ * \param rectangular compute a rectangular score matrix
+ *
+ * \return the score matrix M
+ */
+GAMatrixFloat* GA_compute_M_binned_float(GAMatrixFloat* result, 
+    GAMatrixBin* aBin, GAMatrixBin* bBin, GAMatrixBin* rBin, 
+    GAVectorInt* p, GAMatrixReal* linkScore, GAMatrixReal* selfLinkScore, 
+    GAVectorReal* nodeScore1, GAVectorReal* nodeScore2, 
+    GAVectorReal* lookupLink, GAVectorReal* lookupNode, int numThreads, 
+    int rectangular);
+
+/** Compute score matrix (sparse, binned).
+ *
+ * Compute the complete score matrix M (see GA_compute_M_sparse()) from 
+ * networks which have already been converted to sparse bin matrices. If 
+ * \c result is specified, M is stored in it, otherwise a new matrix is 
+ * created, which will be referenced and should be destroyed by using 
+ * GA_matrix_destroy_real() when it is not needed anymore.
+ *
+ * \param result matrix for the result, or 0 to create a new matrix
+ * \param aBin sparse bin matrix for network A
+ * \param bBin sparse bin matrix for network B
+ * \param rBin bin matrix for the node similarity matrix
+ * \param p permutation vector
+ * \param linkScore link score matrix
+ * \param selfLinkScore self link score matrix
+ * \param nodeScore1 node score matrix (1)
+ * \param nodeScore2 node score matrix (2)
+ * \param lookupLink link bin lookup table
+ * \param lookupNode node bin lookup table
+ * \param numThreads number of threads
+ * \param rectangular compute a rectangular score matrix
+ *
+ * \return the score matrix M
+ */
+GAMatrixReal* GA_compute_M_sparse_binned(GAMatrixReal* result, 
+    GASparseMatrixInt* aBin, GASparseMatrixInt* bBin, GAMatrixBin* rBin, 
+    GAVectorInt* p, GAMatrixReal* linkScore, GAMatrixReal* selfLinkScore, 
+    GAVectorReal* nodeScore1, GAVectorReal* nodeScore2, 
+    GAVectorReal* lookupLink, GAVectorReal* lookupNode, int numThreads, 
+    int rectangular);
+
+/** Compute score matrix (sparse).
+ *
+ * Compute the complete score matrix M (see GA_compute_M()) for networks 
+ * which are given as sparse matrices with default element zero. The 
+ * networks are binned without expanding them to dense matrices, and the 
+ * link score sums are computed by GA_link_sum_sparse_csr(). The matrix 
+ * which is returned will be referenced and should be destroyed by using 
+ * GA_matrix_destroy_real() when it is not needed anymore.
+ *
+ * \param a sparse adjacency matrix for network A
+ * \param b sparse adjacency matrix for network B
+ * \param r node similarity matrix
+ * \param p permutation vector
+ * \param linkScore link score matrix
+ * \param selfLinkScore self link score matrix
+ * \param nodeScore1 node score matrix (1)
+ * \param nodeScore2 node score matrix (2)
+ * \param lookupLink link bin lookup table
+ * \param lookupNode node bin lookup table
+ * \param clamp clamp mode for bin lookups
+ * \param numThreads number of threads
+ * \param rectangular compute a rectangular score matrix
+ *
+ * \return the score matrix M
+ */
+GAMatrixReal* GA_compute_M_sparse(GASparseMatrixReal* a, 
+    GASparseMatrixReal* b, GAMatrixReal* r, GAVectorInt* p, 
+    GAMatrixReal* linkScore, GAMatrixReal* selfLinkScore, 
+    GAVectorReal* nodeScore1, GAVectorReal* nodeScore2, 
+    GAVectorReal* lookupLink, GAVectorReal* lookupNode, GAClampMode clamp, 
+    int numThreads, int rectangular);
+
+/** Update score matrix (binned).
+ *
+ * Update the score matrix M after a change of the alignment from \c oldP to 
+ * \c newP. A change of p[k] only affects the k-th term of the link score 
+ * sums and the node score terms of the nodes which become aligned or 
+ * unaligned, so only these terms are updated. This takes O(n^2 c) time, 
+ * where c is the number of nodes which have been realigned. The matrix 
+ * \c m must be the score matrix for \c oldP, which may be square or 
+ * rectangular (see GA_compute_M()), and is updated in place.
+ *
+ * \param m score matrix M for the old permutation
+ * \param aBin bin matrix for network A
+ * \param bBin bin matrix for network B
+ * \param rBin bin matrix for the node similarity matrix
+ * \param oldP old permutation vector
+ * \param newP new permutation vector
+ * \param linkScore link score matrix
+ * \param nodeScore2 node score matrix (2)
+ * \param numThreads number of threads
+ *
+ * \return the updated score matrix M, or 0 if an error occurs
+ */
+GAMatrixReal* GA_update_M_binned(GAMatrixReal* m, GAMatrixBin* aBin, 
+    GAMatrixBin* bBin, GAMatrixBin* rBin, GAVectorInt* oldP, 
+    GAVectorInt* newP, GAMatrixReal* linkScore, GAVectorReal* nodeScore2, 
+    int numThreads);
+
+/** Update score matrix (binned, single precision).
+ *
+ * Update a single precision score matrix M after a change of the alignment 
+ * (see GA_update_M_binned()). The change of each element is computed in 
+ * double precision and then added to the element.
+ *
+ * \param m score matrix M for the old permutation
+ * \param aBin bin matrix for network A
+ * \param bBin bin matrix for network B
+ * \param rBin bin matrix for the node similarity matrix
+ * \param oldP old permutation vector
+ * \param newP new permutation vector
+ * \param linkScore link score matrix
+ * \param nodeScore2 node score matrix (2)
+ * \param numThreads number of threads
+ *
+ * \return the updated score matrix M, or 0 if an error occurs
+ */
+GAMatrixFloat* GA_update_M_binned_float(GAMatrixFloat* m, GAMatrixBin* aBin, 
+    GAMatrixBin* bBin, GAMatrixBin* rBin, GAVectorInt* oldP, 
+    GAVectorInt* newP, GAMatrixReal* linkScore, GAVectorReal* nodeScore2, 
+    int numThreads);
+
+/** Update score matrix.
+ *
+ * Update the score matrix M after a change of the alignment from \c oldP to 
+ * \c newP (see GA_update_M_binned()). The matrix \c m must be the score 
+ * matrix for \c oldP and is updated in place.
+ *
+ * \param m score matrix M for the old permutation
+ * \param a adjacency matrix for network A
+ * \param b adjacency matrix for network B
+ * \param r node similarity matrix
+ * \param oldP old permutation vector
+ * \param newP new permutation vector
+ * \param linkScore link score matrix
+ * \param nodeScore2 node score matrix (2)
+ * \param lookupLink link bin lookup table
+ * \param lookupNode node bin lookup table
+ * \param clamp clamp mode for bin lookups
+ * \param numThreads number of threads
+ *
+ * \return the updated score matrix M, or 0 if an error occurs
+ */
+GAMatrixReal* GA_update_M(GAMatrixReal* m, GAMatrixReal* a, GAMatrixReal* b, 
+    GAMatrixReal* r, GAVectorInt* oldP, GAVectorInt* newP, 
+    GAMatrixReal* linkScore, GAVectorReal* nodeScore2, 
+    GAVectorReal* lookupLink, GAVectorReal* lookupNode, GAClampMode clamp, 
+    int numThreads);
+
+/** Convert to bin matrix (R).
+ *
+ * Convert a matrix of real numbers to a matrix of integer bin numbers 
+ * according to the specified lookup vector (see GA_get_bin_number()). The 
+ * elements are read directly from the memory of the R object, and the rows 
+ * are distributed among the specified number of threads.
+ *
+ * \param matrix matrix
+ * \param lookup lookup vector
+ * \param clamp clamp values to the lookup range
+ * \param threads number of threads
+ *
+ * \return matrix of bin numbers
+ */
+SEXP GA_matrix_to_bin_real_R(SEXP matrix, SEXP lookup, SEXP clamp, 
+    SEXP threads);
+
+/** Convert to bin vector (R).
+ *
+ * Convert a vector of real numbers to a vector of integer bin numbers 
+ * according to the specified lookup vector (see GA_matrix_to_bin_real_R()).
+ *
+ * \param vec vector
+ * \param lookup lookup vector
+ * \param clamp clamp values to the lookup range
+ * \param threads number of threads
+ *
+ * \return vector of bin numbers
+ */
+SEXP GA_vector_to_bin_real_R(SEXP vec, SEXP lookup, SEXP clamp, 
+    SEXP threads);
+
+/** Update score matrix (R).
+ *
+ * Update the score matrix M after a change of the alignment.
+ *
+ * \param m score matrix M for the old permutation
+ * \param a adjacency matrix for network A
+ * \param b adjacency matrix for network B
+ * \param r node similarity matrix
+ * \param oldP old permutation vector
+ * \param newP new permutation vector
+ * \param linkScore link score matrix
+ * \param nodeScore2 node score matrix (2)
+ * \param lookupLink link bin lookup table
+ * \param lookupNode node bin lookup table
+ * \param clamp clamp mode for bin lookups
+ * \param threads number of threads
+ *
+ * \return the updated score matrix M
+ */
+SEXP GA_update_M_R(SEXP m, SEXP a, SEXP b, SEXP r, SEXP oldP, SEXP newP, 
+    SEXP linkScore, SEXP nodeScore2, SEXP lookupLink, SEXP lookupNode, 
+    SEXP clamp, SEXP threads);
 
 /** Compute score matrix (R).
  *
- * Compute the complete score matrix M.
+ * Compute the complete score matrix M. The networks and the node 
+ * similarity matrix are binned directly from the memory of the R objects 
+ * (see GA_matrix_view_from_R_real()). If one of the networks is a sparse 
+ * network (see GA_sparse_R.h), the score matrix is computed by 
+ * GA_compute_M_sparse() and the compute engine is ignored.
  *
  * \param a adjacency matrix for network A
  * \param b adjacency matrix for network B
@@ -199,12 +870,413 @@ GAMatrixReal* GA_compute_M(GAMatrixReal* na, GAMatrixReal* nb,
  * \param lookupLink link bin lookup table
  * \param lookupNode node bin lookup table
  * \param clamp clamp mode for bin lookups
+ * \param engine compute engine
+ * \param threads number of threads
+ * \param rectangular compute a rectangular score matrix (see 
+ * GA_compute_M())
  *
  * \return the score matrix M
  */
 SEXP GA_compute_M_R(SEXP a, SEXP b, SEXP r, SEXP p, SEXP linkScore, 
     SEXP selfLinkScore, SEXP nodeScore1, SEXP nodeScore2, SEXP lookupLink, 
-    SEXP lookupNode, SEXP clamp);
+    SEXP lookupNode, SEXP clamp, SEXP engine, SEXP threads, 
+    SEXP rectangular);
+
+/** Alignment problem (implementation).
+ *
+ * This type holds the networks and scoring parameters of an alignment 
+ * problem in the form used by the alignment driver (see 
+ * GA_align_networks()). Only one representation of the networks is set:
+ *
+ * - \c aBin and \c bBin (dense bin matrices) or \c aSparseBin and 
+ *   \c bSparseBin (sparse bin matrices) for undirected networks, which are 
+ *   binned once,
+ * - \c a and \c b (dense matrices) or \c aSparse and \c bSparse (sparse 
+ *   matrices) for directed networks, which are encoded (see 
+ *   GA_encode_directed_graph()) and binned in each step, since the 
+ *   encoding depends on the alignment.
+ *
+ * All other members except \c candidates, which is optional, and \c cost, 
+ * \c costReal and \c lapState, which are optional buffers, must be set. 
+ * To create a new alignment problem, use GA_align_problem_create() and 
+ * set the members, which will be released by GA_align_problem_destroy(). 
+ * To reference an alignment problem, use GA_align_problem_ref().
+ */
+struct GAAlignProblem_Impl
+{
+    /** Bin matrix for network A (undirected, dense).
+     */
+    GAMatrixBin* aBin;
+    /** Bin matrix for network B (undirected, dense).
+     */
+    GAMatrixBin* bBin;
+    /** Bin matrix for network A (undirected, sparse).
+     */
+    GASparseMatrixInt* aSparseBin;
+    /** Bin matrix for network B (undirected, sparse).
+     */
+    GASparseMatrixInt* bSparseBin;
+    /** Adjacency matrix for network A (directed, dense).
+     */
+    GAMatrixReal* a;
+    /** Adjacency matrix for network B (directed, dense).
+     */
+    GAMatrixReal* b;
+    /** Adjacency matrix for network A (directed, sparse).
+     */
+    GASparseMatrixReal* aSparse;
+    /** Adjacency matrix for network B (directed, sparse).
+     */
+    GASparseMatrixReal* bSparse;
+    /** Bin matrix for the node similarity matrix.
+     */
+    GAMatrixBin* rBin;
+    /** Link score matrix.
+     */
+    GAMatrixReal* linkScore;
+    /** Self link score matrix.
+     */
+    GAMatrixReal* selfLinkScore;
+    /** Node score vector (1).
+     */
+    GAVectorReal* nodeScore1;
+    /** Node score vector (2).
+     */
+    GAVectorReal* nodeScore2;
+    /** Link bin lookup table.
+     */
+    GAVectorReal* lookupLink;
+    /** Node bin lookup table.
+     */
+    GAVectorReal* lookupNode;
+    /** Clamp mode for bin lookups.
+     */
+    GAClampMode clamp;
+    /** Directed mode.
+     */
+    GADirectedMode directed;
+    /** Compute engine for the link score sums of dense networks.
+     */
+    GAComputeEngine engine;
+    /** Precision of the score matrices of the alignment driver.
+     */
+    GAPrecision precision;
+    /** Candidate pairs (rows and columns of M) for the linear assignment 
+     * problems, or 0 for all pairs.
+     */
+    GASparseMatrixReal* candidates;
+    /** Whether the score matrices are rectangular (see GA_compute_M()).
+     */
+    int rectangular;
+    /** Cost matrix buffer for linear assignment problems, or 0.
+     */
+    GAMatrixInt* cost;
+    /** Real cost matrix buffer for linear assignment problems, or 0.
+     */
+    GAMatrixReal* costReal;
+    /** Linear assignment solver state for warm starts, or 0.
+     */
+    GALinearAssignmentState* lapState;
+    /** Arena for the temporary memory of the alignment steps, or 0 (see 
+     * GA_align_networks()).
+     */
+    GAArena* arena;
+    /** Assignment engine for the dense linear assignment problems.
+     */
+    GAAssignmentEngine assignmentEngine;
+    /** Tolerance for the auction algorithm (see 
+     * GA_linear_assignment_solve_auction()).
+     */
+    double tolerance;
+    /** Number of threads.
+     */
+    int numThreads;
+    /** Reference count.
+     */
+    int refs;
+};
+
+/** Alignment problem.
+ */
+typedef struct GAAlignProblem_Impl GAAlignProblem;
+
+/** Create alignment problem.
+ *
+ * Create an empty alignment problem. The new alignment problem will be 
+ * referenced and should be destroyed by using GA_align_problem_destroy() 
+ * when it is not needed anymore.
+ *
+ * \return Pointer to an alignment problem, or 0 if an error occurs.
+ *
+ * \sa GA_align_problem_destroy
+ */
+GAAlignProblem* GA_align_problem_create();
+
+/** Add reference.
+ *
+ * Add a reference for an alignment problem. The user of this function is 
+ * responsible for removing the reference using GA_align_problem_destroy().
+ *
+ * \param problem Alignment problem.
+ *
+ * \return The alignment problem.
+ *
+ * \sa GA_align_problem_destroy
+ */
+GAAlignProblem* GA_align_problem_ref(GAAlignProblem* problem);
+
+/** Destroy alignment problem.
+ *
+ * Remove a reference from an alignment problem. If the reference count 
+ * drops to zero, the references to all members will be removed and the 
+ * alignment problem itself will be destroyed.
+ *
+ * \param problem Alignment problem.
+ */
+void GA_align_problem_destroy(GAAlignProblem* problem);
+
+/** Compute score matrix for alignment problem.
+ *
+ * Compute the score matrix M of an alignment problem for the permutation 
+ * \c p. If \c m is specified, M is stored in it and \c m is returned. 
+ * If \c m is the score matrix for the permutation \c prevP and the 
+ * networks are undirected and dense, \c m is updated in place (see 
+ * GA_update_M_binned()), otherwise it is overwritten. If \c m is not 
+ * specified, a new score matrix is computed, which should be destroyed by 
+ * using GA_matrix_destroy_real() when it is not needed anymore.
+ *
+ * \param problem alignment problem
+ * \param p permutation vector
+ * \param m matrix for the result, or 0 to create a new matrix
+ * \param prevP permutation vector for the score matrix in \c m, or 0
+ *
+ * \return the score matrix M, or 0 if an error occurs
+ */
+GAMatrixReal* GA_align_problem_compute_M(GAAlignProblem* problem, 
+    GAVectorInt* p, GAMatrixReal* m, GAVectorInt* prevP);
+
+/** Compute score matrix for alignment problem (single precision).
+ *
+ * Compute the score matrix M of an alignment problem in single precision 
+ * (see GA_align_problem_compute_M()). If the networks are undirected and 
+ * dense, M is updated by GA_update_M_binned_float() or, if the compute 
+ * engine is GA_ENGINE_SCALAR, computed by GA_compute_M_binned_float(). 
+ * Otherwise, M is computed in double precision and converted. A new score 
+ * matrix should be destroyed by using GA_matrix_destroy_float() when it is 
+ * not needed anymore.
+ *
+ * \param problem alignment problem
+ * \param p permutation vector
+ * \param m matrix for the result, or 0 to create a new matrix
+ * \param prevP permutation vector for the score matrix in \c m, or 0
+ *
+ * \return the score matrix M, or 0 if an error occurs
+ */
+GAMatrixFloat* GA_align_problem_compute_M_float(GAAlignProblem* problem, 
+    GAVectorInt* p, GAMatrixFloat* m, GAVectorInt* prevP);
+
+/** Compute scores for alignment problem.
+ *
+ * Compute the link score and the node score of the alignment \c p (see 
+ * ComputeScores()). This is only supported for undirected networks. If 
+ * \c symmetric is nonzero, the link score sum over pairs of aligned nodes 
+ * is multiplied by 0.5, since each link is counted twice. The new vector 
+ * should be destroyed by using GA_vector_destroy_real() when it is not 
+ * needed anymore.
+ *
+ * \param problem alignment problem
+ * \param p permutation vector
+ * \param symmetric network symmetry flag
+ *
+ * \return vector containing the link score and the node score, or 0 if an 
+ * error occurs
+ */
+GAVectorReal* GA_align_problem_compute_scores(GAAlignProblem* problem, 
+    GAVectorInt* p, int symmetric);
+
+/** Align networks.
+ *
+ * Find an alignment of the networks of an alignment problem by repeatedly 
+ * computing the score matrix M and solving the linear assignment problem 
+ * for it, starting from the permutation \c p. This is the native 
+ * implementation of the AlignNetworks() R function, and all intermediate 
+ * results stay in native memory. In each step, M is normalized to the range 
+ * [-1, 1], and if simulated annealing is enabled (\c bStart != \c bEnd), 
+ * normally distributed noise with standard deviation 1 / b is added, where 
+ * b runs from \c bStart to \c bEnd. The noise is drawn from the R random 
+ * number generator in column-major order, as by <tt>rnorm()</tt>. The 
+ * linear assignment problems are solved for the negated real costs (see 
+ * GA_linear_assignment_solve_real()), without rounding them to integers. 
+ * If only a few nodes (at most 10%) have been realigned in a step, M is 
+ * updated incrementally. If \c warmStart is nonzero, the linear assignment 
+ * solver is warm started from the solution of the previous step (see 
+ * GA_linear_assignment_solve_warm_real()), which is much faster in the 
+ * late steps, but may select a different optimal assignment if there are 
+ * ties. If the problem has candidate pairs, only these and the pairs of the 
+ * current alignment can be assigned in each step, and the linear 
+ * assignment problems are solved as sparse problems (see 
+ * GA_linear_assignment_solve_sparse()), with noise only for these pairs. 
+ * Otherwise, if the assignment engine of the problem is 
+ * GA_ASSIGNMENT_AUCTION, the linear assignment problems are solved by the 
+ * auction algorithm to the tolerance of the problem (see 
+ * GA_linear_assignment_solve_auction()), and \c warmStart is ignored. If 
+ * the problem is rectangular, M has |B| rows and |A| columns, the noise is 
+ * only drawn for these, and the linear assignment problems are solved 
+ * without dummy nodes (see GA_linear_assignment_solve_rect_real()), with 
+ * as many aligned pairs as are required by the length of \c p. The 
+ * assignment engine of the problem and \c warmStart are then ignored, and 
+ * candidate pairs are not supported. The temporary memory of each step is 
+ * allocated from the arena of the problem, which is created by the first 
+ * call and reset after each step (see GA_arena_reset()), so the memory 
+ * use does not grow with the number of steps.
+ * If the precision of the problem is GA_PRECISION_SINGLE, M is computed 
+ * and kept in single precision (see GA_align_problem_compute_M_float()), 
+ * which halves the memory used by M. The linear assignment problems are 
+ * still solved for costs in double precision.
+ *
+ * \param problem alignment problem
+ * \param p initial permutation vector
+ * \param bStart initial inverse noise level
+ * \param bEnd final inverse noise level
+ * \param maxNumSteps number of steps
+ * \param warmStart warm start the linear assignment solver
+ *
+ * \return the final permutation vector, or 0 if an error occurs
+ */
+GAVectorInt* GA_align_networks(GAAlignProblem* problem, GAVectorInt* p, 
+    double bStart, double bEnd, int maxNumSteps, int warmStart);
+
+/** Align networks (R).
+ *
+ * Find an alignment of two networks (see GA_align_networks()). The 
+ * networks may be dense or sparse (see GA_sparse_R.h).
+ *
+ * \param a adjacency matrix for network A
+ * \param b adjacency matrix for network B
+ * \param r node similarity matrix
+ * \param p initial permutation vector
+ * \param linkScore link score matrix
+ * \param selfLinkScore self link score matrix
+ * \param nodeScore1 node score matrix (1)
+ * \param nodeScore2 node score matrix (2)
+ * \param lookupLink link bin lookup table
+ * \param lookupNode node bin lookup table
+ * \param bStart initial inverse noise level
+ * \param bEnd final inverse noise level
+ * \param maxNumSteps number of steps
+ * \param clamp clamp mode for bin lookups
+ * \param directed directed mode
+ * \param engine compute engine
+ * \param threads number of threads
+ * \param warmStart warm start the linear assignment solver
+ * \param candidates matrix of candidate pairs (nonzero elements, dense or 
+ * sparse) with the dimensions of M, or \c NULL for all pairs
+ * \param lapEngine assignment engine
+ * \param tolerance tolerance for the auction algorithm
+ * \param rectangular use rectangular score matrices and linear assignment 
+ * problems
+ * \param precision precision of the score matrices (see 
+ * GA_precision_from_R())
+ *
+ * \return the final permutation vector
+ */
+SEXP GA_align_networks_R(SEXP a, SEXP b, SEXP r, SEXP p, SEXP linkScore, 
+    SEXP selfLinkScore, SEXP nodeScore1, SEXP nodeScore2, SEXP lookupLink, 
+    SEXP lookupNode, SEXP bStart, SEXP bEnd, SEXP maxNumSteps, SEXP clamp, 
+    SEXP directed, SEXP engine, SEXP threads, SEXP warmStart, 
+    SEXP candidates, SEXP lapEngine, SEXP tolerance, SEXP rectangular, 
+    SEXP precision);
+
+/** Prepare alignment (R).
+ *
+ * Create an alignment problem from the networks and scoring parameters 
+ * (see GA_align_networks_R() for the parameters) and return it as an R 
+ * external pointer. The networks and the node similarity matrix are 
+ * converted and binned only once. The alignment problem is allocated 
+ * outside of the R memory stack, so it persists across calls, and it is 
+ * destroyed by a finalizer when the external pointer is garbage 
+ * collected.
+ *
+ * \return external pointer to the alignment problem
+ */
+SEXP GA_prepare_alignment_R(SEXP a, SEXP b, SEXP r, SEXP linkScore, 
+    SEXP selfLinkScore, SEXP nodeScore1, SEXP nodeScore2, SEXP lookupLink, 
+    SEXP lookupNode, SEXP clamp, SEXP directed, SEXP engine, SEXP threads, 
+    SEXP candidates, SEXP rectangular, SEXP precision);
+
+/** Compute score matrix for prepared alignment (R).
+ *
+ * Compute the score matrix M of a prepared alignment (see 
+ * GA_prepare_alignment_R()) for the permutation \c p. If \c m0 and \c p0 
+ * are not \c NULL, M is updated from the score matrix \c m0 for the 
+ * permutation \c p0 (see GA_align_problem_compute_M()). Otherwise, if the 
+ * precision of the prepared alignment is GA_PRECISION_SINGLE, M is 
+ * computed in single precision (see GA_align_problem_compute_M_float()) 
+ * and only converted to double precision for the result.
+ *
+ * \param context prepared alignment
+ * \param p permutation vector
+ * \param m0 score matrix for \c p0, or \c NULL
+ * \param p0 permutation vector for \c m0, or \c NULL
+ *
+ * \return the score matrix M
+ */
+SEXP GA_prepared_compute_M_R(SEXP context, SEXP p, SEXP m0, SEXP p0);
+
+/** Compute scores for prepared alignment (R).
+ *
+ * Compute the link score and the node score of the alignment \c p for a 
+ * prepared alignment (see GA_align_problem_compute_scores()).
+ *
+ * \param context prepared alignment
+ * \param p permutation vector
+ * \param symmetric network symmetry flag
+ *
+ * \return vector containing the link score and the node score
+ */
+SEXP GA_prepared_compute_scores_R(SEXP context, SEXP p, SEXP symmetric);
+
+/** Solve linear assignment problem for prepared alignment (R).
+ *
+ * Solve the linear assignment problem for the specified cost matrix (see 
+ * GA_linear_assignment_solve()). The cost matrix is converted into the 
+ * buffer of the prepared alignment, which is only reallocated if the size 
+ * of the cost matrix changes. If \c warmStart is \c TRUE, the solver is 
+ * warm started from the previous solution for the prepared alignment (see 
+ * GA_linear_assignment_solve_warm()), which is kept in the prepared 
+ * alignment. If \c real is \c TRUE, the problem is solved for real costs 
+ * (see GA_linear_assignment_solve_real()).
+ *
+ * \param context prepared alignment
+ * \param costMatrix cost matrix
+ * \param warmStart warm start the solver
+ * \param real \c TRUE to solve for real costs instead of integer costs
+ *
+ * \return the solution vector
+ */
+SEXP GA_prepared_linear_assignment_R(SEXP context, SEXP costMatrix, 
+    SEXP warmStart, SEXP real);
+
+/** Align networks for prepared alignment (R).
+ *
+ * Find an alignment of the networks of a prepared alignment (see 
+ * GA_align_networks()). The assignment engine and the tolerance are stored 
+ * in the prepared alignment for this call.
+ *
+ * \param context prepared alignment
+ * \param p initial permutation vector
+ * \param bStart initial inverse noise level
+ * \param bEnd final inverse noise level
+ * \param maxNumSteps number of steps
+ * \param warmStart warm start the linear assignment solver
+ * \param lapEngine assignment engine
+ * \param tolerance tolerance for the auction algorithm
+ *
+ * \return the final permutation vector
+ */
+SEXP GA_prepared_align_networks_R(SEXP context, SEXP p, SEXP bStart, 
+    SEXP bEnd, SEXP maxNumSteps, SEXP warmStart, SEXP lapEngine, 
+    SEXP tolerance);
 
 #ifdef __cplusplus
 }
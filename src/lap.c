@@ -32,12 +32,23 @@
    (2006-08-03) - Several minor changes to prevent compiler warnings.
                 - Replaced C++-style comments with C-style comments.
    (2007-08-22) - Replaced malloc/free calls with GA_alloc/GA_free proxies.
+   (2026-10-16) - Added LAP_lap_warm() for warm starts from the dual 
+                  variables and the assignment of a previous solution.
+                - Moved the solver to lap_impl.h and added 
+                  LAP_lap_warm_int64() and LAP_lap_warm_real().
+                - Added LAP_lapsp_warm() for sparse problems.
+                - Added vectorized scan kernels (lap_simd.h).
+                - Added LAP_lap_rect_real() for rectangular problems.
+                - Added solver workspaces (LAP_workspace_create()).
  */
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
+#include <float.h>
 #include "gnrl.h"
 #include "lap.h"
+#include "lap_simd.h"
 #include "GA_alloc.h"
 
 int LAP_lap(int dim, 
@@ -46,10 +57,87 @@ int LAP_lap(int dim,
         row *colsol, 
         cost *u, 
         cost *v)
+{
+  return LAP_lap_warm(dim, assigncost, rowsol, colsol, u, v, FALSE);
+}
+
+LAPWorkspace *LAP_workspace_create(int dim)
+{
+  LAPWorkspace *workspace = (LAPWorkspace*)GA_alloc(1, sizeof(LAPWorkspace));
+
+  workspace->dim = dim;
+  workspace->rfree = (row*)GA_alloc(dim, sizeof(row));
+  workspace->collist = (col*)GA_alloc(dim, sizeof(col));
+  workspace->matches = (col*)GA_alloc(dim, sizeof(col));
+  workspace->pred = (row*)GA_alloc(dim, sizeof(row));
+  /* room for the widest dual type. */
+  workspace->d = GA_alloc(dim, sizeof(int64_t) > sizeof(double) 
+    ? sizeof(int64_t) : sizeof(double));
+  return workspace;
+}
+
+void LAP_workspace_destroy(LAPWorkspace *workspace)
+{
+  GA_free((char*)workspace->pred);
+  GA_free((char*)workspace->rfree);
+  GA_free((char*)workspace->collist);
+  GA_free((char*)workspace->matches);
+  GA_free((char*)workspace->d);
+  GA_free((char*)workspace);
+}
+
+/* int costs, int dual variables. */
+#define LAP_FUNC LAP_lap_warm
+#define LAP_FUNC_WS LAP_lap_warm_ws
+#define LAP_COST cost
+#define LAP_DUAL cost
+#define LAP_BIG BIG
+#define LAP_KERNELS LAPKernelsInt
+#define LAP_GET_KERNELS LAP_get_kernels_int
+#define LAP_LIMIT_RR 0
+#include "lap_impl.h"
+
+/* int costs, 64 bit dual variables. */
+#define LAP_FUNC LAP_lap_warm_int64
+#define LAP_FUNC_WS LAP_lap_warm_int64_ws
+#define LAP_COST cost
+#define LAP_DUAL int64_t
+#define LAP_BIG INT64_MAX
+#define LAP_KERNELS LAPKernelsInt64
+#define LAP_GET_KERNELS LAP_get_kernels_int64
+#define LAP_LIMIT_RR 0
+#include "lap_impl.h"
+
+/* real costs, real dual variables. */
+#define LAP_FUNC LAP_lap_warm_real
+#define LAP_FUNC_WS LAP_lap_warm_real_ws
+#define LAP_COST double
+#define LAP_DUAL double
+#define LAP_BIG DBL_MAX
+#define LAP_KERNELS LAPKernelsReal
+#define LAP_GET_KERNELS LAP_get_kernels_real
+#define LAP_LIMIT_RR 1
+#include "lap_impl.h"
+
+boolean LAP_lapsp_warm(int dim, 
+        int *first,
+        col *kk,
+        double *cc,
+        col *rowsol, 
+        row *colsol, 
+        double *u, 
+        double *v,
+        boolean warmstart)
 /*
  input:
  dim        - problem size
- assigncost - cost matrix
+ first      - index of the first candidate of each row in kk and cc 
+              (dim + 1 entries)
+ kk         - column of each candidate
+ cc         - cost of each candidate
+ rowsol     - column assigned to row in previous solution (if warmstart)
+ v          - dual variables of previous solution (if warmstart)
+ warmstart  - start from previous solution
 
  output:
  rowsol     - column assigned to row in solution
@@ -59,49 +147,102 @@ int LAP_lap(int dim,
 */
 
 {
-  boolean unassignedfound;
-  row  i, imin, numfree = 0, prvnumfree, f, i0, k, freerow, *pred, *rfree;
-  col  j, j1, j2, endofpath, last, low, up, *collist, *matches;
-  cost min, h, umin, usubmin, v2, *d;
+  boolean unassignedfound, feasible = TRUE;
+  row  i, numfree = 0, prvnumfree, f, i0, k, freerow, *pred, *rfree;
+  col  j, j1, j2, endofpath, last, low, up, *collist, *matches, *colpos;
+  int  t;
+  double min, h, umin, usubmin, v2, *d;
+  int loopcnt;
+  long rrcnt, maxrrcnt;
 
   rfree = (row*)GA_alloc(dim, sizeof(row));
   collist = (col*)GA_alloc(dim, sizeof(col));
+  colpos = (col*)GA_alloc(dim, sizeof(col));
   matches = (col*)GA_alloc(dim, sizeof(col));
-  d = (cost*)GA_alloc(dim, sizeof(cost));
+  d = (double*)GA_alloc(dim, sizeof(double));
   pred = (row*)GA_alloc(dim, sizeof(row));
-  /*
-  free = new row[dim];       // list of unassigned rows.
-  collist = new col[dim];    // list of columns to be scanned in various ways.
-  matches = new col[dim];    // counts how many times a row could be assigned.
-  d = new cost[dim];         // 'cost-distance' in augmenting path calculation.
-  pred = new row[dim];       // row-predecessor of column in augmenting/alternating path.
-  */
 
   j2 = 0;
-  
-  /* init how many times a row will be assigned in the column reduction. */
-  for (i = 0; i < dim; i++)  
-    matches[i] = 0;
+  last = 0;
+  endofpath = 0;
+  min = 0;
 
-  /* COLUMN REDUCTION */ 
-  for (j = dim-1; j >= 0; j--)    /* reverse order gives better results. */
+  /* a row without candidates cannot be assigned. */
+  for (i = 0; i < dim; i++)
+    if (first[i] == first[i+1])
+    {
+      feasible = FALSE;
+      goto done;
+    }
+
+  if (warmstart)
   {
-    /* find minimum cost over rows. */
-    min = assigncost[0][j]; 
-    imin = 0;
-    for (i = 1; i < dim; i++)  
-      if (assigncost[i][j] < min) 
-      { 
-        min = assigncost[i][j]; 
-        imin = i;
+    /* WARM START
+       keep the previous assignment of each row whose column is still a 
+       candidate with the minimum reduced cost in that row (see 
+       LAP_lap_warm()). */
+    for (j = 0; j < dim; j++)
+      colsol[j] = -1;
+    for (i = 0; i < dim; i++)
+    {
+      j1 = rowsol[i];
+      if ((j1 >= 0) && (j1 < dim) && (colsol[j1] < 0))
+      {
+        for (t = first[i]; t < first[i+1]; t++)
+          if (kk[t] == j1)
+            break;
+        if (t < first[i+1])
+        {
+          min = cc[t] - v[j1];
+          for (t = first[i]; t < first[i+1]; t++)
+            if (cc[t] - v[kk[t]] < min)
+              break;
+          if (t == first[i+1])
+          {
+            colsol[j1] = i;
+            continue;
+          }
+        }
       }
-    v[j] = min; 
+      rfree[numfree++] = i;
+    }
+    goto rowreduction;
+  }
 
-    if (++matches[imin] == 1) 
+  /* COLUMN REDUCTION 
+     the minimum over the candidates of each column is found by a pass 
+     over the rows. pred holds the row of the minimum. */
+  for (j = 0; j < dim; j++)
+  {
+    v[j] = DBL_MAX;
+    pred[j] = -1;
+  }
+  for (i = 0; i < dim; i++)
+  {
+    matches[i] = 0;
+    for (t = first[i]; t < first[i+1]; t++)
+    {
+      j = kk[t];
+      if (cc[t] < v[j])
+      {
+        v[j] = cc[t];
+        pred[j] = i;
+      }
+    }
+  }
+  for (j = dim-1; j >= 0; j--)    /* reverse order gives better results. */
+  {
+    i = pred[j];
+    if (i < 0)                    /* column without candidates. */
+    {
+      feasible = FALSE;
+      goto done;
+    }
+    if (++matches[i] == 1) 
     { 
       /* init assignment if minimum row assigned for first time. */
-      rowsol[imin] = j; 
-      colsol[j] = imin; 
+      rowsol[i] = j; 
+      colsol[j] = i; 
     }
     else
       colsol[j] = -1;        /* row already assigned, column not assigned. */
@@ -115,37 +256,41 @@ int LAP_lap(int dim,
       if (matches[i] == 1)   /* transfer reduction from rows that are assigned once. */
       {
         j1 = rowsol[i]; 
-        min = BIG;
-        for (j = 0; j < dim; j++)  
-          if (j != j1)
-            if (assigncost[i][j] - v[j] < min) 
-              min = assigncost[i][j] - v[j];
-        v[j1] = v[j1] - min;
+        min = DBL_MAX;
+        for (t = first[i]; t < first[i+1]; t++)  
+          if (kk[t] != j1)
+            if (cc[t] - v[kk[t]] < min) 
+              min = cc[t] - v[kk[t]];
+        if (min < DBL_MAX)   /* nothing to transfer for a single candidate. */
+          v[j1] = v[j1] - min;
       }
 
   /* AUGMENTING ROW REDUCTION */ 
-  int loopcnt = 0;           /* do-loop to be done twice. */
+rowreduction:
+  loopcnt = 0;               /* do-loop to be done twice. */
   do
   {
     loopcnt++;
 
-    /* scan all free rows.
-       in some cases, a free row may be replaced with another one to be scanned next. */
     k = 0; 
     prvnumfree = numfree; 
     numfree = 0;             /* start list of rows still free after augmenting row reduction. */
+    rrcnt = 0;
+    maxrrcnt = (long)prvnumfree * dim;
     while (k < prvnumfree)
     {
       i = rfree[k]; 
       k++;
 
-      /* find minimum and second minimum reduced cost over columns. */
-      umin = assigncost[i][0] - v[0]; 
-      j1 = 0; 
-      usubmin = BIG;
-      for (j = 1; j < dim; j++) 
+      /* find minimum and second minimum reduced cost over candidates. */
+      umin = DBL_MAX;
+      usubmin = DBL_MAX;
+      j1 = -1;
+      j2 = -1;
+      for (t = first[i]; t < first[i+1]; t++) 
       {
-        h = assigncost[i][j] - v[j];
+        j = kk[t];
+        h = cc[t] - v[j];
         if (h < usubmin)
         {
           if (h >= umin) 
@@ -163,6 +308,18 @@ int LAP_lap(int dim,
         }
       }
 
+      if (j2 < 0)            /* single candidate, the reduction cannot be changed. */
+      {
+        if (colsol[j1] < 0)
+        {
+          rowsol[i] = j1; 
+          colsol[j1] = i;
+        }
+        else
+          rfree[numfree++] = i;
+        continue;
+      }
+
       i0 = colsol[j1];
       if (umin < usubmin) 
         /* change the reduction of the minimum column to increase the minimum
@@ -182,7 +339,7 @@ int LAP_lap(int dim,
 
       if (i0 >= 0)           /* minimum column j1 assigned earlier. */
       {
-        if (umin < usubmin) 
+        if ((umin < usubmin) && (++rrcnt < maxrrcnt))
           /* put in current k, and go back to that k.
              continue augmenting path i - j1 with i0. */
           rfree[--k] = i0; 
@@ -201,18 +358,20 @@ int LAP_lap(int dim,
     freerow = rfree[f];       /* start row of augmenting path. */
 
     /* Dijkstra shortest path algorithm.
-       runs until unassigned column added to shortest path tree. */
+       columns which are not candidates of a scanned row have distance 
+       DBL_MAX. colpos holds the position of each column in collist. */
     for (j = 0; j < dim; j++)  
     { 
-      d[j] = assigncost[freerow][j] - v[j]; 
+      d[j] = DBL_MAX; 
       pred[j] = freerow;
-      collist[j] = j;        /* init column list. */
+      collist[j] = j;
+      colpos[j] = j;
     }
+    for (t = first[freerow]; t < first[freerow+1]; t++)
+      d[kk[t]] = cc[t] - v[kk[t]];
 
     low = 0; /* columns in 0..low-1 are ready, now none. */
-    up = 0;  /* columns in low..up-1 are to be scanned for current minimum, now none.
-                columns in up..dim-1 are to be considered later to find new minimum, 
-                at this stage the list simply contains all columns */
+    up = 0;  /* columns in low..up-1 are to be scanned for current minimum, now none. */
     unassignedfound = FALSE;
     do
     {
@@ -234,12 +393,20 @@ int LAP_lap(int dim,
               up = low;      /* restart list at index low. */
               min = h;
             }
-            /* new index with same minimum, put on undex up, and extend list. */
             collist[k] = collist[up]; 
-            collist[up++] = j; 
+            colpos[collist[k]] = k;
+            collist[up] = j; 
+            colpos[j] = up++;
           }
         }
 
+        /* no column can be reached from the free row. */
+        if (min == DBL_MAX)
+        {
+          feasible = FALSE;
+          goto done;
+        }
+
         /* check if any of the minimum columns happens to be unassigned.
            if so, we have an augmenting path right away. */
         for (k = low; k < up; k++) 
@@ -253,16 +420,22 @@ int LAP_lap(int dim,
 
       if (!unassignedfound) 
       {
-        /* update 'distances' between freerow and all unscanned columns, via next scanned column. */
+        /* update 'distances' between freerow and all unscanned candidate 
+           columns, via next scanned column. */
         j1 = collist[low]; 
         low++; 
         i = colsol[j1]; 
-        h = assigncost[i][j1] - v[j1] - min;
+        for (t = first[i]; t < first[i+1]; t++)
+          if (kk[t] == j1)
+            break;
+        h = cc[t] - v[j1] - min;
 
-        for (k = up; k < dim; k++) 
+        for (t = first[i]; t < first[i+1]; t++) 
         {
-          j = collist[k]; 
-          v2 = assigncost[i][j] - v[j] - h;
+          j = kk[t]; 
+          if (colpos[j] < up)  /* column already scanned or to be scanned. */
+            continue;
+          v2 = cc[t] - v[j] - h;
           if (v2 < d[j])
           {
             pred[j] = i;
@@ -278,8 +451,11 @@ int LAP_lap(int dim,
               /* else add to list to be scanned right away. */
               else 
               { 
+                k = colpos[j];
                 collist[k] = collist[up]; 
-                collist[up++] = j; 
+                colpos[collist[k]] = k;
+                collist[up] = j; 
+                colpos[j] = up++;
               }
             }
             d[j] = v2;
@@ -308,22 +484,196 @@ int LAP_lap(int dim,
     while (i != freerow);
   }
 
-  /* calculate optimal cost. */
-  cost lapcost = 0;
+  /* calculate row reductions. */
   for (i = 0; i < dim; i++)  
   {
     j = rowsol[i];
-    u[i] = assigncost[i][j] - v[j];
-    lapcost = lapcost + assigncost[i][j]; 
+    for (t = first[i]; t < first[i+1]; t++)
+      if (kk[t] == j)
+        u[i] = cc[t] - v[j];
   }
 
+done:
   /* free reserved memory. */
   GA_free((char*)pred);
   GA_free((char*)rfree);
   GA_free((char*)collist);
+  GA_free((char*)colpos);
   GA_free((char*)matches);
   GA_free((char*)d);
 
+  return feasible;
+}
+
+double LAP_lap_rect_real(int rows, 
+        int cols,
+        double **assigncost,
+        col *rowsol,
+        row *colsol,
+        double *u,
+        double *v)
+/*
+ input:
+ rows       - number of rows (at most cols)
+ cols       - number of columns
+ assigncost - cost matrix
+
+ output:
+ rowsol     - column assigned to row in solution
+ colsol     - row assigned to column in solution, or -1
+ u          - dual variables, row reduction numbers
+ v          - dual variables, column reduction numbers
+*/
+
+{
+  boolean unassignedfound;
+  row  i, f, k, freerow, *pred;
+  col  j, j1, endofpath, last, low, up, *collist;
+  double min, h, v2, *d, lapcost;
+  const LAPKernelsReal *kernels = LAP_get_kernels_real();
+
+  collist = (col*)GA_alloc(cols, sizeof(col));
+  d = (double*)GA_alloc(cols, sizeof(double));
+  pred = (row*)GA_alloc(cols, sizeof(row));
+
+  last = 0;
+  endofpath = 0;
+  min = 0;
+
+  /* the column reduction and the augmenting row reduction are skipped, 
+     since the prices of the columns which remain unassigned must stay at
+     zero. all rows are augmented, starting from zero prices. */
+  for (j = 0; j < cols; j++)
+  {
+    v[j] = 0;
+    colsol[j] = -1;
+  }
+
+  /* AUGMENT SOLUTION for each row. */
+  for (f = 0; f < rows; f++)
+  {
+    freerow = f;              /* start row of augmenting path. */
+
+    /* Dijkstra shortest path algorithm.
+       runs until unassigned column added to shortest path tree. */
+    for (j = 0; j < cols; j++)
+    {
+      d[j] = assigncost[freerow][j] - v[j];
+      pred[j] = freerow;
+      collist[j] = j;        /* init column list. */
+    }
+
+    low = 0; /* columns in 0..low-1 are ready, now none. */
+    up = 0;  /* columns in low..up-1 are to be scanned for current minimum, now none. */
+    unassignedfound = FALSE;
+    do
+    {
+      if (up == low)         /* no more columns to be scanned for current minimum. */
+      {
+        last = low - 1;
+
+        /* scan columns for up..cols-1 to find all indices for which new minimum occurs.
+           store these indices between low..up-1 (increasing up). */
+        min = d[collist[up++]];
+        for (k = up; k < cols; k++)
+        {
+          j = collist[k];
+          h = d[j];
+          if (h <= min)
+          {
+            if (h < min)     /* new minimum. */
+            {
+              up = low;      /* restart list at index low. */
+              min = h;
+            }
+            collist[k] = collist[up];
+            collist[up++] = j;
+          }
+        }
+
+        /* check if any of the minimum columns happens to be unassigned.
+           if so, we have an augmenting path right away. */
+        for (k = low; k < up; k++)
+          if (colsol[collist[k]] < 0)
+          {
+            endofpath = collist[k];
+            unassignedfound = TRUE;
+            break;
+          }
+      }
+
+      if (!unassignedfound)
+      {
+        /* update 'distances' between freerow and all unscanned columns, via next scanned column. */
+        j1 = collist[low];
+        low++;
+        i = colsol[j1];
+        h = assigncost[i][j1] - v[j1] - min;
+
+        for (k = up; k < cols; k++)
+        {
+          /* skip to the next column whose distance is reduced. */
+          k = kernels->scan(k, cols, assigncost[i], v, d, collist, h);
+          if (k == cols)
+            break;
+          j = collist[k];
+          v2 = assigncost[i][j] - v[j] - h;
+          pred[j] = i;
+          if (v2 == min)     /* new column found at same minimum value */
+          {
+            if (colsol[j] < 0)
+            {
+              /* if unassigned, shortest augmenting path is complete. */
+              endofpath = j;
+              unassignedfound = TRUE;
+              break;
+            }
+            /* else add to list to be scanned right away. */
+            else
+            {
+              collist[k] = collist[up];
+              collist[up++] = j;
+            }
+          }
+          d[j] = v2;
+        }
+      }
+    }
+    while (!unassignedfound);
+
+    /* update column prices. */
+    for (k = 0; k <= last; k++)
+    {
+      j1 = collist[k];
+      v[j1] = v[j1] + d[j1] - min;
+    }
+
+    /* reset row and column assignments along the alternating path. */
+    do
+    {
+      i = pred[endofpath];
+      colsol[endofpath] = i;
+      j1 = endofpath;
+      endofpath = rowsol[i];
+      rowsol[i] = j1;
+    }
+    while (i != freerow);
+  }
+
+  /* calculate optimal cost. */
+  lapcost = 0;
+  for (i = 0; i < rows; i++)
+  {
+    j = rowsol[i];
+    u[i] = assigncost[i][j] - v[j];
+    lapcost = lapcost + assigncost[i][j];
+  }
+
+  /* free reserved memory. */
+  GA_free((char*)pred);
+  GA_free((char*)collist);
+  GA_free((char*)d);
+
   return lapcost;
 }
 
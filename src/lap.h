@@ -33,8 +33,15 @@
                 - Added conditional extern "C" tags.
    (2006-07-12) - Changed BIG to something bigger to prevent segfaults 
                   with matrices containing large values.
+   (2026-10-16) - Added LAP_lap_warm(), LAP_lap_warm_int64() and 
+                  LAP_lap_warm_real().
+                - Added LAP_lapsp_warm().
+                - Added LAP_lap_rect_real().
+                - Added LAPWorkspace and the solvers which use it.
  */
 
+#include <stdint.h>
+
 /*************** CONSTANTS  *******************/
 
   #define BIG 2147483647
@@ -45,6 +52,38 @@
   typedef int col;
   typedef int cost;
 
+/** Solver workspace.
+ *
+ * Scratch buffers of the dense solvers for problems up to a maximum size. 
+ * A workspace can be reused for many problems, so that the solvers do not 
+ * allocate memory, e.g. if problems are solved in parallel threads, in 
+ * which the allocation functions (see GA_alloc.h) may not be safe to use. 
+ * Use LAP_workspace_create() to create a workspace and 
+ * LAP_workspace_destroy() to release it.
+ */
+typedef struct
+{
+    /** Maximum problem size.
+     */
+    int dim;
+    /** List of unassigned rows.
+     */
+    row *rfree;
+    /** List of columns to be scanned.
+     */
+    col *collist;
+    /** Number of times a row could be assigned.
+     */
+    col *matches;
+    /** Row predecessor of a column in an augmenting path.
+     */
+    row *pred;
+    /** Distances in the augmenting path search (room for \c dim elements 
+     * of any dual type).
+     */
+    void *d;
+} LAPWorkspace;
+
 /*************** FUNCTIONS  *******************/
 
 #ifdef __cplusplus
@@ -66,6 +105,195 @@ extern "C"
 int LAP_lap(int dim, int **assigncost, 
     int *rowsol, int *colsol, int *u, int *v);
 
+/** Solve linear assignment problem (warm start).
+ *
+ * Solve a linear assignment problem, optionally starting from a previous 
+ * solution. If \c warmstart is nonzero, \c rowsol and \c v must contain 
+ * the assignment and the column dual variables of a previous solution, 
+ * e.g. for a cost matrix which differs only slightly. The column reduction 
+ * phase is skipped: rows keep their previous column as long as it has the 
+ * minimum reduced cost, and only the remaining rows go through the 
+ * augmenting row reduction and augmentation phases. 
+ * The result is an optimal assignment in either case, but if there are 
+ * several optimal assignments, a warm start may find a different one.
+ *
+ * \param dim problem size
+ * \param assigncost cost matrix
+ * \param rowsol column assigned to row in solution
+ * \param colsol row assigned to column in solution
+ * \param u dual variables, row reduction numbers
+ * \param v dual variables, column reduction numbers
+ * \param warmstart start from the previous solution in rowsol and v
+ */
+int LAP_lap_warm(int dim, int **assigncost, 
+    int *rowsol, int *colsol, int *u, int *v, int warmstart);
+
+/** Solve linear assignment problem (64 bit dual variables).
+ *
+ * Solve a linear assignment problem, optionally starting from a previous 
+ * solution (see LAP_lap_warm()). The dual variables and the reduced costs 
+ * are 64 bit integers, so they cannot overflow even if the costs span the 
+ * whole range of \c int.
+ *
+ * \param dim problem size
+ * \param assigncost cost matrix
+ * \param rowsol column assigned to row in solution
+ * \param colsol row assigned to column in solution
+ * \param u dual variables, row reduction numbers
+ * \param v dual variables, column reduction numbers
+ * \param warmstart start from the previous solution in rowsol and v
+ *
+ * \return optimal cost
+ */
+int64_t LAP_lap_warm_int64(int dim, int **assigncost, 
+    int *rowsol, int *colsol, int64_t *u, int64_t *v, int warmstart);
+
+/** Solve linear assignment problem (real).
+ *
+ * Solve a linear assignment problem with real costs, optionally starting 
+ * from a previous solution (see LAP_lap_warm()). The costs are used as 
+ * they are, without rounding them to integers first.
+ *
+ * \param dim problem size
+ * \param assigncost cost matrix
+ * \param rowsol column assigned to row in solution
+ * \param colsol row assigned to column in solution
+ * \param u dual variables, row reduction numbers
+ * \param v dual variables, column reduction numbers
+ * \param warmstart start from the previous solution in rowsol and v
+ *
+ * \return optimal cost
+ */
+double LAP_lap_warm_real(int dim, double **assigncost, 
+    int *rowsol, int *colsol, double *u, double *v, int warmstart);
+
+/** Create solver workspace.
+ *
+ * Create a workspace for the dense solvers for problems of size up to 
+ * \c dim.
+ *
+ * \param dim maximum problem size
+ *
+ * \return the workspace
+ */
+LAPWorkspace *LAP_workspace_create(int dim);
+
+/** Destroy solver workspace.
+ *
+ * \param workspace workspace
+ */
+void LAP_workspace_destroy(LAPWorkspace *workspace);
+
+/** Solve linear assignment problem (workspace).
+ *
+ * Solve a linear assignment problem like LAP_lap_warm(), using the 
+ * scratch buffers of a workspace instead of allocating them, so the 
+ * function does not allocate memory if \c workspace is not 0.
+ *
+ * \param dim problem size
+ * \param assigncost cost matrix
+ * \param rowsol column assigned to row in solution
+ * \param colsol row assigned to column in solution
+ * \param u dual variables, row reduction numbers
+ * \param v dual variables, column reduction numbers
+ * \param warmstart start from the previous solution in rowsol and v
+ * \param workspace workspace for problems of size \c dim or larger, or 0 
+ * to allocate the scratch buffers
+ *
+ * \return optimal cost
+ */
+int LAP_lap_warm_ws(int dim, int **assigncost, int *rowsol, int *colsol, 
+    int *u, int *v, int warmstart, LAPWorkspace *workspace);
+
+/** Solve linear assignment problem (64 bit dual variables, workspace).
+ *
+ * Solve a linear assignment problem like LAP_lap_warm_int64(), using the 
+ * scratch buffers of a workspace (see LAP_lap_warm_ws()).
+ *
+ * \param dim problem size
+ * \param assigncost cost matrix
+ * \param rowsol column assigned to row in solution
+ * \param colsol row assigned to column in solution
+ * \param u dual variables, row reduction numbers
+ * \param v dual variables, column reduction numbers
+ * \param warmstart start from the previous solution in rowsol and v
+ * \param workspace workspace, or 0 to allocate the scratch buffers
+ *
+ * \return optimal cost
+ */
+int64_t LAP_lap_warm_int64_ws(int dim, int **assigncost, int *rowsol, 
+    int *colsol, int64_t *u, int64_t *v, int warmstart, 
+    LAPWorkspace *workspace);
+
+/** Solve linear assignment problem (real, workspace).
+ *
+ * Solve a linear assignment problem like LAP_lap_warm_real(), using the 
+ * scratch buffers of a workspace (see LAP_lap_warm_ws()).
+ *
+ * \param dim problem size
+ * \param assigncost cost matrix
+ * \param rowsol column assigned to row in solution
+ * \param colsol row assigned to column in solution
+ * \param u dual variables, row reduction numbers
+ * \param v dual variables, column reduction numbers
+ * \param warmstart start from the previous solution in rowsol and v
+ * \param workspace workspace, or 0 to allocate the scratch buffers
+ *
+ * \return optimal cost
+ */
+double LAP_lap_warm_real_ws(int dim, double **assigncost, int *rowsol, 
+    int *colsol, double *u, double *v, int warmstart, 
+    LAPWorkspace *workspace);
+
+/** Solve sparse linear assignment problem.
+ *
+ * Solve a linear assignment problem in which each row can only be 
+ * assigned to a list of candidate columns, optionally starting from a 
+ * previous solution (see LAP_lap_warm()). The candidates of row \c i are 
+ * the columns <tt>kk[t]</tt> with costs <tt>cc[t]</tt> for 
+ * <tt>first[i] <= t < first[i + 1]</tt>, i.e. the cost matrix is stored 
+ * in compressed sparse row format, and only the candidates are scanned. 
+ * There may be no assignment which uses only candidates, in which case 
+ * the solution is undefined.
+ *
+ * \param dim problem size
+ * \param first index of the first candidate of each row (dim + 1 entries)
+ * \param kk column of each candidate
+ * \param cc cost of each candidate
+ * \param rowsol column assigned to row in solution
+ * \param colsol row assigned to column in solution
+ * \param u dual variables, row reduction numbers
+ * \param v dual variables, column reduction numbers
+ * \param warmstart start from the previous solution in rowsol and v
+ *
+ * \return 1 if a complete assignment has been found, 0 otherwise
+ */
+int LAP_lapsp_warm(int dim, int *first, int *kk, double *cc, 
+    int *rowsol, int *colsol, double *u, double *v, int warmstart);
+
+/** Solve rectangular linear assignment problem (real).
+ *
+ * Solve a linear assignment problem with real costs and fewer rows than 
+ * columns, in which each row is assigned to a column and the remaining 
+ * columns are left unassigned. The problem is solved by a shortest 
+ * augmenting path for each row, starting from zero column prices, since 
+ * the column reduction of the square solver would assign a price to 
+ * columns which may remain unassigned.
+ *
+ * \param rows number of rows (at most \c cols)
+ * \param cols number of columns
+ * \param assigncost cost matrix
+ * \param rowsol column assigned to row in solution
+ * \param colsol row assigned to column in solution, or -1 if the column is 
+ * not assigned
+ * \param u dual variables, row reduction numbers
+ * \param v dual variables, column reduction numbers
+ *
+ * \return optimal cost
+ */
+double LAP_lap_rect_real(int rows, int cols, double **assigncost, 
+    int *rowsol, int *colsol, double *u, double *v);
+
 /** Check linear assignment solution.
  *
  * Check a linear assignment solution (?).
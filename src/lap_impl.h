@@ -0,0 +1,401 @@
+/************************************************************************
+*
+*  lap.cpp
+   version 1.0 - 4 September 1996
+   author: Roy Jonker @ MagicLogic Optimization Inc.
+   e-mail: roy_jonker@magiclogic.com
+
+   Code for Linear Assignment Problem, according to 
+   
+   "A Shortest Augmenting Path Algorithm for Dense and Sparse Linear   
+    Assignment Problems," Computing 38, 325-340, 1987
+   
+   by
+   
+   R. Jonker and A. Volgenant, University of Amsterdam.
+*
+*************************************************************************/
+
+/** \file lap_impl.h
+ * \brief Linear assignment problem solver (implementation template).
+ *
+ * This file contains the body of the solver and is included by lap.c once 
+ * for each cost type. The including file must define the following macros, 
+ * which are undefined at the end of this file:
+ *
+ * - \c LAP_FUNC name of the function
+ * - \c LAP_FUNC_WS name of the function which uses a solver workspace
+ * - \c LAP_COST type of the elements of the cost matrix
+ * - \c LAP_DUAL type of the dual variables, the reduced costs and the 
+ *   returned optimal cost
+ * - \c LAP_BIG largest value of \c LAP_DUAL
+ * - \c LAP_KERNELS type of the scan kernels (see lap_simd.h)
+ * - \c LAP_GET_KERNELS function which returns the scan kernels
+ * - \c LAP_LIMIT_RR 1 to limit the number of row replacements in the 
+ *   augmenting row reduction, which is needed for real costs, or 0 to 
+ *   keep the original reduction of the integer solver
+ */
+
+/* Some changes by Joern P. Meier <mail@ionflux.org>:
+   
+   (2026-10-16) - Moved the body of LAP_lap_warm() from lap.c to this 
+                  file, with macros for the cost and dual types.
+                - Added a shortcut for problems of size 1.
+                - Limited the number of row replacements in the 
+                  augmenting row reduction for real costs.
+                - Moved the scans of the column reduction, the augmenting 
+                  row reduction and the shortest path search to 
+                  vectorized kernels (lap_simd.c).
+                - Moved the scratch buffers to an optional solver 
+                  workspace (LAPWorkspace).
+ */
+
+LAP_DUAL LAP_FUNC_WS(int dim, 
+        LAP_COST **assigncost,
+        col *rowsol, 
+        row *colsol, 
+        LAP_DUAL *u, 
+        LAP_DUAL *v,
+        boolean warmstart,
+        LAPWorkspace *workspace)
+/*
+ input:
+ dim        - problem size
+ assigncost - cost matrix
+ rowsol     - column assigned to row in previous solution (if warmstart)
+ v          - dual variables of previous solution (if warmstart)
+ warmstart  - start from previous solution
+ workspace  - scratch buffers for problems of size dim or larger, or 0 
+              to allocate them
+
+ output:
+ rowsol     - column assigned to row in solution
+ colsol     - row assigned to column in solution
+ u          - dual variables, row reduction numbers
+ v          - dual variables, column reduction numbers
+*/
+
+{
+  boolean unassignedfound;
+  row  i, imin, numfree = 0, prvnumfree, f, i0, k, freerow, *pred, *rfree;
+  col  j, j1, j2, endofpath, last, low, up, *collist, *matches;
+  LAP_DUAL min, h, umin, usubmin, v2, *d, lapcost;
+  int loopcnt;
+#if LAP_LIMIT_RR
+  long rrcnt, maxrrcnt;
+#endif
+  const LAP_KERNELS *kernels = LAP_GET_KERNELS();
+  LAPWorkspace *ws = workspace;
+
+  if (ws == 0)
+    ws = LAP_workspace_create(dim);
+  rfree = ws->rfree;
+  collist = ws->collist;
+  matches = ws->matches;
+  d = (LAP_DUAL*)ws->d;
+  pred = ws->pred;
+  /*
+  free = new row[dim];       // list of unassigned rows.
+  collist = new col[dim];    // list of columns to be scanned in various ways.
+  matches = new col[dim];    // counts how many times a row could be assigned.
+  d = new cost[dim];         // 'cost-distance' in augmenting path calculation.
+  pred = new row[dim];       // row-predecessor of column in augmenting/alternating path.
+  */
+
+  j2 = 0;
+  last = 0;
+  min = 0;
+
+  if (dim == 1)
+  {
+    /* TRIVIAL PROBLEM
+       the reduction of the only column is its cost, which also avoids 
+       subtracting BIG from it in the augmenting row reduction. */
+    rowsol[0] = 0;
+    colsol[0] = 0;
+    v[0] = assigncost[0][0];
+    goto optimalcost;
+  }
+
+  if (warmstart)
+  {
+    /* WARM START
+       keep the previous assignment of each row whose column still has the 
+       minimum reduced cost in that row, so that the assignment is 
+       consistent with the column prices v. the column reduction is 
+       skipped, and all other rows go through the augmenting row 
+       reduction, which starts from the previous column prices. */
+    for (j = 0; j < dim; j++)
+      colsol[j] = -1;
+    for (i = 0; i < dim; i++)
+    {
+      j1 = rowsol[i];
+      if ((j1 >= 0) && (j1 < dim) && (colsol[j1] < 0))
+      {
+        min = assigncost[i][j1] - v[j1];
+        for (j = 0; j < dim; j++)
+          if (assigncost[i][j] - v[j] < min)
+            break;
+        if (j == dim)
+        {
+          colsol[j1] = i;
+          continue;
+        }
+      }
+      rfree[numfree++] = i;
+    }
+    goto rowreduction;
+  }
+  
+  /* init how many times a row will be assigned in the column reduction. */
+  for (i = 0; i < dim; i++)  
+    matches[i] = 0;
+
+  /* COLUMN REDUCTION */ 
+  /* find minimum cost over rows for all columns. the rows of the minima 
+     are kept in pred, which is not used before the augmentation. */
+  kernels->colMin(dim, assigncost, v, pred);
+  for (j = dim-1; j >= 0; j--)    /* reverse order gives better results. */
+  {
+    imin = pred[j];
+
+    if (++matches[imin] == 1) 
+    { 
+      /* init assignment if minimum row assigned for first time. */
+      rowsol[imin] = j; 
+      colsol[j] = imin; 
+    }
+    else
+      colsol[j] = -1;        /* row already assigned, column not assigned. */
+  }
+
+  /* REDUCTION TRANSFER */
+  for (i = 0; i < dim; i++) 
+    if (matches[i] == 0)     /* fill list of unassigned 'free' rows. */
+      rfree[numfree++] = i;
+    else
+      if (matches[i] == 1)   /* transfer reduction from rows that are assigned once. */
+      {
+        j1 = rowsol[i]; 
+        min = LAP_BIG;
+        for (j = 0; j < dim; j++)  
+          if (j != j1)
+            if (assigncost[i][j] - v[j] < min) 
+              min = assigncost[i][j] - v[j];
+        v[j1] = v[j1] - min;
+      }
+
+  /* AUGMENTING ROW REDUCTION */ 
+rowreduction:
+  loopcnt = 0;               /* do-loop to be done twice. */
+  do
+  {
+    loopcnt++;
+
+    /* scan all free rows.
+       in some cases, a free row may be replaced with another one to be scanned next. */
+    k = 0; 
+    prvnumfree = numfree; 
+    numfree = 0;             /* start list of rows still free after augmenting row reduction. */
+#if LAP_LIMIT_RR
+    /* limit the number of rows replaced along augmenting paths. with real 
+       costs, the rounding of the reduced costs may otherwise let two rows 
+       displace each other forever. */
+    rrcnt = 0;
+    maxrrcnt = (long)prvnumfree * dim;
+#endif
+    while (k < prvnumfree)
+    {
+      i = rfree[k]; 
+      k++;
+
+      /* find minimum and second minimum reduced cost over columns. */
+      kernels->rowMin(dim, assigncost[i], v, &umin, &usubmin, &j1, &j2);
+
+      i0 = colsol[j1];
+      if (umin < usubmin) 
+        /* change the reduction of the minimum column to increase the minimum
+           reduced cost in the row to the subminimum. */
+        v[j1] = v[j1] - (usubmin - umin);
+      else                   /* minimum and subminimum equal. */
+        if (i0 >= 0)         /* minimum column j1 is assigned. */
+        { 
+          /* swap columns j1 and j2, as j2 may be unassigned. */
+          j1 = j2; 
+          i0 = colsol[j2];
+        }
+
+      /* (re-)assign i to j1, possibly de-assigning an i0. */
+      rowsol[i] = j1; 
+      colsol[j1] = i;
+
+      if (i0 >= 0)           /* minimum column j1 assigned earlier. */
+      {
+#if LAP_LIMIT_RR
+        if ((umin < usubmin) && (++rrcnt < maxrrcnt))
+#else
+        if (umin < usubmin) 
+#endif
+          /* put in current k, and go back to that k.
+             continue augmenting path i - j1 with i0. */
+          rfree[--k] = i0; 
+        else 
+          /* no further augmenting reduction possible.
+             store i0 in list of free rows for next phase. */
+          rfree[numfree++] = i0;
+      }
+    }
+  }
+  while (loopcnt < 2);       /* repeat once. */
+
+  /* AUGMENT SOLUTION for each free row. */
+  for (f = 0; f < numfree; f++) 
+  {
+    freerow = rfree[f];       /* start row of augmenting path. */
+
+    /* Dijkstra shortest path algorithm.
+       runs until unassigned column added to shortest path tree. */
+    for (j = 0; j < dim; j++)  
+    { 
+      d[j] = assigncost[freerow][j] - v[j]; 
+      pred[j] = freerow;
+      collist[j] = j;        /* init column list. */
+    }
+
+    low = 0; /* columns in 0..low-1 are ready, now none. */
+    up = 0;  /* columns in low..up-1 are to be scanned for current minimum, now none.
+                columns in up..dim-1 are to be considered later to find new minimum, 
+                at this stage the list simply contains all columns */
+    unassignedfound = FALSE;
+    do
+    {
+      if (up == low)         /* no more columns to be scanned for current minimum. */
+      {
+        last = low - 1; 
+
+        /* scan columns for up..dim-1 to find all indices for which new minimum occurs.
+           store these indices between low..up-1 (increasing up). */
+        min = d[collist[up++]]; 
+        for (k = up; k < dim; k++) 
+        {
+          j = collist[k]; 
+          h = d[j];
+          if (h <= min)
+          {
+            if (h < min)     /* new minimum. */
+            { 
+              up = low;      /* restart list at index low. */
+              min = h;
+            }
+            /* new index with same minimum, put on undex up, and extend list. */
+            collist[k] = collist[up]; 
+            collist[up++] = j; 
+          }
+        }
+
+        /* check if any of the minimum columns happens to be unassigned.
+           if so, we have an augmenting path right away. */
+        for (k = low; k < up; k++) 
+          if (colsol[collist[k]] < 0) 
+          {
+            endofpath = collist[k];
+            unassignedfound = TRUE;
+            break;
+          }
+      }
+
+      if (!unassignedfound) 
+      {
+        /* update 'distances' between freerow and all unscanned columns, via next scanned column. */
+        j1 = collist[low]; 
+        low++; 
+        i = colsol[j1]; 
+        h = assigncost[i][j1] - v[j1] - min;
+
+        for (k = up; k < dim; k++) 
+        {
+          /* skip to the next column whose distance is reduced. */
+          k = kernels->scan(k, dim, assigncost[i], v, d, collist, h);
+          if (k == dim)
+            break;
+          j = collist[k]; 
+          v2 = assigncost[i][j] - v[j] - h;
+          pred[j] = i;
+          if (v2 == min)     /* new column found at same minimum value */
+          {
+            if (colsol[j] < 0) 
+            {
+              /* if unassigned, shortest augmenting path is complete. */
+              endofpath = j;
+              unassignedfound = TRUE;
+              break;
+            }
+            /* else add to list to be scanned right away. */
+            else 
+            { 
+              collist[k] = collist[up]; 
+              collist[up++] = j; 
+            }
+          }
+          d[j] = v2;
+        }
+      } 
+    }
+    while (!unassignedfound);
+
+    /* update column prices. */
+    for (k = 0; k <= last; k++)  
+    { 
+      j1 = collist[k]; 
+      v[j1] = v[j1] + d[j1] - min;
+    }
+
+    /* reset row and column assignments along the alternating path. */
+    do
+    {
+      i = pred[endofpath]; 
+      colsol[endofpath] = i; 
+      j1 = endofpath; 
+      endofpath = rowsol[i]; 
+      rowsol[i] = j1;
+    }
+    while (i != freerow);
+  }
+
+  /* calculate optimal cost. */
+optimalcost:
+  lapcost = 0;
+  for (i = 0; i < dim; i++)  
+  {
+    j = rowsol[i];
+    u[i] = assigncost[i][j] - v[j];
+    lapcost = lapcost + assigncost[i][j]; 
+  }
+
+  /* free reserved memory. */
+  if (workspace == 0)
+    LAP_workspace_destroy(ws);
+
+  return lapcost;
+}
+
+LAP_DUAL LAP_FUNC(int dim, 
+        LAP_COST **assigncost,
+        col *rowsol, 
+        row *colsol, 
+        LAP_DUAL *u, 
+        LAP_DUAL *v,
+        boolean warmstart)
+{
+  return LAP_FUNC_WS(dim, assigncost, rowsol, colsol, u, v, warmstart, 0);
+}
+
+
+#undef LAP_FUNC
+#undef LAP_FUNC_WS
+#undef LAP_COST
+#undef LAP_DUAL
+#undef LAP_BIG
+#undef LAP_KERNELS
+#undef LAP_GET_KERNELS
+#undef LAP_LIMIT_RR
@@ -0,0 +1,830 @@
+/* ----------------------------------------------------------------------------
+ * R package for graph alignment
+ * ----------------------------------------------------------------------------
+ *
+ * Author: Joern P. Meier <mail@ionflux.org>
+ * 
+ * The package can be used freely for non-commercial purposes. If you use this 
+ * package, the appropriate paper to cite is J. Berg and M. Laessig, 
+ * "Cross-species analysis of biological networks by Bayesian alignment", 
+ * PNAS 103 (29), 10967-10972 (2006)
+ * 
+ * This software is made available in the hope that it will be useful, but 
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY 
+ * or FITNESS FOR A PARTICULAR PURPOSE.
+ * 
+ * This software contains code for solving linear assignment problems which was 
+ * written by Roy Jonker, MagicLogic Optimization Inc.. Please note that this 
+ * code is copyrighted, (c) 2003 MagicLogic Systems Inc., Canada and may be 
+ * used for non-commercial purposes only. See 
+ * http://www.magiclogic.com/assignment.html for the latest version of the LAP 
+ * code and details on licensing.
+ *
+ * ----------------------------------------------------------------------------
+ * Vectorized scans for the linear assignment problem solver.
+ * ----------------------------------------------------------------------------
+ */
+
+/** \file lap_simd.c
+ * \brief Vectorized scans for the linear assignment problem solver 
+ * (implementation).
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+#include <float.h>
+#include "lap_simd.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+/** Whether the vectorized kernels are compiled.
+ */
+#define LAP_SIMD_X86
+#endif
+
+/** Scalar kernels.
+ *
+ * Define the scalar kernels (see LAPKernelsInt) for the cost type 
+ * \c COST and the dual type \c DUAL with the largest value \c BIG. The 
+ * row minimum kernel is the loop of the original solver. The column 
+ * minima are found by scanning the rows one after another, which reads 
+ * the cost matrix contiguously instead of with a stride. 
+ * LAP_arg_min_tail_<suffix>() completes a vectorized search for the first 
+ * minimum of the reduced costs from the minima and their first columns in 
+ * the lanes (with column -1 for lanes which have not found a value smaller 
+ * than \c init) and the remaining columns from \c lo to \c hi.
+ */
+#define LAP_SIMD_SCALAR(SUFFIX, COST, DUAL, BIG) \
+static void LAP_col_min_generic_##SUFFIX(int dim, COST** c, DUAL* v, \
+    int* imin) \
+{ \
+    int i; \
+    int j; \
+    for (j = 0; j < dim; j++) \
+    { \
+        v[j] = c[0][j]; \
+        imin[j] = 0; \
+    } \
+    for (i = 1; i < dim; i++) \
+    { \
+        const COST* row = c[i]; \
+        for (j = 0; j < dim; j++) \
+            if (row[j] < v[j]) \
+            { \
+                v[j] = row[j]; \
+                imin[j] = i; \
+            } \
+    } \
+} \
+\
+static void LAP_row_min_generic_##SUFFIX(int dim, const COST* c, \
+    const DUAL* v, DUAL* umin, DUAL* usubmin, int* j1, int* j2) \
+{ \
+    DUAL min = c[0] - v[0]; \
+    DUAL subMin = BIG; \
+    int jMin = 0; \
+    int jSubMin = *j2; \
+    int j; \
+    for (j = 1; j < dim; j++) \
+    { \
+        DUAL h = c[j] - v[j]; \
+        if (h < subMin) \
+        { \
+            if (h >= min) \
+            { \
+                subMin = h; \
+                jSubMin = j; \
+            } else \
+            { \
+                subMin = min; \
+                min = h; \
+                jSubMin = jMin; \
+                jMin = j; \
+            } \
+        } \
+    } \
+    *umin = min; \
+    *usubmin = subMin; \
+    *j1 = jMin; \
+    *j2 = jSubMin; \
+} \
+\
+static int LAP_scan_generic_##SUFFIX(int k0, int dim, const COST* c, \
+    const DUAL* v, const DUAL* d, const int* collist, DUAL h) \
+{ \
+    int k; \
+    for (k = k0; k < dim; k++) \
+    { \
+        int j = collist[k]; \
+        if (c[j] - v[j] - h < d[j]) \
+            return k; \
+    } \
+    return dim; \
+} \
+\
+static inline DUAL LAP_arg_min_tail_##SUFFIX(const COST* c, const DUAL* v, \
+    int lo, int hi, const DUAL* lanes, const int* lanesIdx, int numLanes, \
+    DUAL init, int* idx) \
+{ \
+    DUAL result = init; \
+    int best = -1; \
+    int t; \
+    int j; \
+    for (t = 0; t < numLanes; t++) \
+        if ((lanesIdx[t] >= 0) \
+            && ((best < 0) \
+                || (lanes[t] < lanes[best]) \
+                || ((lanes[t] == lanes[best]) \
+                    && (lanesIdx[t] < lanesIdx[best])))) \
+            best = t; \
+    if (best >= 0) \
+    { \
+        result = lanes[best]; \
+        *idx = lanesIdx[best]; \
+    } \
+    for (j = lo; j < hi; j++) \
+        if (c[j] - v[j] < result) \
+        { \
+            result = c[j] - v[j]; \
+            *idx = j; \
+        } \
+    return result; \
+}
+
+LAP_SIMD_SCALAR(int, int, int, INT_MAX)
+LAP_SIMD_SCALAR(int64, int, int64_t, INT64_MAX)
+LAP_SIMD_SCALAR(real, double, double, DBL_MAX)
+
+#ifdef LAP_SIMD_X86
+
+/** Row minima from range scans.
+ *
+ * Define a row minimum kernel (see LAPKernelsInt) for the dual type 
+ * \c DUAL with the largest value \c BIG from a function \c ARG_MIN, 
+ * which returns the minimum of \c init and the reduced costs in a range 
+ * of columns and sets \c idx to the first column in which it occurs, 
+ * unless it is \c init. The minimum is found in one pass over the row, 
+ * and the second minimum in another pass which skips the column of the 
+ * minimum. Both scans have no branches which depend on the data. The 
+ * minima are read back from the columns which have been found, so that 
+ * they are bitwise identical to those of the scalar kernel.
+ */
+#define LAP_SIMD_ROW_MIN(NAME, TARGET, COST, DUAL, BIG, ARG_MIN) \
+__attribute__((target(TARGET))) \
+static void NAME(int dim, const COST* c, const DUAL* v, DUAL* umin, \
+    DUAL* usubmin, int* j1, int* j2) \
+{ \
+    int jMin = 0; \
+    int jSubMin = -1; \
+    ARG_MIN(c, v, 1, dim, c[0] - v[0], &jMin); \
+    DUAL subMin = ARG_MIN(c, v, 0, jMin, BIG, &jSubMin); \
+    ARG_MIN(c, v, jMin + 1, dim, subMin, &jSubMin); \
+    if (jSubMin >= 0) \
+    { \
+        *j2 = jSubMin; \
+        *usubmin = c[jSubMin] - v[jSubMin]; \
+    } else \
+        *usubmin = BIG; \
+    *j1 = jMin; \
+    *umin = c[jMin] - v[jMin]; \
+}
+
+/** Set row of column minima.
+ *
+ * Set the row of the column minima to \c i for the columns selected by the 
+ * bits of \c mask.
+ */
+static inline void LAP_set_rows(int* imin, unsigned int mask, int i)
+{
+    while (mask != 0)
+    {
+        imin[__builtin_ctz(mask)] = i;
+        mask &= mask - 1;
+    }
+}
+
+/* ----- AVX2, int costs, int dual variables ----- */
+
+__attribute__((target("avx2")))
+static void LAP_col_min_avx2_int(int dim, int** c, int* v, int* imin)
+{
+    int i;
+    int j;
+    for (j = 0; j < dim; j++)
+    {
+        v[j] = c[0][j];
+        imin[j] = 0;
+    }
+    for (i = 1; i < dim; i++)
+    {
+        const int* row = c[i];
+        for (j = 0; j + 8 <= dim; j += 8)
+        {
+            __m256i x = _mm256_loadu_si256((const __m256i*)(row + j));
+            __m256i m = _mm256_loadu_si256((const __m256i*)(v + j));
+            __m256i lt = _mm256_cmpgt_epi32(m, x);
+            unsigned int mask = _mm256_movemask_ps(_mm256_castsi256_ps(lt));
+            if (mask != 0)
+            {
+                _mm256_storeu_si256((__m256i*)(v + j), 
+                    _mm256_blendv_epi8(m, x, lt));
+                LAP_set_rows(imin + j, mask, i);
+            }
+        }
+        for ( ; j < dim; j++)
+            if (row[j] < v[j])
+            {
+                v[j] = row[j];
+                imin[j] = i;
+            }
+    }
+}
+
+__attribute__((target("avx2")))
+static int LAP_arg_min_avx2_int(const int* c, const int* v, int lo, int hi, 
+    int init, int* idx)
+{
+    __m256i m = _mm256_set1_epi32(init);
+    __m256i mIdx = _mm256_set1_epi32(-1);
+    __m256i jIdx = _mm256_add_epi32(_mm256_set1_epi32(lo), 
+        _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    int j;
+    for (j = lo; j + 8 <= hi; j += 8)
+    {
+        __m256i h = _mm256_sub_epi32(
+            _mm256_loadu_si256((const __m256i*)(c + j)), 
+            _mm256_loadu_si256((const __m256i*)(v + j)));
+        __m256i lt = _mm256_cmpgt_epi32(m, h);
+        m = _mm256_blendv_epi8(m, h, lt);
+        mIdx = _mm256_blendv_epi8(mIdx, jIdx, lt);
+        jIdx = _mm256_add_epi32(jIdx, _mm256_set1_epi32(8));
+    }
+    int lanes[8];
+    int lanesIdx[8];
+    _mm256_storeu_si256((__m256i*)lanes, m);
+    _mm256_storeu_si256((__m256i*)lanesIdx, mIdx);
+    return LAP_arg_min_tail_int(c, v, j, hi, lanes, lanesIdx, 8, init, idx);
+}
+
+LAP_SIMD_ROW_MIN(LAP_row_min_avx2_int, "avx2", int, int, INT_MAX, 
+    LAP_arg_min_avx2_int)
+
+__attribute__((target("avx2")))
+static int LAP_scan_avx2_int(int k0, int dim, const int* c, const int* v, 
+    const int* d, const int* collist, int h)
+{
+    __m256i hv = _mm256_set1_epi32(h);
+    int k;
+    for (k = k0; k + 8 <= dim; k += 8)
+    {
+        __m256i idx = _mm256_loadu_si256((const __m256i*)(collist + k));
+        __m256i x = _mm256_sub_epi32(_mm256_sub_epi32(
+            _mm256_i32gather_epi32(c, idx, 4), 
+            _mm256_i32gather_epi32(v, idx, 4)), hv);
+        __m256i lt = _mm256_cmpgt_epi32(_mm256_i32gather_epi32(d, idx, 4), 
+            x);
+        unsigned int mask = _mm256_movemask_ps(_mm256_castsi256_ps(lt));
+        if (mask != 0)
+            return k + __builtin_ctz(mask);
+    }
+    return LAP_scan_generic_int(k, dim, c, v, d, collist, h);
+}
+
+/* ----- AVX2, int costs, 64 bit dual variables ----- */
+
+/** Load costs as 64 bit integers (AVX2).
+ */
+__attribute__((target("avx2")))
+static inline __m256i LAP_load_cost_avx2_int64(const int* c)
+{
+    return _mm256_cvtepi32_epi64(_mm_loadu_si128((const __m128i*)c));
+}
+
+__attribute__((target("avx2")))
+static void LAP_col_min_avx2_int64(int dim, int** c, int64_t* v, int* imin)
+{
+    int i;
+    int j;
+    for (j = 0; j < dim; j++)
+    {
+        v[j] = c[0][j];
+        imin[j] = 0;
+    }
+    for (i = 1; i < dim; i++)
+    {
+        const int* row = c[i];
+        for (j = 0; j + 4 <= dim; j += 4)
+        {
+            __m256i x = LAP_load_cost_avx2_int64(row + j);
+            __m256i m = _mm256_loadu_si256((const __m256i*)(v + j));
+            __m256i lt = _mm256_cmpgt_epi64(m, x);
+            unsigned int mask = _mm256_movemask_pd(_mm256_castsi256_pd(lt));
+            if (mask != 0)
+            {
+                _mm256_storeu_si256((__m256i*)(v + j), 
+                    _mm256_blendv_epi8(m, x, lt));
+                LAP_set_rows(imin + j, mask, i);
+            }
+        }
+        for ( ; j < dim; j++)
+            if (row[j] < v[j])
+            {
+                v[j] = row[j];
+                imin[j] = i;
+            }
+    }
+}
+
+__attribute__((target("avx2")))
+static int64_t LAP_arg_min_avx2_int64(const int* c, const int64_t* v, 
+    int lo, int hi, int64_t init, int* idx)
+{
+    __m256i m = _mm256_set1_epi64x(init);
+    __m256i mIdx = _mm256_set1_epi64x(-1);
+    __m256i jIdx = _mm256_add_epi64(_mm256_set1_epi64x(lo), 
+        _mm256_setr_epi64x(0, 1, 2, 3));
+    int j;
+    for (j = lo; j + 4 <= hi; j += 4)
+    {
+        __m256i h = _mm256_sub_epi64(LAP_load_cost_avx2_int64(c + j), 
+            _mm256_loadu_si256((const __m256i*)(v + j)));
+        __m256i lt = _mm256_cmpgt_epi64(m, h);
+        m = _mm256_blendv_epi8(m, h, lt);
+        mIdx = _mm256_blendv_epi8(mIdx, jIdx, lt);
+        jIdx = _mm256_add_epi64(jIdx, _mm256_set1_epi64x(4));
+    }
+    int64_t lanes[4];
+    int64_t lanesIdx64[4];
+    int lanesIdx[4];
+    int t;
+    _mm256_storeu_si256((__m256i*)lanes, m);
+    _mm256_storeu_si256((__m256i*)lanesIdx64, mIdx);
+    for (t = 0; t < 4; t++)
+        lanesIdx[t] = (int)lanesIdx64[t];
+    return LAP_arg_min_tail_int64(c, v, j, hi, lanes, lanesIdx, 4, init, 
+        idx);
+}
+
+LAP_SIMD_ROW_MIN(LAP_row_min_avx2_int64, "avx2", int, int64_t, INT64_MAX, 
+    LAP_arg_min_avx2_int64)
+
+/* ----- AVX2, real costs, real dual variables ----- */
+
+__attribute__((target("avx2")))
+static void LAP_col_min_avx2_real(int dim, double** c, double* v, int* imin)
+{
+    int i;
+    int j;
+    for (j = 0; j < dim; j++)
+    {
+        v[j] = c[0][j];
+        imin[j] = 0;
+    }
+    for (i = 1; i < dim; i++)
+    {
+        const double* row = c[i];
+        for (j = 0; j + 4 <= dim; j += 4)
+        {
+            __m256d x = _mm256_loadu_pd(row + j);
+            __m256d m = _mm256_loadu_pd(v + j);
+            __m256d lt = _mm256_cmp_pd(x, m, _CMP_LT_OQ);
+            unsigned int mask = _mm256_movemask_pd(lt);
+            if (mask != 0)
+            {
+                _mm256_storeu_pd(v + j, _mm256_blendv_pd(m, x, lt));
+                LAP_set_rows(imin + j, mask, i);
+            }
+        }
+        for ( ; j < dim; j++)
+            if (row[j] < v[j])
+            {
+                v[j] = row[j];
+                imin[j] = i;
+            }
+    }
+}
+
+__attribute__((target("avx2")))
+static double LAP_arg_min_avx2_real(const double* c, const double* v, 
+    int lo, int hi, double init, int* idx)
+{
+    __m256d m0 = _mm256_set1_pd(init);
+    __m256d m1 = m0;
+    __m256d mIdx0 = _mm256_set1_pd(-1.);
+    __m256d mIdx1 = mIdx0;
+    __m256d jIdx = _mm256_add_pd(_mm256_set1_pd(lo), 
+        _mm256_setr_pd(0., 1., 2., 3.));
+    int j;
+    /* Two independent minima hide the latency of the comparisons. */
+    for (j = lo; j + 8 <= hi; j += 8)
+    {
+        __m256d h0 = _mm256_sub_pd(_mm256_loadu_pd(c + j), 
+            _mm256_loadu_pd(v + j));
+        __m256d h1 = _mm256_sub_pd(_mm256_loadu_pd(c + j + 4), 
+            _mm256_loadu_pd(v + j + 4));
+        __m256d lt0 = _mm256_cmp_pd(h0, m0, _CMP_LT_OQ);
+        __m256d lt1 = _mm256_cmp_pd(h1, m1, _CMP_LT_OQ);
+        m0 = _mm256_min_pd(h0, m0);
+        m1 = _mm256_min_pd(h1, m1);
+        mIdx0 = _mm256_blendv_pd(mIdx0, jIdx, lt0);
+        mIdx1 = _mm256_blendv_pd(mIdx1, 
+            _mm256_add_pd(jIdx, _mm256_set1_pd(4.)), lt1);
+        jIdx = _mm256_add_pd(jIdx, _mm256_set1_pd(8.));
+    }
+    double lanes[8];
+    int lanesIdx[8];
+    _mm256_storeu_pd(lanes, m0);
+    _mm256_storeu_pd(lanes + 4, m1);
+    _mm_storeu_si128((__m128i*)lanesIdx, _mm256_cvtpd_epi32(mIdx0));
+    _mm_storeu_si128((__m128i*)(lanesIdx + 4), _mm256_cvtpd_epi32(mIdx1));
+    return LAP_arg_min_tail_real(c, v, j, hi, lanes, lanesIdx, 8, init, idx);
+}
+
+LAP_SIMD_ROW_MIN(LAP_row_min_avx2_real, "avx2", double, double, DBL_MAX, 
+    LAP_arg_min_avx2_real)
+
+__attribute__((target("avx2")))
+static int LAP_scan_avx2_real(int k0, int dim, const double* c, 
+    const double* v, const double* d, const int* collist, double h)
+{
+    __m256d hv = _mm256_set1_pd(h);
+    int k;
+    for (k = k0; k + 4 <= dim; k += 4)
+    {
+        __m128i idx = _mm_loadu_si128((const __m128i*)(collist + k));
+        __m256d x = _mm256_sub_pd(_mm256_sub_pd(
+            _mm256_i32gather_pd(c, idx, 8), 
+            _mm256_i32gather_pd(v, idx, 8)), hv);
+        unsigned int mask = _mm256_movemask_pd(_mm256_cmp_pd(x, 
+            _mm256_i32gather_pd(d, idx, 8), _CMP_LT_OQ));
+        if (mask != 0)
+            return k + __builtin_ctz(mask);
+    }
+    return LAP_scan_generic_real(k, dim, c, v, d, collist, h);
+}
+
+/* ----- AVX-512, int costs, int dual variables ----- */
+
+__attribute__((target("avx512f")))
+static void LAP_col_min_avx512_int(int dim, int** c, int* v, int* imin)
+{
+    int i;
+    int j;
+    for (j = 0; j < dim; j++)
+    {
+        v[j] = c[0][j];
+        imin[j] = 0;
+    }
+    for (i = 1; i < dim; i++)
+    {
+        const int* row = c[i];
+        for (j = 0; j + 16 <= dim; j += 16)
+        {
+            __m512i x = _mm512_loadu_si512(row + j);
+            __mmask16 mask = _mm512_cmplt_epi32_mask(x, 
+                _mm512_loadu_si512(v + j));
+            if (mask != 0)
+            {
+                _mm512_mask_storeu_epi32(v + j, mask, x);
+                LAP_set_rows(imin + j, mask, i);
+            }
+        }
+        for ( ; j < dim; j++)
+            if (row[j] < v[j])
+            {
+                v[j] = row[j];
+                imin[j] = i;
+            }
+    }
+}
+
+__attribute__((target("avx512f")))
+static int LAP_arg_min_avx512_int(const int* c, const int* v, int lo, 
+    int hi, int init, int* idx)
+{
+    __m512i m = _mm512_set1_epi32(init);
+    __m512i mIdx = _mm512_set1_epi32(-1);
+    __m512i jIdx = _mm512_add_epi32(_mm512_set1_epi32(lo), 
+        _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 
+            15));
+    int j;
+    for (j = lo; j + 16 <= hi; j += 16)
+    {
+        __m512i h = _mm512_sub_epi32(_mm512_loadu_si512(c + j), 
+            _mm512_loadu_si512(v + j));
+        __mmask16 lt = _mm512_cmplt_epi32_mask(h, m);
+        m = _mm512_mask_blend_epi32(lt, m, h);
+        mIdx = _mm512_mask_blend_epi32(lt, mIdx, jIdx);
+        jIdx = _mm512_add_epi32(jIdx, _mm512_set1_epi32(16));
+    }
+    int lanes[16];
+    int lanesIdx[16];
+    _mm512_storeu_si512(lanes, m);
+    _mm512_storeu_si512(lanesIdx, mIdx);
+    return LAP_arg_min_tail_int(c, v, j, hi, lanes, lanesIdx, 16, init, idx);
+}
+
+LAP_SIMD_ROW_MIN(LAP_row_min_avx512_int, "avx512f", int, int, INT_MAX, 
+    LAP_arg_min_avx512_int)
+
+__attribute__((target("avx512f")))
+static int LAP_scan_avx512_int(int k0, int dim, const int* c, const int* v, 
+    const int* d, const int* collist, int h)
+{
+    __m512i hv = _mm512_set1_epi32(h);
+    int k;
+    for (k = k0; k + 16 <= dim; k += 16)
+    {
+        __m512i idx = _mm512_loadu_si512(collist + k);
+        __m512i x = _mm512_sub_epi32(_mm512_sub_epi32(
+            _mm512_i32gather_epi32(idx, c, 4), 
+            _mm512_i32gather_epi32(idx, v, 4)), hv);
+        __mmask16 mask = _mm512_cmplt_epi32_mask(x, 
+            _mm512_i32gather_epi32(idx, d, 4));
+        if (mask != 0)
+            return k + __builtin_ctz(mask);
+    }
+    return LAP_scan_generic_int(k, dim, c, v, d, collist, h);
+}
+
+/* ----- AVX-512, int costs, 64 bit dual variables ----- */
+
+__attribute__((target("avx512f")))
+static void LAP_col_min_avx512_int64(int dim, int** c, int64_t* v, 
+    int* imin)
+{
+    int i;
+    int j;
+    for (j = 0; j < dim; j++)
+    {
+        v[j] = c[0][j];
+        imin[j] = 0;
+    }
+    for (i = 1; i < dim; i++)
+    {
+        const int* row = c[i];
+        for (j = 0; j + 8 <= dim; j += 8)
+        {
+            __m512i x = _mm512_cvtepi32_epi64(
+                _mm256_loadu_si256((const __m256i*)(row + j)));
+            __mmask8 mask = _mm512_cmplt_epi64_mask(x, 
+                _mm512_loadu_si512(v + j));
+            if (mask != 0)
+            {
+                _mm512_mask_storeu_epi64(v + j, mask, x);
+                LAP_set_rows(imin + j, mask, i);
+            }
+        }
+        for ( ; j < dim; j++)
+            if (row[j] < v[j])
+            {
+                v[j] = row[j];
+                imin[j] = i;
+            }
+    }
+}
+
+__attribute__((target("avx512f")))
+static int64_t LAP_arg_min_avx512_int64(const int* c, const int64_t* v, 
+    int lo, int hi, int64_t init, int* idx)
+{
+    __m512i m = _mm512_set1_epi64(init);
+    __m512i mIdx = _mm512_set1_epi64(-1);
+    __m512i jIdx = _mm512_add_epi64(_mm512_set1_epi64(lo), 
+        _mm512_setr_epi64(0, 1, 2, 3, 4, 5, 6, 7));
+    int j;
+    for (j = lo; j + 8 <= hi; j += 8)
+    {
+        __m512i h = _mm512_sub_epi64(_mm512_cvtepi32_epi64(
+            _mm256_loadu_si256((const __m256i*)(c + j))), 
+            _mm512_loadu_si512(v + j));
+        __mmask8 lt = _mm512_cmplt_epi64_mask(h, m);
+        m = _mm512_mask_blend_epi64(lt, m, h);
+        mIdx = _mm512_mask_blend_epi64(lt, mIdx, jIdx);
+        jIdx = _mm512_add_epi64(jIdx, _mm512_set1_epi64(8));
+    }
+    int64_t lanes[8];
+    int lanesIdx[8];
+    _mm512_storeu_si512(lanes, m);
+    _mm256_storeu_si256((__m256i*)lanesIdx, _mm512_cvtepi64_epi32(mIdx));
+    return LAP_arg_min_tail_int64(c, v, j, hi, lanes, lanesIdx, 8, init, 
+        idx);
+}
+
+LAP_SIMD_ROW_MIN(LAP_row_min_avx512_int64, "avx512f", int, int64_t, 
+    INT64_MAX, LAP_arg_min_avx512_int64)
+
+__attribute__((target("avx512f")))
+static int LAP_scan_avx512_int64(int k0, int dim, const int* c, 
+    const int64_t* v, const int64_t* d, const int* collist, int64_t h)
+{
+    __m512i hv = _mm512_set1_epi64(h);
+    int k;
+    for (k = k0; k + 8 <= dim; k += 8)
+    {
+        __m256i idx = _mm256_loadu_si256((const __m256i*)(collist + k));
+        __m512i x = _mm512_sub_epi64(_mm512_sub_epi64(
+            _mm512_cvtepi32_epi64(_mm256_i32gather_epi32(c, idx, 4)), 
+            _mm512_i32gather_epi64(idx, v, 8)), hv);
+        __mmask8 mask = _mm512_cmplt_epi64_mask(x, 
+            _mm512_i32gather_epi64(idx, d, 8));
+        if (mask != 0)
+            return k + __builtin_ctz(mask);
+    }
+    return LAP_scan_generic_int64(k, dim, c, v, d, collist, h);
+}
+
+/* ----- AVX-512, real costs, real dual variables ----- */
+
+__attribute__((target("avx512f")))
+static void LAP_col_min_avx512_real(int dim, double** c, double* v, 
+    int* imin)
+{
+    int i;
+    int j;
+    for (j = 0; j < dim; j++)
+    {
+        v[j] = c[0][j];
+        imin[j] = 0;
+    }
+    for (i = 1; i < dim; i++)
+    {
+        const double* row = c[i];
+        for (j = 0; j + 8 <= dim; j += 8)
+        {
+            __m512d x = _mm512_loadu_pd(row + j);
+            __mmask8 mask = _mm512_cmp_pd_mask(x, _mm512_loadu_pd(v + j), 
+                _CMP_LT_OQ);
+            if (mask != 0)
+            {
+                _mm512_mask_storeu_pd(v + j, mask, x);
+                LAP_set_rows(imin + j, mask, i);
+            }
+        }
+        for ( ; j < dim; j++)
+            if (row[j] < v[j])
+            {
+                v[j] = row[j];
+                imin[j] = i;
+            }
+    }
+}
+
+__attribute__((target("avx512f")))
+static double LAP_arg_min_avx512_real(const double* c, const double* v, 
+    int lo, int hi, double init, int* idx)
+{
+    __m512d m = _mm512_set1_pd(init);
+    __m512d mIdx = _mm512_set1_pd(-1.);
+    __m512d jIdx = _mm512_add_pd(_mm512_set1_pd(lo), 
+        _mm512_setr_pd(0., 1., 2., 3., 4., 5., 6., 7.));
+    int j;
+    for (j = lo; j + 8 <= hi; j += 8)
+    {
+        __m512d h = _mm512_sub_pd(_mm512_loadu_pd(c + j), 
+            _mm512_loadu_pd(v + j));
+        __mmask8 lt = _mm512_cmp_pd_mask(h, m, _CMP_LT_OQ);
+        m = _mm512_mask_blend_pd(lt, m, h);
+        mIdx = _mm512_mask_blend_pd(lt, mIdx, jIdx);
+        jIdx = _mm512_add_pd(jIdx, _mm512_set1_pd(8.));
+    }
+    double lanes[8];
+    int lanesIdx[8];
+    _mm512_storeu_pd(lanes, m);
+    _mm256_storeu_si256((__m256i*)lanesIdx, _mm512_cvtpd_epi32(mIdx));
+    return LAP_arg_min_tail_real(c, v, j, hi, lanes, lanesIdx, 8, init, idx);
+}
+
+LAP_SIMD_ROW_MIN(LAP_row_min_avx512_real, "avx512f", double, double, 
+    DBL_MAX, LAP_arg_min_avx512_real)
+
+__attribute__((target("avx512f")))
+static int LAP_scan_avx512_real(int k0, int dim, const double* c, 
+    const double* v, const double* d, const int* collist, double h)
+{
+    __m512d hv = _mm512_set1_pd(h);
+    int k;
+    for (k = k0; k + 8 <= dim; k += 8)
+    {
+        __m256i idx = _mm256_loadu_si256((const __m256i*)(collist + k));
+        __m512d x = _mm512_sub_pd(_mm512_sub_pd(
+            _mm512_i32gather_pd(idx, c, 8), 
+            _mm512_i32gather_pd(idx, v, 8)), hv);
+        __mmask8 mask = _mm512_cmp_pd_mask(x, 
+            _mm512_i32gather_pd(idx, d, 8), _CMP_LT_OQ);
+        if (mask != 0)
+            return k + __builtin_ctz(mask);
+    }
+    return LAP_scan_generic_real(k, dim, c, v, d, collist, h);
+}
+
+#endif
+
+/** Instruction set level (implementation).
+ */
+enum LAPSimdLevel_Impl
+{
+    /** Instruction set level: no vector instructions.
+     */
+    LAP_SIMD_LEVEL_NONE = 0,
+    /** Instruction set level: AVX2.
+     */
+    LAP_SIMD_LEVEL_AVX2 = 1,
+    /** Instruction set level: AVX-512 foundation.
+     */
+    LAP_SIMD_LEVEL_AVX512 = 2
+};
+
+/** Instruction set level.
+ */
+typedef enum LAPSimdLevel_Impl LAPSimdLevel;
+
+/** Detect instruction set level.
+ *
+ * Detect the most capable instruction set level supported by the 
+ * processor.
+ */
+static LAPSimdLevel LAP_detect_simd_level()
+{
+#ifdef LAP_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+        return LAP_SIMD_LEVEL_AVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return LAP_SIMD_LEVEL_AVX2;
+#endif
+    return LAP_SIMD_LEVEL_NONE;
+}
+
+/** Get instruction set level.
+ *
+ * Get the most capable instruction set level supported by the processor 
+ * (see LAP_detect_simd_level()). The level is detected by the first call 
+ * and kept for the following calls, since the kernels are looked up for 
+ * each linear assignment problem.
+ */
+static LAPSimdLevel LAP_get_simd_level()
+{
+    /* -1 if the level has not been detected yet. Threads which detect it 
+       at the same time store the same value. */
+    static volatile int level = -1;
+    if (level < 0)
+        level = LAP_detect_simd_level();
+    return (LAPSimdLevel)level;
+}
+
+const LAPKernelsInt* LAP_get_kernels_int()
+{
+    static const LAPKernelsInt generic = { LAP_col_min_generic_int, 
+        LAP_row_min_generic_int, LAP_scan_generic_int };
+#ifdef LAP_SIMD_X86
+    static const LAPKernelsInt avx2 = { LAP_col_min_avx2_int, 
+        LAP_row_min_avx2_int, LAP_scan_avx2_int };
+    static const LAPKernelsInt avx512 = { LAP_col_min_avx512_int, 
+        LAP_row_min_avx512_int, LAP_scan_avx512_int };
+    LAPSimdLevel level = LAP_get_simd_level();
+    if (level == LAP_SIMD_LEVEL_AVX512)
+        return &avx512;
+    if (level == LAP_SIMD_LEVEL_AVX2)
+        return &avx2;
+#endif
+    return &generic;
+}
+
+const LAPKernelsInt64* LAP_get_kernels_int64()
+{
+    static const LAPKernelsInt64 generic = { LAP_col_min_generic_int64, 
+        LAP_row_min_generic_int64, LAP_scan_generic_int64 };
+#ifdef LAP_SIMD_X86
+    /* Three gathers of four columns each are slower than the scalar scan. */
+    static const LAPKernelsInt64 avx2 = { LAP_col_min_avx2_int64, 
+        LAP_row_min_avx2_int64, LAP_scan_generic_int64 };
+    static const LAPKernelsInt64 avx512 = { LAP_col_min_avx512_int64, 
+        LAP_row_min_avx512_int64, LAP_scan_avx512_int64 };
+    LAPSimdLevel level = LAP_get_simd_level();
+    if (level == LAP_SIMD_LEVEL_AVX512)
+        return &avx512;
+    if (level == LAP_SIMD_LEVEL_AVX2)
+        return &avx2;
+#endif
+    return &generic;
+}
+
+const LAPKernelsReal* LAP_get_kernels_real()
+{
+    static const LAPKernelsReal generic = { LAP_col_min_generic_real, 
+        LAP_row_min_generic_real, LAP_scan_generic_real };
+#ifdef LAP_SIMD_X86
+    static const LAPKernelsReal avx2 = { LAP_col_min_avx2_real, 
+        LAP_row_min_avx2_real, LAP_scan_avx2_real };
+    static const LAPKernelsReal avx512 = { LAP_col_min_avx512_real, 
+        LAP_row_min_avx512_real, LAP_scan_avx512_real };
+    LAPSimdLevel level = LAP_get_simd_level();
+    if (level == LAP_SIMD_LEVEL_AVX512)
+        return &avx512;
+    if (level == LAP_SIMD_LEVEL_AVX2)
+        return &avx2;
+#endif
+    return &generic;
+}
@@ -0,0 +1,165 @@
+#ifndef LAP_SIMD
+#define LAP_SIMD
+/* ----------------------------------------------------------------------------
+ * R package for graph alignment
+ * ----------------------------------------------------------------------------
+ *
+ * Author: Joern P. Meier <mail@ionflux.org>
+ * 
+ * The package can be used freely for non-commercial purposes. If you use this 
+ * package, the appropriate paper to cite is J. Berg and M. Laessig, 
+ * "Cross-species analysis of biological networks by Bayesian alignment", 
+ * PNAS 103 (29), 10967-10972 (2006)
+ * 
+ * This software is made available in the hope that it will be useful, but 
+ * WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY 
+ * or FITNESS FOR A PARTICULAR PURPOSE.
+ * 
+ * This software contains code for solving linear assignment problems which was 
+ * written by Roy Jonker, MagicLogic Optimization Inc.. Please note that this 
+ * code is copyrighted, (c) 2003 MagicLogic Systems Inc., Canada and may be 
+ * used for non-commercial purposes only. See 
+ * http://www.magiclogic.com/assignment.html for the latest version of the LAP 
+ * code and details on licensing.
+ *
+ * ----------------------------------------------------------------------------
+ * Vectorized scans for the linear assignment problem solver.
+ * ----------------------------------------------------------------------------
+ */
+
+/** \file lap_simd.h
+ * \brief Vectorized scans for the linear assignment problem solver.
+ *
+ * This module provides the scans over the cost matrix which dominate the 
+ * running time of the linear assignment problem solver (see lap_impl.h): 
+ * the column minima of the column reduction, the minimum and second 
+ * minimum reduced cost of a row in the augmenting row reduction, and the 
+ * search for shorter paths in the augmentation. For each combination of 
+ * cost and dual variable types, there is a set of kernels for AVX-512, 
+ * AVX2 and processors without either, which is selected at run-time. All 
+ * kernels return exactly the same results as the scalar loops of the 
+ * original solver, including the choice among equal values.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/** Kernels for the linear assignment problem solver (int costs, int dual 
+ * variables).
+ */
+struct LAPKernelsInt_Impl
+{
+    /** Column minima.
+     *
+     * Set \c v[j] to the minimum of column \c j of the cost matrix \c c, 
+     * and \c imin[j] to the first row in which it occurs.
+     */
+    void (*colMin)(int dim, int** c, int* v, int* imin);
+    /** Row minima.
+     *
+     * Find the minimum \c umin of the reduced costs <tt>c[j] - v[j]</tt> 
+     * of a row, the first column \c j1 in which it occurs, the minimum 
+     * \c usubmin over all other columns and the first column \c j2 other 
+     * than \c j1 in which it occurs. If no reduced cost of the other 
+     * columns is smaller than the largest value of the dual type, 
+     * \c usubmin is set to that value and \c j2 is not changed.
+     */
+    void (*rowMin)(int dim, const int* c, const int* v, int* umin, 
+        int* usubmin, int* j1, int* j2);
+    /** Path scan.
+     *
+     * Find the first position \c k, starting at \c k0, for which the 
+     * column <tt>j = collist[k]</tt> satisfies 
+     * <tt>c[j] - v[j] - h < d[j]</tt>, or return \c dim if there is none.
+     */
+    int (*scan)(int k0, int dim, const int* c, const int* v, const int* d, 
+        const int* collist, int h);
+};
+
+/** Kernels for the linear assignment problem solver (int costs, int dual 
+ * variables).
+ */
+typedef struct LAPKernelsInt_Impl LAPKernelsInt;
+
+/** Kernels for the linear assignment problem solver (int costs, 64 bit 
+ * dual variables).
+ *
+ * See LAPKernelsInt for a description of the kernels.
+ */
+struct LAPKernelsInt64_Impl
+{
+    /** Column minima.
+     */
+    void (*colMin)(int dim, int** c, int64_t* v, int* imin);
+    /** Row minima.
+     */
+    void (*rowMin)(int dim, const int* c, const int64_t* v, int64_t* umin, 
+        int64_t* usubmin, int* j1, int* j2);
+    /** Path scan.
+     */
+    int (*scan)(int k0, int dim, const int* c, const int64_t* v, 
+        const int64_t* d, const int* collist, int64_t h);
+};
+
+/** Kernels for the linear assignment problem solver (int costs, 64 bit 
+ * dual variables).
+ */
+typedef struct LAPKernelsInt64_Impl LAPKernelsInt64;
+
+/** Kernels for the linear assignment problem solver (real costs, real 
+ * dual variables).
+ *
+ * See LAPKernelsInt for a description of the kernels.
+ */
+struct LAPKernelsReal_Impl
+{
+    /** Column minima.
+     */
+    void (*colMin)(int dim, double** c, double* v, int* imin);
+    /** Row minima.
+     */
+    void (*rowMin)(int dim, const double* c, const double* v, double* umin, 
+        double* usubmin, int* j1, int* j2);
+    /** Path scan.
+     */
+    int (*scan)(int k0, int dim, const double* c, const double* v, 
+        const double* d, const int* collist, double h);
+};
+
+/** Kernels for the linear assignment problem solver (real costs, real 
+ * dual variables).
+ */
+typedef struct LAPKernelsReal_Impl LAPKernelsReal;
+
+/** Get kernels (int costs, int dual variables).
+ *
+ * Get the fastest kernels supported by the processor.
+ *
+ * \return kernels
+ */
+const LAPKernelsInt* LAP_get_kernels_int();
+
+/** Get kernels (int costs, 64 bit dual variables).
+ *
+ * Get the fastest kernels supported by the processor.
+ *
+ * \return kernels
+ */
+const LAPKernelsInt64* LAP_get_kernels_int64();
+
+/** Get kernels (real costs, real dual variables).
+ *
+ * Get the fastest kernels supported by the processor.
+ *
+ * \return kernels
+ */
+const LAPKernelsReal* LAP_get_kernels_real();
+
+#ifdef __cplusplus
+}
+#endif
+#endif